@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "chord.common.h"
+#include "chord.context.h"
+#include "chord.pb.h"
+#include "chord.uuid.h"
+
+using namespace chord;
+using chord::common::id_of;
+using chord::common::make_request;
+using chord::common::set_id;
+using chord::common::uuid_of;
+
+namespace {
+
+enum wire { STRINGS, UPGRADE, BINARY };
+
+/**
+ * one successor hop: encode the request, decode it on the next node
+ * and parse the ids (source and id to find).
+ *
+ *  - strings: decimal string fields only (former wire format)
+ *  - upgrade: binary and decimal fields (legacy-uuids: Yes)
+ *  - binary: binary fields only (legacy-uuids: No)
+ */
+void BM_successor_hop(benchmark::State& state) {
+  const auto format = static_cast<wire>(state.range(0));
+  Context context;
+  context.legacy_uuids = format == UPGRADE;
+  const auto id = uuid::random();
+
+  std::string wire;
+  for(auto _ : state) {
+    SuccessorRequest req;
+    if(format == STRINGS) {
+      auto* src = req.mutable_header()->mutable_src();
+      src->set_uuid(context.uuid());
+      src->set_endpoint(context.advertise_addr);
+      req.set_id(id);
+    } else {
+      req = make_request<SuccessorRequest>(context);
+      set_id(req, id, context.legacy_uuids);
+    }
+    req.SerializeToString(&wire);
+
+    SuccessorRequest received;
+    received.ParseFromString(wire);
+    benchmark::DoNotOptimize(uuid_of(received.header().src()));
+    benchmark::DoNotOptimize(id_of(received));
+  }
+  state.counters["bytes"] = static_cast<double>(wire.size());
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_successor_hop)->ArgName("wire")->Arg(STRINGS)->Arg(UPGRADE)->Arg(BINARY);
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "chord.channel.pool.h"
+#include "chord.context.h"
+#include "chord.facade.h"
+#include "chord.file.h"
+#include "chord.fs.callback.service.h"
+#include "chord.fs.client.h"
+#include "chord.fs.metadata.manager.h"
+#include "chord.fs.service.h"
+#include "chord.uri.h"
+#include "chord.utils.h"
+
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+enum api { SYNC, ASYNC };
+
+Context make_context(const api mode) {
+  Context context;
+  context.bootstrap = true;
+  context.bind_addr = "127.0.0.1:50091";
+  context.advertise_addr = context.bind_addr;
+  context.data_directory = chord::path{"./benchmark-data-async"};
+  context.meta_directory = chord::path{"./benchmark-meta"} / "async";
+  context.fs_async_server = mode == ASYNC;
+  for(const auto& dir : {context.data_directory, context.meta_directory}) {
+    if(file::exists(dir)) file::remove_all(dir);
+  }
+  file::create_directories(context.data_directory);
+  return context;
+}
+
+/**
+ * single node ring serving fs requests by either the synchronous or
+ * the callback service - requests are always sent through the loopback
+ */
+struct Node {
+  Context context;
+  ChannelPool channel_pool{context};
+  ChordFacade chord{context, &channel_pool};
+  MetadataManager metadata_mgr{context};
+  Client client{context, &chord, &metadata_mgr, &channel_pool};
+  Service service{context, &chord, &metadata_mgr, &client};
+  std::unique_ptr<CallbackService> callback_service;
+  std::unique_ptr<grpc::Server> server;
+
+  explicit Node(const api mode) : context{make_context(mode)} {
+    chord.create();
+    if(context.fs_async_server) callback_service = std::make_unique<CallbackService>(context, &service);
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(context.bind_addr, grpc::InsecureServerCredentials());
+    builder.RegisterService(chord.grpc_service());
+    if(callback_service) {
+      builder.RegisterService(callback_service.get());
+    } else {
+      builder.RegisterService(&service);
+    }
+    server = builder.BuildAndStart();
+  }
+
+  ~Node() {
+    if(server) server->Shutdown();
+  }
+};
+
+/**
+ * concurrent put streams - every iteration starts state.range(1)
+ * streams of 64k each and waits for all of them to complete
+ */
+void BM_concurrent_put(benchmark::State& state) {
+  Node node{static_cast<api>(state.range(0))};
+  const auto streams = static_cast<std::size_t>(state.range(1));
+  const std::string content(64*1024, 'x');
+  std::atomic<std::int64_t> i{0};
+  std::atomic<std::int64_t> failed{0};
+
+  for(auto _ : state) {
+    std::vector<std::thread> clients;
+    clients.reserve(streams);
+    for(std::size_t s = 0; s < streams; ++s) {
+      clients.emplace_back([&] {
+        const auto uri = chord::utils::as_uri("/folder/file_" + std::to_string(i++));
+        std::istringstream data{content};
+        if(!node.client.put(uri, data).ok()) ++failed;
+      });
+    }
+    for(auto& client : clients) client.join();
+  }
+
+  if(failed > 0) state.SkipWithError("failed to put files");
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  state.SetBytesProcessed(state.iterations() * state.range(1) * static_cast<std::int64_t>(content.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_concurrent_put)
+  ->ArgNames({"async", "streams"})
+  ->ArgsProduct({{SYNC, ASYNC}, {100, 400}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chord.context.h"
+#include "chord.file.h"
+#include "chord.fs.chunk.store.h"
+#include "chord.fs.chunker.h"
+#include "chord.fs.metadata.manager.h"
+#include "chord.uri.h"
+#include "chord.utils.h"
+
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+constexpr std::size_t FILE_SIZE = static_cast<std::size_t>(8)*1024*1024;
+constexpr std::int64_t VERSIONS = 8;
+// edits (insert, overwrite or delete of up to 4k) per version
+constexpr int EDITS = 16;
+
+/**
+ * synthetic versioned dataset: a random file, each version derived from
+ * the previous one by a few small edits at random positions.
+ */
+std::vector<std::string> make_versions() {
+  std::mt19937_64 engine{4711};
+  std::uniform_int_distribution<int> byte{0, 255};
+  const auto random = [&](const std::size_t len) {
+    std::string data(len, '\0');
+    for(auto& c : data) c = static_cast<char>(byte(engine));
+    return data;
+  };
+
+  std::vector<std::string> versions{random(FILE_SIZE)};
+  for(std::int64_t v = 1; v < VERSIONS; ++v) {
+    auto data = versions.back();
+    for(int e = 0; e < EDITS; ++e) {
+      const auto pos = std::uniform_int_distribution<std::size_t>{0, data.size() - 4096}(engine);
+      const auto len = std::uniform_int_distribution<std::size_t>{1, 4096}(engine);
+      switch(e % 3) {
+        case 0: data.insert(pos, random(len)); break;
+        case 1: data.replace(pos, len, random(len)); break;
+        default: data.erase(pos, len); break;
+      }
+    }
+    versions.push_back(std::move(data));
+  }
+  return versions;
+}
+
+/**
+ * ingest all versions of the file (as separate files) into the chunk
+ * store, the average chunk size (k) is the argument.
+ *
+ *  - dedup: bytes ingested / bytes stored
+ */
+void BM_chunk_store_ingest(benchmark::State& state) {
+  const auto avg_size = static_cast<std::size_t>(state.range(0))*1024;
+  const Chunker chunker{avg_size/4, avg_size, avg_size*4};
+  static const auto versions = make_versions();
+
+  Context context;
+  context.meta_directory = chord::path{"./benchmark-chunks"};
+
+  std::size_t ingested = 0;
+  std::unordered_map<std::string, std::size_t> stored;
+  for(auto _ : state) {
+    state.PauseTiming();
+    if(file::exists(context.meta_directory)) file::remove_all(context.meta_directory);
+    stored.clear();
+    {
+      MetadataManager metadata{context};
+      ChunkStore store{context, &metadata, chunker};
+      state.ResumeTiming();
+
+      for(std::size_t v = 0; v < versions.size(); ++v) {
+        std::istringstream stream{versions[v]};
+        const auto recipe = store.add(utils::as_uri("/file.v" + std::to_string(v)), stream);
+        for(const auto& chunk : recipe.chunks) stored[chunk.hash.string()] = chunk.size;
+        ingested += versions[v].size();
+      }
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+
+  std::size_t stored_bytes = 0;
+  for(const auto& [hash, size] : stored) stored_bytes += size;
+  std::size_t logical_bytes = 0;
+  for(const auto& version : versions) logical_bytes += version.size();
+
+  state.counters["dedup"] = static_cast<double>(logical_bytes) / static_cast<double>(stored_bytes);
+  state.counters["chunks"] = static_cast<double>(stored.size());
+  state.SetBytesProcessed(static_cast<std::int64_t>(ingested));
+
+  file::remove_all(context.meta_directory);
+}
+
+}  // namespace
+
+BENCHMARK(BM_chunk_store_ingest)->ArgName("avg_k")->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
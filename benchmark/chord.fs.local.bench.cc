@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "chord.channel.pool.h"
+#include "chord.context.h"
+#include "chord.facade.h"
+#include "chord.file.h"
+#include "chord.fs.client.h"
+#include "chord.fs.metadata.h"
+#include "chord.fs.metadata.manager.h"
+#include "chord.fs.service.h"
+#include "chord.uri.h"
+#include "chord.utils.h"
+
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+enum dispatch { LOOPBACK, LOCAL };
+
+Context make_context() {
+  Context context;
+  context.bootstrap = true;
+  context.bind_addr = "127.0.0.1:50090";
+  context.advertise_addr = context.bind_addr;
+  context.data_directory = chord::path{"./benchmark-data"};
+  context.meta_directory = chord::path{"./benchmark-meta"} / "local";
+  for(const auto& dir : {context.data_directory, context.meta_directory}) {
+    if(file::exists(dir)) file::remove_all(dir);
+  }
+  file::create_directories(context.data_directory);
+  return context;
+}
+
+/**
+ * single node ring serving chord and fs requests
+ */
+struct Node {
+  Context context{make_context()};
+  ChannelPool channel_pool{context};
+  ChordFacade chord{context, &channel_pool};
+  MetadataManager metadata_mgr{context};
+  Client client{context, &chord, &metadata_mgr, &channel_pool};
+  Service service{context, &chord, &metadata_mgr, &client};
+  std::unique_ptr<grpc::Server> server;
+
+  explicit Node(const dispatch mode) {
+    chord.create();
+    if(mode == LOCAL) client.set_local_service(&service);
+
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort(context.bind_addr, grpc::InsecureServerCredentials());
+    builder.RegisterService(chord.grpc_service());
+    builder.RegisterService(&service);
+    server = builder.BuildAndStart();
+  }
+
+  ~Node() {
+    if(server) server->Shutdown();
+  }
+};
+
+/**
+ * add the metadata of a (new) file, including the update of the parent
+ */
+void BM_meta_add(benchmark::State& state) {
+  Node node{static_cast<dispatch>(state.range(0))};
+  std::int64_t i = 0;
+  for(auto _ : state) {
+    const auto uri = chord::utils::as_uri("/folder/file_" + std::to_string(i++));
+    std::set<Metadata> metadata{{uri.path().filename().string(), "usr", "grp", perms::all, type::regular, 42}};
+    const auto status = node.client.meta(uri, Client::Action::ADD, metadata);
+    if(!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * put a small file - the data is always streamed, the metadata of
+ * the parent is updated in-process if dispatched locally
+ */
+void BM_put(benchmark::State& state) {
+  Node node{static_cast<dispatch>(state.range(0))};
+  const std::string content(4096, 'x');
+  std::int64_t i = 0;
+  for(auto _ : state) {
+    const auto uri = chord::utils::as_uri("/folder/file_" + std::to_string(i++));
+    std::istringstream data{content};
+    const auto status = node.client.put(uri, data);
+    if(!status.ok()) {
+      state.SkipWithError(status.error_message().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_meta_add)->ArgName("local")->Arg(LOOPBACK)->Arg(LOCAL)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_put)->ArgName("local")->Arg(LOOPBACK)->Arg(LOCAL)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+
+#include "chord.crypto.h"
+#include "chord.fs.metadata.codec.h"
+#include "chord.fs.metadata.h"
+#include "chord.node.h"
+
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+std::map<std::string, Metadata> make_directory(const std::int64_t entries) {
+  std::map<std::string, Metadata> ret;
+  ret.emplace(".", Metadata{".", "usr", "grp", perms::all, type::directory, 0, {}, {}, Replication(0, 3)});
+  for(std::int64_t i = 0; i < entries; ++i) {
+    const auto name = "file_" + std::to_string(i);
+    const node ref{crypto::sha256(name), "127.0.0.1:50050"};
+    ret.emplace(name, Metadata{name, "usr", "grp", perms::owner_all, type::regular,
+        static_cast<std::size_t>(i) * 4096, crypto::sha256(name + ".hash"), ref, Replication(0, 3)});
+  }
+  return ret;
+}
+
+std::string text_encode(const std::map<std::string, Metadata>& metadata) {
+  std::stringstream ss;
+  boost::archive::text_oarchive oa{ss};
+  oa << metadata;
+  return ss.str();
+}
+
+void BM_text_encode(benchmark::State& state) {
+  const auto directory = make_directory(state.range(0));
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(text_encode(directory));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_text_decode(benchmark::State& state) {
+  const auto encoded = text_encode(make_directory(state.range(0)));
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(MetadataCodec::decode_legacy(encoded));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] = encoded.size();
+}
+
+void BM_binary_encode(benchmark::State& state) {
+  const auto directory = make_directory(state.range(0));
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(MetadataCodec::encode(directory));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_binary_decode(benchmark::State& state) {
+  const auto encoded = MetadataCodec::encode(make_directory(state.range(0)));
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(MetadataCodec::decode(encoded));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] = encoded.size();
+}
+
+}  // namespace
+
+BENCHMARK(BM_text_encode)->Arg(10)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_text_decode)->Arg(10)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_binary_encode)->Arg(10)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_binary_decode)->Arg(10)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
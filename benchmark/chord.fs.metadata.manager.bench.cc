@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "chord.context.h"
+#include "chord.file.h"
+#include "chord.fs.metadata.h"
+#include "chord.fs.metadata.manager.h"
+#include "chord.uri.h"
+#include "chord.utils.h"
+
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+constexpr std::int64_t DIRECTORIES = 10000;
+
+struct Profile {
+  const char* name;
+  std::size_t block_cache_mb;
+  std::size_t bloom_bits_per_key;
+  const char* compression;
+};
+
+const std::vector<Profile> profiles {
+  {"default", 0, 0, "none"},
+  {"cache", 32, 0, "none"},
+  {"cache+bloom", 32, 10, "none"},
+  {"cache+bloom+lz4", 32, 10, "lz4"}
+};
+
+Context make_context(const Profile& profile) {
+  Context context;
+  context.meta_directory = chord::path{"./benchmark-meta"} / profile.name;
+  context.meta_block_cache_mb = profile.block_cache_mb;
+  context.meta_bloom_bits_per_key = profile.bloom_bits_per_key;
+  context.meta_compression = profile.compression;
+  if(file::exists(context.meta_directory)) file::remove_all(context.meta_directory);
+  return context;
+}
+
+chord::uri directory(const std::int64_t i) {
+  return chord::utils::as_uri("/folder_" + std::to_string(i));
+}
+
+void populate(MetadataManager& metadata) {
+  MetadataBatch batch;
+  for(std::int64_t i = 0; i < DIRECTORIES; ++i) {
+    batch.add(directory(i), {create_directory(), {"file", "usr", "grp", perms::all, type::regular, 42}});
+  }
+  metadata.apply(batch);
+}
+
+template<typename Lookup>
+void run(benchmark::State& state, Lookup&& lookup) {
+  const auto& profile = profiles.at(static_cast<std::size_t>(state.range(0)));
+  state.SetLabel(profile.name);
+  auto context = make_context(profile);
+  {
+    MetadataManager metadata{context};
+    populate(metadata);
+
+    std::int64_t i = 0;
+    for(auto _ : state) {
+      lookup(metadata, i++ % DIRECTORIES);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  file::remove_all(context.meta_directory);
+}
+
+void BM_exists(benchmark::State& state) {
+  run(state, [](auto& metadata, const auto i) {
+    benchmark::DoNotOptimize(metadata.exists(directory(i)));
+  });
+}
+
+void BM_exists_missing(benchmark::State& state) {
+  run(state, [](auto& metadata, const auto i) {
+    benchmark::DoNotOptimize(metadata.exists(directory(DIRECTORIES + i)));
+  });
+}
+
+void BM_get(benchmark::State& state) {
+  run(state, [](auto& metadata, const auto i) {
+    benchmark::DoNotOptimize(metadata.get(directory(i)));
+  });
+}
+
+}  // namespace
+
+BENCHMARK(BM_exists)->DenseRange(0, 3);
+BENCHMARK(BM_exists_missing)->DenseRange(0, 3);
+BENCHMARK(BM_get)->DenseRange(0, 3);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "chord.concurrent.lru.cache.h"
+#include "chord.lru.cache.h"
+#include "chord.uuid.h"
+
+using namespace chord;
+
+namespace {
+
+// channel pool sized (c.f. Router::BITS)
+constexpr std::size_t CAPACITY = 256;
+// more keys than entries to also exercise evictions
+constexpr std::size_t KEYS = 320;
+
+using value_t = std::shared_ptr<int>;
+
+template<typename Cache>
+void run(benchmark::State& state, Cache& cache) {
+  std::mt19937_64 generator(state.thread_index());
+  std::uniform_int_distribution<std::size_t> distribution(0, KEYS - 1);
+
+  for(auto _ : state) {
+    const uuid_t key{distribution(generator)};
+    benchmark::DoNotOptimize(cache.compute_if_absent(key, [](const uuid_t&) { return std::make_shared<int>(0); }));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_lru_cache(benchmark::State& state) {
+  static LRUCache<uuid_t, value_t> cache{CAPACITY};
+  run(state, cache);
+}
+
+void BM_concurrent_lru_cache(benchmark::State& state) {
+  static ConcurrentLRUCache<uuid_t, value_t> cache{CAPACITY};
+  run(state, cache);
+}
+
+}  // namespace
+
+BENCHMARK(BM_lru_cache)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_concurrent_lru_cache)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "chord.router.h"
+#include "chord.uuid.h"
+
+using namespace chord;
+
+namespace {
+
+constexpr std::size_t IDS = 1024;
+
+std::vector<uuid> random_ids() {
+  std::vector<uuid> ids;
+  ids.reserve(IDS);
+  for(std::size_t i = 0; i < IDS; ++i) ids.push_back(uuid::random());
+  return ids;
+}
+
+void BM_between(benchmark::State& state) {
+  const auto ids = random_ids();
+  std::size_t i = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(uuid::between(ids[i % IDS], ids[(i + 1) % IDS], ids[(i + 2) % IDS]));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * baseline: the former boost::multiprecision based representation
+ */
+void BM_between_boost(benchmark::State& state) {
+  std::vector<uuid::value_t> ids;
+  for(const auto& id : random_ids()) ids.push_back(id.value());
+  const auto between = [](const auto& from, const auto& element, const auto& to) {
+    if(from < to) return from < element && element < to;
+    return from < element || element < to;
+  };
+  std::size_t i = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(between(ids[i % IDS], ids[(i + 1) % IDS], ids[(i + 2) % IDS]));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_finger_table(benchmark::State& state) {
+  const auto self = uuid::random();
+  std::array<uuid, Router::BITS> fingers;
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < Router::BITS; ++i) {
+      fingers[i] = Router::calc_successor_uuid_for_index(self, i);
+    }
+    benchmark::DoNotOptimize(fingers.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Router::BITS);
+}
+
+/**
+ * baseline: (self + 2^i) % (2^256-1) using boost::multiprecision
+ */
+void BM_finger_table_boost(benchmark::State& state) {
+  namespace mp = boost::multiprecision;
+  const auto self = uuid::random().value();
+  const auto mod = std::numeric_limits<uuid::value_t>::max();
+  std::array<uuid::value_t, Router::BITS> fingers;
+  for(auto _ : state) {
+    for(std::size_t i = 0; i < Router::BITS; ++i) {
+      fingers[i] = (self + mp::pow(uuid::value_t{2}, static_cast<unsigned>(i))) % mod;
+    }
+    benchmark::DoNotOptimize(fingers.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Router::BITS);
+}
+
+void BM_to_string(benchmark::State& state) {
+  const auto ids = random_ids();
+  std::size_t i = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(ids[i++ % IDS].string());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_to_string_boost(benchmark::State& state) {
+  std::vector<uuid::value_t> ids;
+  for(const auto& id : random_ids()) ids.push_back(id.value());
+  std::size_t i = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(ids[i++ % IDS].str());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_between);
+BENCHMARK(BM_between_boost);
+BENCHMARK(BM_finger_table);
+BENCHMARK(BM_finger_table_boost);
+BENCHMARK(BM_to_string);
+BENCHMARK(BM_to_string_boost);
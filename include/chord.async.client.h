@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/codegen/status.h>
+
+#include "chord.grpc.pb.h"
+#include "chord.i.client.h"
+#include "chord.node.h"
+#include "chord.uuid.h"
+
+namespace chord { struct Context; }
+namespace chord { struct Router; }
+namespace chord { class ChannelPool; }
+namespace spdlog { class logger; }
+
+namespace chord {
+
+/**
+ * ring maintenance (stabilize, check, fix fingers) on the callback api.
+ *
+ * probes are sent without blocking the calling thread; their results are
+ * applied to the router by the thread completing the request. every probe
+ * is bounded by the rpc's timeout and never outlives its period, and a
+ * probe is skipped while the previous one to the same peer (or for the
+ * same finger) is still pending - a slow peer delays nothing but itself.
+ */
+class AsyncClient {
+  static constexpr auto logger_name = "chord.async.client";
+
+  using async_interface = Chord::StubInterface::async_interface;
+
+  template<typename Request, typename Response>
+  using method_t = void (async_interface::*)(grpc::ClientContext*, const Request*, Response*, std::function<void(grpc::Status)>);
+
+  template<typename Request, typename Response>
+  struct Call {
+    grpc::ClientContext client_context;
+    Request req;
+    Response res;
+    std::unique_ptr<Chord::StubInterface> stub;
+  };
+
+  const Context& context;
+  Router* router;
+  StubFactory make_stub;
+
+  std::mutex mtx;
+  std::condition_variable idle;
+  // rpc and peer (or finger) of the pending probes
+  std::set<std::pair<std::string, uuid>> in_flight;
+
+  std::shared_ptr<spdlog::logger> logger;
+
+  /**
+   * send the request to the peer and run done once it completed.
+   *
+   * @return false if a probe with the same key is still pending
+   */
+  template<typename Request, typename Response>
+  bool call(method_t<Request, Response> method, const std::string& rpc, const node& peer, const uuid& key,
+            Request req, std::chrono::milliseconds period,
+            std::function<void(const grpc::Status&, const Response&)> done);
+
+  void complete(const std::string& rpc, const uuid& key);
+
+  /**
+   * update the finger at id with the successor of id
+   */
+  void apply_finger(const uuid& id, const node& successor);
+
+ public:
+  AsyncClient(const Context& context, Router* router, ChannelPool*);
+
+  AsyncClient(const Context& context, Router* router, StubFactory make_stub);
+
+  AsyncClient(const AsyncClient&) = delete;
+  AsyncClient& operator=(const AsyncClient&) = delete;
+
+  /**
+   * waits for the pending probes
+   */
+  ~AsyncClient();
+
+  void stabilize();
+
+  void notify();
+
+  void check();
+
+  /**
+   * fix the fingers of the given indices concurrently and call done once
+   * every probe completed (if any)
+   */
+  void fix_fingers(const std::vector<std::size_t>& indices, std::function<void()> done = {});
+
+  /**
+   * block until no probe is pending
+   */
+  void wait();
+};
+
+}  // namespace chord
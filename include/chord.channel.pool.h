@@ -1,17 +1,17 @@
 #pragma once
 #include <cstddef>
 #include <memory>
-#include <mutex>
 #include <grpcpp/channel.h>
 #include <grpcpp/completion_queue.h>
 
 #include "chord.node.h"
 #include "chord.router.h"
 #include "chord.types.h"
-#include "chord.lru.cache.h"
+#include "chord.concurrent.lru.cache.h"
 #include "chord.uuid.h"
 
 namespace chord { struct Context; }
+namespace grpc { class ServerBuilder; }
 
 namespace spdlog {
   class logger;
@@ -19,12 +19,22 @@ namespace spdlog {
 
 namespace chord {
 
+/**
+ * channels to the peers, created once and shared by all clients.
+ *
+ * every peer is reached on two lanes with separate connections: bulk
+ * data (file transfers) and control rpcs (lookups, metadata, ...) - a
+ * large upload does not block the small requests to the same peer.
+ * idle connections are probed by keepalive pings, shut down channels
+ * are replaced on the next lookup.
+ */
 class ChannelPool {
 public:
-  using mutex_t = std::recursive_mutex;
+  enum class lane { CONTROL, BULK };
 
 protected:
-  chord::LRUCache<uuid_t, std::shared_ptr<grpc::Channel>> channels{Router::BITS};
+  chord::ConcurrentLRUCache<uuid_t, std::shared_ptr<grpc::Channel>> channels{Router::BITS};
+  chord::ConcurrentLRUCache<uuid_t, std::shared_ptr<grpc::Channel>> bulk_channels{Router::BITS};
 
 private:
   static constexpr auto logger_name = "chord.channel.pool";
@@ -32,19 +42,26 @@ private:
   chord::Context &context;
   std::shared_ptr<spdlog::logger> logger;
 
-  mutable mutex_t mtx;
-
 public:
   explicit ChannelPool(chord::Context &context);
   explicit ChannelPool(const chord::ChannelPool&) = delete;
   virtual ~ChannelPool() = default;
   ChannelPool& operator=(const ChannelPool&) = delete;
 
+  /**
+   * use the channel for the node - on both lanes
+   */
   void put(const node& node, std::shared_ptr<grpc::Channel> channel);
   //std::shared_ptr<grpc::Channel> get(const endpoint&);
-  std::shared_ptr<grpc::Channel> get(const node&);
+  std::shared_ptr<grpc::Channel> get(const node&, const lane = lane::CONTROL);
 
   static std::shared_ptr<grpc::Channel> create_channel(const endpoint&);
+  static std::shared_ptr<grpc::Channel> create_channel(const endpoint&, const int keepalive_ms);
+
+  /**
+   * let the server accept the keepalive pings of the pooled channels
+   */
+  static void configure(grpc::ServerBuilder&, const int keepalive_ms);
 };
 
 }  // namespace chord
@@ -2,7 +2,9 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <grpcpp/client_context.h>
+#include <grpcpp/server_context.h>
 
 #include "chord_common.pb.h"
 #include "chord.signal.h"
@@ -35,16 +37,29 @@ class Client : public IClient {
 
   StubFactory make_stub;
 
-  signal<const node> event_predecessor_fail;
-  signal<const node> event_successor_fail;
-
   std::shared_ptr<spdlog::logger> logger;
 
   grpc::Status inform_predecessor_about_leave();
   grpc::Status inform_successor_about_leave();
   grpc::Status inform_about_leave(const node& node);
 
-  void init_context(grpc::ClientContext&);
+  void init_context(grpc::ClientContext&, const std::string& rpc);
+
+  /**
+   * context of a request forwarded on behalf of the parent request (if any):
+   * bounded by the deadline of the parent and cancelled along with it.
+   */
+  std::unique_ptr<grpc::ClientContext> forward_context(const grpc::ServerContext* parent, const std::string& rpc);
+
+  /**
+   * OK unless the parent request has been cancelled or exceeded its deadline
+   */
+  grpc::Status check_budget(const grpc::ServerContext* parent) const;
+
+  /**
+   * feed the failure detector with the outcome of a request
+   */
+  grpc::Status record(const node&, const grpc::Status&);
 
  public:
   Client(const Context &context, Router *router, ChannelPool*);
@@ -58,7 +73,7 @@ class Client : public IClient {
 
   grpc::Status join(const endpoint& addr) override;
   grpc::Status join(const JoinRequest *req, JoinResponse *res) override;
-  grpc::Status join(grpc::ClientContext *clientContext, const JoinRequest *req, JoinResponse *res) override;
+  grpc::Status join(const grpc::ServerContext *parent, const JoinRequest *req, JoinResponse *res) override;
 
   void stabilize() override;
 
@@ -71,7 +86,7 @@ class Client : public IClient {
 
   chord::common::RouterEntry successor(const uuid_t &id) override;
 
-  grpc::Status successor(grpc::ClientContext *context, const chord::SuccessorRequest *req, chord::SuccessorResponse *res) override;
+  grpc::Status successor(const grpc::ServerContext *parent, const chord::SuccessorRequest *req, chord::SuccessorResponse *res) override;
 
   grpc::Status successor(const chord::SuccessorRequest *req, chord::SuccessorResponse *res) override;
 
@@ -20,7 +20,28 @@ chord::node make_node(const RouterEntry& entry);
 
 chord::node make_node(const grpc::ServerContext*, const RouterEntry& entry);
 
-RouterEntry make_entry(const chord::node& node);
+RouterEntry make_entry(const chord::node& node, const bool legacy_uuids = true);
+
+/**
+ * uuids travel as fixed-width (32 byte) big-endian `*_bin` fields. the
+ * decimal string fields are written additionally as long as nodes without
+ * binary uuids may be part of the ring (Context::legacy_uuids) and are only
+ * read if the binary field is empty.
+ */
+uuid_t uuid_of(const RouterEntry& entry);
+
+void set_uuid(RouterEntry& entry, const uuid_t& uuid, const bool legacy_uuids);
+
+template<typename T>
+uuid_t id_of(const T& req) {
+  return req.id_bin().empty() ? uuid_t{req.id()} : uuid_t::from_bytes(req.id_bin());
+}
+
+template<typename T>
+void set_id(T& req, const uuid_t& id, const bool legacy_uuids) {
+  req.set_id_bin(id.bytes());
+  if(legacy_uuids) req.set_id(id);
+}
 
 template<typename T>
 chord::node source_of(const T* req) {
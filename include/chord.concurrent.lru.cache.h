@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace chord {
+
+/**
+ * thread-safe least recently used cache
+ *
+ * in contrast to LRUCache the elements are distributed to N
+ * segments (by their hash) each guarded by its own mutex. Within
+ * a segment the elements are kept in a hash map whose nodes are
+ * linked by an intrusive list, i.e. lookups, touches and evictions
+ * are O(1) and do not allocate.
+ *
+ * compute_if_absent runs the mapping function outside the lock;
+ * concurrent callers for the same key wait for the first one
+ * (single-flight) instead of computing the value again.
+ *
+ * lookups are heterogeneous if Hash and KeyEqual are transparent.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class ConcurrentLRUCache {
+  public:
+    using mutex_t = std::mutex;
+    static constexpr std::size_t DEFAULT_SEGMENTS = 16;
+
+  private:
+    struct Entry {
+      V value;
+      const K* key{nullptr};
+      Entry* prev{nullptr};
+      Entry* next{nullptr};
+    };
+
+    struct Segment {
+      using map_t = std::unordered_map<K, Entry, Hash, KeyEqual>;
+
+      mutable mutex_t mtx;
+      map_t map;
+      std::unordered_map<K, std::shared_future<V>, Hash, KeyEqual> pending;
+      // most recently used
+      Entry* head{nullptr};
+      // least recently used
+      Entry* tail{nullptr};
+      std::size_t capacity;
+
+      explicit Segment(const std::size_t capacity) : capacity{capacity} {}
+
+      void unlink(Entry* e) {
+        (e->prev ? e->prev->next : head) = e->next;
+        (e->next ? e->next->prev : tail) = e->prev;
+        e->prev = e->next = nullptr;
+      }
+
+      void link_front(Entry* e) {
+        e->prev = nullptr;
+        e->next = head;
+        (head ? head->prev : tail) = e;
+        head = e;
+      }
+
+      void touch(Entry* e) {
+        if(head == e) return;
+        unlink(e);
+        link_front(e);
+      }
+
+      template<typename Q>
+      Entry* find(const Q& k) {
+        const auto it = map.find(k);
+        return it == map.end() ? nullptr : &it->second;
+      }
+
+      template<typename Q>
+      bool erase(const Q& k) {
+        const auto it = map.find(k);
+        if(it == map.end()) return false;
+        unlink(&it->second);
+        map.erase(it);
+        return true;
+      }
+
+      void put(const K& k, const V& v) {
+        if(auto* e = find(k)) {
+          e->value = v;
+          touch(e);
+          return;
+        }
+        const auto [it, _] = map.try_emplace(k, Entry{v});
+        it->second.key = &it->first;
+        link_front(&it->second);
+
+        while(map.size() > capacity && tail) {
+          erase(*tail->key);
+        }
+      }
+
+      void clear() {
+        map.clear();
+        head = tail = nullptr;
+      }
+    };
+
+    std::size_t _capacity;
+    Hash hasher;
+    std::vector<std::unique_ptr<Segment>> segments;
+
+    template<typename Q>
+    Segment& segment(const Q& k) const {
+      // spread the hash since segments and buckets share the same hash
+      const auto h = hasher(k);
+      return *segments[(h ^ (h >> 16)) % segments.size()];
+    }
+
+  public:
+    explicit ConcurrentLRUCache(const std::size_t capacity, const std::size_t num_segments = DEFAULT_SEGMENTS)
+      : _capacity{capacity} {
+      const auto n = std::max<std::size_t>(1, num_segments);
+      // round up to not end up with zero-sized segments
+      const auto segment_capacity = (capacity + n - 1) / n;
+      for(std::size_t i = 0; i < n; ++i) {
+        segments.push_back(std::make_unique<Segment>(segment_capacity));
+      }
+    }
+
+    ConcurrentLRUCache(const ConcurrentLRUCache&) = delete;
+    ConcurrentLRUCache& operator=(const ConcurrentLRUCache&) = delete;
+
+    void clear() {
+      for(auto& s : segments) {
+        std::lock_guard<mutex_t> lck(s->mtx);
+        s->clear();
+      }
+    }
+
+    std::size_t capacity() const { return _capacity; }
+
+    std::size_t size() const {
+      std::size_t ret = 0;
+      for(const auto& s : segments) {
+        std::lock_guard<mutex_t> lck(s->mtx);
+        ret += s->map.size();
+      }
+      return ret;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    template<typename Q>
+    bool exists(const Q& k) const {
+      auto& s = segment(k);
+      std::lock_guard<mutex_t> lck(s.mtx);
+      return s.map.find(k) != s.map.end();
+    }
+
+    template<typename Q>
+    void touch(const Q& k) {
+      auto& s = segment(k);
+      std::lock_guard<mutex_t> lck(s.mtx);
+      if(auto* e = s.find(k)) s.touch(e);
+    }
+
+    template<typename Q>
+    std::optional<V> find(const Q& k) {
+      auto& s = segment(k);
+      std::lock_guard<mutex_t> lck(s.mtx);
+      auto* e = s.find(k);
+      if(!e) return {};
+      s.touch(e);
+      return e->value;
+    }
+
+    template<typename Q>
+    V get(const Q& k) {
+      auto ret = find(k);
+      if(!ret) throw std::out_of_range("element not found");
+      return std::move(*ret);
+    }
+
+    V compute_if_absent(const K& k, std::function<V (const K&)> mapping_function) {
+      auto& s = segment(k);
+      std::promise<V> promise;
+      {
+        std::unique_lock<mutex_t> lck(s.mtx);
+        if(auto* e = s.find(k)) {
+          s.touch(e);
+          return e->value;
+        }
+        if(const auto it = s.pending.find(k); it != s.pending.end()) {
+          auto future = it->second;
+          lck.unlock();
+          return future.get();
+        }
+        s.pending.emplace(k, promise.get_future().share());
+      }
+
+      try {
+        auto value = mapping_function(k);
+        {
+          std::lock_guard<mutex_t> lck(s.mtx);
+          s.put(k, value);
+          s.pending.erase(k);
+        }
+        promise.set_value(value);
+        return value;
+      } catch(...) {
+        {
+          std::lock_guard<mutex_t> lck(s.mtx);
+          s.pending.erase(k);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+      }
+    }
+
+    template<typename Q>
+    bool erase(const Q& k) {
+      auto& s = segment(k);
+      std::lock_guard<mutex_t> lck(s.mtx);
+      return s.erase(k);
+    }
+
+    void put(const K& k, const V& v) {
+      auto& s = segment(k);
+      std::lock_guard<mutex_t> lck(s.mtx);
+      s.put(k, v);
+    }
+};
+
+} // namespace chord
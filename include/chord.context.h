@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <chrono>
 #include <cstdint>
+#include <map>
 #include <string>
 
 #include "chord.log.h"
@@ -33,6 +35,20 @@ struct Context {
   chord::path data_directory{"./data"};
   chord::path meta_directory{"./metadata"};
   chord::path config{"./config.yml"};
+  //--- metadata store (rocksdb)
+  std::size_t meta_block_cache_mb{32};    // shared block cache, 0 disables the cache
+  std::size_t meta_bloom_bits_per_key{10}; // 0 disables bloom filters
+  std::string meta_compression{"none"};   // none, snappy, zlib, lz4, zstd
+  std::size_t meta_write_buffer_mb{16};
+  int meta_background_jobs{2};
+  bool meta_disable_wal{false};           // for replica-only metadata
+  std::size_t meta_cache_size{1024};      // decoded directories, 0 disables the cache
+  //--- routing
+  std::size_t successor_cache_size{0};    // owner intervals of looked up keys, 0 disables the cache
+  std::size_t successor_cache_ttl_ms{30000}; // expiry of the cached owners, 0 keeps them until churn is noticed
+  std::size_t successor_list_size{3};     // closest successors kept for failover and replica addressing
+  //--- wire format
+  bool legacy_uuids{true};                // also send uuids as decimal strings (rolling upgrade)
   //--- promoted endpoint
   chord::endpoint bind_addr{"0.0.0.0:50050"};
   chord::endpoint advertise_addr{bind_addr};
@@ -42,10 +58,29 @@ struct Context {
   //--- scheduling
   size_t stabilize_period_ms{10000};
   size_t check_period_ms{10000};
-  int client_timeout_ms{4000};
+  bool fix_fingers_adaptive{false};       // repair all finger intervals per round, backing off to check-ms
+  size_t fix_fingers_min_period_ms{500};  // period of the rounds after join or churn
+  bool async_maintenance{false};          // stabilize, check and fix fingers without blocking the scheduler
+  int client_timeout_ms{4000};            // deadline of requests, 0 disables the deadline
+  std::map<std::string, int> rpc_timeouts_ms{{"put", 0}, {"get", 0}}; // deadlines by rpc, overriding client_timeout_ms
+  double failure_phi_threshold{8.0};      // suspect a node that failed once its phi exceeds the threshold
+  std::uint32_t failure_max_count{3};     // suspect a node after consecutive failed requests
+  int channel_keepalive_ms{30000};        // keepalive pings of the pooled channels, 0 disables the pings
+
+  //--- filesystem service
+  bool fs_async_server{false};            // callback api instead of the synchronous filesystem service
+  std::size_t fs_max_concurrency{64};     // requests processed at once per method (async server)
+  std::size_t fs_replication_threads{4};  // downstream replication after responding (async server)
+  bool fs_hash_cache{true};               // cache the hash of uploaded files in an extended attribute
+  bool fs_delta_uploads{false};           // put only the chunks that differ from the stored file
+  bool fs_chunk_store{false};             // keep files deduplicated as content-defined chunks (<meta>/chunks)
+  std::size_t fs_get_range_mb{0};         // get larger files in ranges from the owner and its replicas in parallel, 0 disables
+  bool fs_resumable_puts{false};          // continue interrupted puts of larger files at the offset received (<journal>/.partial)
+  std::size_t fs_partial_expiry_h{24};    // drop interrupted puts not resumed within (swept at startup), 0 keeps them
 
   //--- replication / striping
   std::int32_t replication_cnt{1}; //default replication factor if not overriden
+  bool pipelined_replication{false};      // forward the chunks of a put to the next replica while receiving
 
   //--- logging
   log::Logging logging;
@@ -53,9 +88,19 @@ struct Context {
   inline const uuid_t &uuid() const { return _uuid; }
   inline chord::node node() const { return {_uuid, advertise_addr}; }
 
+  /**
+   * timeout of requests of the rpc (e.g. successor, put), 0 if unbounded
+   */
+  inline std::chrono::milliseconds timeout(const std::string& rpc) const {
+    const auto it = rpc_timeouts_ms.find(rpc);
+    return std::chrono::milliseconds(it == rpc_timeouts_ms.end() ? client_timeout_ms : it->second);
+  }
+
   void set_uuid(const uuid_t uuid);
 
   chord::path journal_directory() const { return meta_directory / "journal"; }
+  chord::path chunk_directory() const { return meta_directory / "chunks"; }
+  chord::path partial_directory() const { return journal_directory() / ".partial"; }
 
   Context set_router(chord::Router *router);
 
@@ -2,11 +2,12 @@
 
 #include <array>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <fstream>
 #include <openssl/sha.h>
 #include <openssl/evp.h>
-#include <boost/multiprecision/cpp_int.hpp>
 
 #include "chord.uuid.h"
 #include "chord.path.h"
@@ -15,55 +16,98 @@
 namespace chord {
 namespace crypto {
 
-using boost::multiprecision::import_bits;
-
+/**
+ * incremental sha256 - the state of the hasher can be saved and the
+ * hashing resumed from it later (e.g. by a resumed upload).
+ *
+ * NOTE: the low-level SHA256 api is deprecated in openssl 3 but, unlike
+ *       the EVP api, exposes the state of the hash.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 struct sha256_hasher final {
+  // intermediate hash, bit count, buffered block and its length, digest length
+  static constexpr std::size_t state_size = (8 + 2) * 4 + SHA_CBLOCK + 2 * 4;
 
-  EVP_MD_CTX* context;
-  const EVP_MD* digest;
+  SHA256_CTX context;
   unsigned char hash[SHA256_DIGEST_LENGTH] = {0};
 
   sha256_hasher() {
-    context = EVP_MD_CTX_create();
-    digest = EVP_get_digestbyname("SHA256");
-    if(!EVP_DigestInit_ex(context, digest, nullptr)) {
+    if(!SHA256_Init(&context)) {
       throw__exception("failed to initialize SHA256");
     }
   }
 
-  virtual ~sha256_hasher() {
-    EVP_MD_CTX_destroy(context);
+  /**
+   * resume the hashing from the state (see state())
+   */
+  explicit sha256_hasher(const std::string& state) {
+    if(state.size() != state_size) throw__exception("failed to restore SHA256: invalid state");
+
+    std::size_t pos = 0;
+    const auto get = [&] {
+      std::uint32_t value = 0;
+      for(int i = 0; i < 4; ++i) value = (value << 8) | static_cast<unsigned char>(state[pos++]);
+      return static_cast<SHA_LONG>(value);
+    };
+    for(auto& h : context.h) h = get();
+    context.Nl = get();
+    context.Nh = get();
+    // the block is buffered as bytes
+    std::memcpy(context.data, state.data() + pos, SHA_CBLOCK);
+    pos += SHA_CBLOCK;
+    context.num = get();
+    context.md_len = get();
+    if(context.num >= SHA_CBLOCK || context.md_len != SHA256_DIGEST_LENGTH) {
+      throw__exception("failed to restore SHA256: invalid state");
+    }
   }
+
   void operator()(const void* input, const unsigned long length) {
     update(input, length);
   }
 
   void update(const void* input, const unsigned long length) {
-  if (!EVP_DigestUpdate(context, static_cast<const unsigned char*>(input), length))
-    throw__exception("failed to update SHA256");
+    if (!SHA256_Update(&context, input, length))
+      throw__exception("failed to update SHA256");
+  }
+
+  /**
+   * state of the hash so far - independent of the byte order of the host
+   */
+  std::string state() const {
+    std::string ret;
+    ret.reserve(state_size);
+    const auto put = [&](const SHA_LONG value) {
+      for(int shift = 24; shift >= 0; shift -= 8) ret.push_back(static_cast<char>((value >> shift) & 0xFF));
+    };
+    for(const auto h : context.h) put(h);
+    put(context.Nl);
+    put(context.Nh);
+    ret.append(reinterpret_cast<const char*>(context.data), SHA_CBLOCK);
+    put(context.num);
+    put(context.md_len);
+    return ret;
   }
 
   chord::uuid get() {
-    if(!EVP_DigestFinal_ex(context, hash, nullptr))
+    if(!SHA256_Final(hash, &context))
       throw__exception("failed to finalise SHA256");
-    auto uuid = uuid_t{0};
-    import_bits(uuid.value(), hash, hash + SHA256_DIGEST_LENGTH);
-    return uuid;
+    return uuid::from_bytes({reinterpret_cast<const char*>(hash), SHA256_DIGEST_LENGTH});
   }
 };
+#pragma GCC diagnostic pop
 
 inline void sha256(const void *input, unsigned long length, unsigned char *hash) {
   SHA256(static_cast<const unsigned char*>(input), length, hash);
 }
 
 inline uuid_t sha256(const void *input, unsigned long length) {
-  auto uuid = uuid_t{0};
   unsigned char hash[SHA256_DIGEST_LENGTH];
 
   sha256(input, length, hash);
-  import_bits(uuid.value(), hash, hash + SHA256_DIGEST_LENGTH);
 
-  return uuid;
+  return uuid::from_bytes({reinterpret_cast<const char*>(hash), SHA256_DIGEST_LENGTH});
 }
 
 inline uuid_t sha256(const std::string &str) {
@@ -71,7 +115,6 @@ inline uuid_t sha256(const std::string &str) {
 }
 
 inline uuid_t sha256(std::istream &istream) {
-  auto uuid = uuid_t{0};
   constexpr const std::size_t buffer_size { 1 << 12 };
   std::array<char, buffer_size> buffer;
 
@@ -92,8 +135,7 @@ inline uuid_t sha256(std::istream &istream) {
 
   EVP_MD_CTX_destroy(context);
 
-  import_bits(uuid.value(), hash, hash + SHA256_DIGEST_LENGTH);
-  return uuid;
+  return uuid::from_bytes({reinterpret_cast<const char*>(hash), SHA256_DIGEST_LENGTH});
 }
 
 inline uuid_t sha256(const chord::path& path) {
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <grpcpp/client_context.h>
+
+#include "chord.context.h"
+
+namespace chord {
+namespace deadline {
+
+using clock = std::chrono::system_clock;
+using time_point = clock::time_point;
+
+/**
+ * deadline of a request of the given rpc issued now - bounded by the
+ * deadline (budget) of the request it is issued on behalf of, if any.
+ *
+ * the budget of a request forwarded across several hops shrinks with
+ * every hop, since each hop passes on the absolute deadline it received.
+ *
+ * @return empty if the request is not bounded
+ */
+inline std::optional<time_point> of(const Context& context, const std::string& rpc, const std::optional<time_point> budget = {}) {
+  const auto timeout = context.timeout(rpc);
+  std::optional<time_point> ret;
+  if(timeout.count() > 0) ret = clock::now() + timeout;
+  if(budget && *budget != time_point::max()) ret = ret ? std::min(*ret, *budget) : *budget;
+  return ret;
+}
+
+inline bool exceeded(const std::optional<time_point>& deadline) {
+  return deadline && *deadline <= clock::now();
+}
+
+inline void set(grpc::ClientContext& client_context, const std::optional<time_point>& deadline) {
+  if(deadline) client_context.set_deadline(*deadline);
+}
+
+} // namespace deadline
+} // namespace chord
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
+#include "chord.async.client.h"
 #include "chord.i.scheduler.h"
 #include "chord.router.h"
 #include "chord.uuid.h"
@@ -10,6 +15,7 @@
 #include "chord.i.service.h"
 #include "chord.node.h"
 #include "chord.signal.h"
+#include "chord.successor.cache.h"
 
 namespace chord { struct Context; }
 namespace chord { class ChannelPool; }
@@ -26,8 +32,16 @@ public:
   using event_unary_t = signal<const node>;
 
  private:
+  using clock = std::chrono::steady_clock;
+
   size_t next{0};
 
+  //--- adaptive fix fingers
+  std::mutex fingers_mtx;
+  std::chrono::milliseconds fingers_period{0};
+  std::optional<clock::time_point> fingers_unstable_since;
+  std::optional<std::chrono::milliseconds> fingers_convergence;
+
   chord::Context& context;
 
   std::unique_ptr<chord::Router> router;
@@ -38,15 +52,26 @@ public:
 
   std::unique_ptr<AbstractScheduler> scheduler;
 
+  SuccessorCache _successor_cache;
+
   std::shared_ptr<spdlog::logger> logger;
 
   //--- events
   event_binary_t event_leave;
   event_unary_t event_join;
 
+  // declared last: pending probes are awaited first on destruction
+  std::unique_ptr<chord::AsyncClient> async_client;
+
   void start_scheduler();
   void stop_scheduler();
   void join_failed(const grpc::Status&);
+  void init_successor_cache();
+
+  void schedule_fix_fingers();
+  void fingers_churn();
+  bool fingers_round(const bool changed, const size_t intervals);
+  std::chrono::milliseconds fingers_min_period() const;
 
  public:
   ChordFacade(const ChordFacade &) = delete;             // disable copying
@@ -77,11 +102,33 @@ public:
   void join();
 
   /**
-   * successor
+   * successor - cached lookups are meant for the requests of clients,
+   * placement decisions of the services must not rely on the cache.
    */
-  chord::node successor(const uuid_t &uuid);
+  chord::node successor(const uuid_t &uuid, const bool cached = true);
   chord::node successor();
 
+  /**
+   * successor list, closest first - the nodes holding the replicas of
+   * the keys of this node.
+   */
+  std::vector<chord::node> successors() const;
+
+  /**
+   * whether the key is owned by this node, i.e. is in (predecessor, this] -
+   * true as long as the predecessor is unknown.
+   */
+  bool is_responsible(const uuid_t &uuid) const;
+
+  /**
+   * drop the cached owner of the uuid, e.g. if the owner turned out to be stale
+   *
+   * @return true if the owner has been cached
+   */
+  bool invalidate(const uuid_t &uuid);
+
+  const SuccessorCache& successor_cache() const;
+
   /**
    * stabilize the ring
    */
@@ -92,11 +139,30 @@ public:
    */
   void check_predecessor();
 
+  /**
+   * remove the nodes suspected by the failure detector
+   */
+  void evict_failed_nodes();
+
   /**
    * fix finger table
    */
   void fix_fingers(size_t index);
 
+  /**
+   * repair every distinct finger interval in one round and adapt the
+   * period of the next round.
+   *
+   * @return true if the round changed the finger table
+   */
+  bool fix_fingers();
+
+  /**
+   * time the finger table took to stabilize after the last join or churn,
+   * empty while the table is still converging.
+   */
+  std::optional<std::chrono::milliseconds> fingers_convergence_time();
+
   event_unary_t& on_join();
 
   event_binary_t& on_leave();
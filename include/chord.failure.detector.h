@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "chord.node.h"
+
+namespace chord {
+
+/**
+ * phi accrual failure detector
+ *
+ * fed by the outcome of the requests to the other nodes (stabilize,
+ * check, notify, lookups, ...). for every node the intervals between
+ * successful requests are sampled; phi expresses the suspicion that a
+ * node has failed given the time since its last successful request,
+ * assuming exponentially distributed intervals:
+ *
+ *   phi(t) = -log10(P(interval > t)) = t / mean * log10(e)
+ *
+ * since nodes are not contacted at a regular rate, silence alone is no
+ * evidence of failure: a node is suspected only after a failed request
+ * once phi exceeds the threshold, or after `max_failures` consecutive
+ * failed requests. nodes without any history are considered alive.
+ */
+class FailureDetector {
+ public:
+  using clock = std::chrono::steady_clock;
+  using time_point = clock::time_point;
+
+  static constexpr std::size_t WINDOW = 32;
+
+ private:
+  struct History {
+    std::deque<double> intervals;  // ms
+    std::optional<time_point> last;
+    std::uint32_t failures{0};
+  };
+
+  const double threshold;
+  const std::uint32_t max_failures;
+  // assumed interval until the first samples arrive (ms)
+  const double initial_interval;
+
+  mutable std::mutex mtx;
+  std::map<chord::uuid, History> histories;
+
+  double phi(const History& history, const time_point now) const {
+    if(!history.last) return 0.0;
+    const auto mean = history.intervals.empty()
+      ? initial_interval
+      : std::accumulate(history.intervals.begin(), history.intervals.end(), 0.0) / static_cast<double>(history.intervals.size());
+    const auto elapsed = std::chrono::duration<double, std::milli>(now - *history.last).count();
+    return elapsed / std::max(mean, 1.0) * std::log10(std::exp(1.0));
+  }
+
+  bool suspects(const History& history, const time_point now) const {
+    if(history.failures == 0) return false;
+    return history.failures >= max_failures || phi(history, now) > threshold;
+  }
+
+ public:
+  FailureDetector(const double threshold, const std::uint32_t max_failures, const std::chrono::milliseconds initial_interval)
+    : threshold{threshold},
+      max_failures{max_failures},
+      initial_interval{static_cast<double>(initial_interval.count())} {}
+
+  FailureDetector(const FailureDetector&) = delete;
+
+  /**
+   * successful request to the node
+   */
+  void heartbeat(const chord::node& node, const time_point now = clock::now()) {
+    std::lock_guard<std::mutex> lck(mtx);
+    auto& history = histories[node.uuid];
+    if(history.last) {
+      history.intervals.push_back(std::chrono::duration<double, std::milli>(now - *history.last).count());
+      if(history.intervals.size() > WINDOW) history.intervals.pop_front();
+    }
+    history.last = now;
+    history.failures = 0;
+  }
+
+  /**
+   * failed request to the node
+   */
+  void failure(const chord::node& node, const time_point now = clock::now()) {
+    std::lock_guard<std::mutex> lck(mtx);
+    auto& history = histories[node.uuid];
+    // first contact failed: count from now on
+    if(!history.last) history.last = now;
+    ++history.failures;
+  }
+
+  double phi(const chord::node& node, const time_point now = clock::now()) const {
+    std::lock_guard<std::mutex> lck(mtx);
+    const auto it = histories.find(node.uuid);
+    return it == histories.end() ? 0.0 : phi(it->second, now);
+  }
+
+  bool suspects(const chord::node& node, const time_point now = clock::now()) const {
+    std::lock_guard<std::mutex> lck(mtx);
+    const auto it = histories.find(node.uuid);
+    return it != histories.end() && suspects(it->second, now);
+  }
+
+  bool is_alive(const chord::node& node, const time_point now = clock::now()) const {
+    return !suspects(node, now);
+  }
+
+  /**
+   * all suspected nodes
+   */
+  std::vector<chord::uuid> suspected(const time_point now = clock::now()) const {
+    std::lock_guard<std::mutex> lck(mtx);
+    std::vector<chord::uuid> ret;
+    for(const auto& [uuid, history] : histories) {
+      if(suspects(history, now)) ret.push_back(uuid);
+    }
+    return ret;
+  }
+
+  /**
+   * forget the node, e.g. once it has been removed from the router
+   */
+  void remove(const chord::uuid& uuid) {
+    std::lock_guard<std::mutex> lck(mtx);
+    histories.erase(uuid);
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lck(mtx);
+    histories.clear();
+  }
+};
+
+}  // namespace chord
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <grpcpp/impl/codegen/status.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/server_callback.h>
+
+#include "chord.scheduler.h"
+#include "chord_fs.grpc.pb.h"
+
+namespace chord { struct Context; }
+namespace chord { namespace fs { class Service; } }
+namespace spdlog { class logger; }
+
+namespace chord {
+namespace fs {
+
+/**
+ * callback api implementation of the filesystem service
+ *
+ * the handlers of fs::Service block on disk io and on the requests to
+ * other nodes. instead of pinning a thread of the synchronous server
+ * per request, every method is processed by its own executor of
+ * fs-max-concurrency threads - excess requests are queued without
+ * occupying a thread. streams are admitted at the same rate, i.e. a
+ * stream waiting for a slot is not read.
+ *
+ * puts respond as soon as the file and its metadata are stored, the
+ * replication to the successor is done by a separate executor.
+ */
+class CallbackService final : public chord::fs::Filesystem::CallbackService {
+  static constexpr auto logger_name = "chord.fs.callback.service";
+
+  /**
+   * bounded number of concurrently processed streams
+   */
+  class Slots {
+    std::mutex mtx;
+    std::size_t available;
+    std::deque<std::function<void()>> waiting;
+
+   public:
+    explicit Slots(const std::size_t size) : available{size} {}
+
+    /**
+     * run admitted once a slot is available - immediately if possible
+     */
+    void acquire(std::function<void()> admitted);
+
+    /**
+     * pass the slot on to the next waiting stream
+     */
+    void release();
+  };
+
+  class PutReactor;
+  class GetReactor;
+  class AssembleReactor;
+
+  Context& context;
+  fs::Service* service;
+
+  Slots put_slots;
+  Slots get_slots;
+
+  std::shared_ptr<spdlog::logger> logger;
+
+  // declared last: the executors are joined first on destruction
+  Scheduler put_executor;
+  Scheduler get_executor;
+  Scheduler del_executor;
+  Scheduler mov_executor;
+  Scheduler meta_executor;
+  Scheduler replication_executor;
+
+  /**
+   * run the blocking handler on the executor and finish the reactor with its status
+   */
+  grpc::ServerUnaryReactor* run(grpc::CallbackServerContext*, Scheduler&, std::function<grpc::Status()>);
+
+ public:
+  CallbackService(Context& context, fs::Service* service);
+
+  grpc::ServerReadReactor<chord::fs::PutRequest>* put(grpc::CallbackServerContext*, chord::fs::PutResponse*) override;
+
+  grpc::ServerWriteReactor<chord::fs::GetResponse>* get(grpc::CallbackServerContext*, const chord::fs::GetRequest*) override;
+
+  grpc::ServerUnaryReactor* del(grpc::CallbackServerContext*, const chord::fs::DelRequest*, chord::fs::DelResponse*) override;
+
+  grpc::ServerUnaryReactor* mov(grpc::CallbackServerContext*, const chord::fs::MovRequest*, chord::fs::MovResponse*) override;
+
+  grpc::ServerUnaryReactor* meta(grpc::CallbackServerContext*, const chord::fs::MetaRequest*, chord::fs::MetaResponse*) override;
+
+  grpc::ServerUnaryReactor* chunks(grpc::CallbackServerContext*, const chord::fs::ChunksRequest*, chord::fs::ChunksResponse*) override;
+
+  grpc::ServerUnaryReactor* missing(grpc::CallbackServerContext*, const chord::fs::MissingRequest*, chord::fs::MissingResponse*) override;
+
+  grpc::ServerReadReactor<chord::fs::AssembleRequest>* assemble(grpc::CallbackServerContext*, chord::fs::PutResponse*) override;
+};
+
+} //namespace fs
+} //namespace chord
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "chord.crypto.h"
+#include "chord.uuid.h"
+
+namespace chord {
+namespace fs {
+
+/**
+ * hashes of the fixed-size chunks of a file - stored along with the
+ * metadata of the file to put only the chunks that changed.
+ */
+struct ChunkManifest {
+  static constexpr std::uint64_t CHUNK_SIZE = static_cast<std::uint64_t>(512)*1024; // 512k
+
+  // hash of the whole file the manifest belongs to
+  chord::uuid file_hash;
+  std::uint64_t chunk_size{CHUNK_SIZE};
+  std::uint64_t file_size{0};
+  std::vector<chord::uuid> chunks;
+
+  static std::uint64_t count(const std::uint64_t file_size, const std::uint64_t chunk_size) {
+    return (file_size + chunk_size - 1) / chunk_size;
+  }
+
+  bool operator==(const ChunkManifest&) const = default;
+
+  class Builder;
+};
+
+/**
+ * hashes the chunks of the file while it is being written. writes
+ * either continue at the current position or start at a chunk
+ * boundary (delta put) - the chunks not written are taken from the base.
+ */
+class ChunkManifest::Builder {
+  std::uint64_t chunk_size;
+  std::vector<std::optional<chord::uuid>> chunks;
+  // hasher of the chunk at position, if started
+  std::optional<crypto::sha256_hasher> hasher;
+  std::uint64_t position{0};
+  bool valid{true};
+
+  void set(const std::uint64_t index, const chord::uuid& hash);
+
+ public:
+  explicit Builder(const std::uint64_t chunk_size = CHUNK_SIZE);
+  explicit Builder(const ChunkManifest& base);
+  Builder(const Builder&) = delete;
+  Builder& operator=(const Builder&) = delete;
+
+  void write(const std::uint64_t offset, const char* data, std::size_t len);
+
+  /**
+   * manifest of the file - empty if a chunk is incomplete and
+   * not known from the base.
+   */
+  std::optional<ChunkManifest> finish(const chord::uuid& file_hash, const std::uint64_t file_size);
+};
+
+} // namespace fs
+} // namespace chord
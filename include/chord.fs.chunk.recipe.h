@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "chord.uuid.h"
+
+namespace chord {
+namespace fs {
+
+/**
+ * content-defined chunks of a file kept in the chunk store - the file
+ * is the concatenation of its chunks.
+ */
+struct ChunkRecipe {
+  struct Chunk {
+    chord::uuid hash;
+    std::uint32_t size{0};
+
+    bool operator==(const Chunk&) const = default;
+  };
+
+  // hash of the whole file
+  chord::uuid file_hash;
+  std::uint64_t file_size{0};
+  std::vector<Chunk> chunks;
+
+  bool operator==(const ChunkRecipe&) const = default;
+};
+
+} // namespace fs
+} // namespace chord
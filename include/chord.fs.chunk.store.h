@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "chord.fs.chunk.recipe.h"
+#include "chord.fs.chunker.h"
+#include "chord.path.h"
+#include "chord.uri.h"
+#include "chord.uuid.h"
+
+namespace chord { struct Context; }
+namespace chord { namespace fs { class IMetadataManager; } }
+namespace spdlog { class logger; }
+
+namespace chord {
+namespace fs {
+
+/**
+ * deduplicating storage engine (fs-chunk-store)
+ *
+ * files are split into content-defined chunks (see Chunker), each chunk
+ * is stored once by its hash (<meta>/chunks/<hex[0:2]>/<hex>) no matter
+ * how many files - or versions of a file - contain it. the recipe of
+ * every file and the reference counts of the chunks are kept in the
+ * metadata store, a chunk is removed once it is no longer referenced.
+ */
+class ChunkStore {
+  static constexpr auto logger_name = "chord.fs.chunk.store";
+
+  const Context& context;
+  IMetadataManager* metadata_mgr;
+  Chunker chunker;
+
+  /**
+   * storing and referencing chunks (shared) vs. removing the chunks no
+   * longer referenced (exclusive) - a stored chunk is not removed before
+   * the recipe referencing it is set.
+   */
+  std::shared_mutex mtx;
+
+  std::shared_ptr<spdlog::logger> logger;
+
+  chord::uuid write(const char* data, const std::size_t len);
+
+  /**
+   * remove the released chunks - unless referenced meanwhile
+   */
+  void release(const std::vector<chord::uuid>& chunks);
+
+ public:
+  ChunkStore(const Context&, IMetadataManager*, const Chunker& = Chunker{});
+  ChunkStore(const ChunkStore&) = delete;
+  ChunkStore& operator=(const ChunkStore&) = delete;
+
+  chord::path chunk_path(const chord::uuid& chunk) const;
+
+  bool contains(const chord::uuid& chunk) const;
+
+  /**
+   * store the chunk - referenced once a recipe containing it is set
+   *
+   * @return hash of the chunk
+   */
+  chord::uuid store(const char* data, const std::size_t len);
+
+  /**
+   * data of the chunk, throws if the chunk is not stored
+   */
+  std::string load(const chord::uuid& chunk) const;
+
+  /**
+   * split the stream into chunks, store them and set the recipe of the file
+   */
+  ChunkRecipe add(const chord::uri&, std::istream&);
+
+  /**
+   * set the recipe of the file
+   *
+   * @return false if a chunk of the recipe is not stored
+   */
+  bool add(const chord::uri&, const ChunkRecipe&);
+
+  std::optional<ChunkRecipe> recipe(const chord::uri&);
+
+  /**
+   * remove the recipe of the file (and the chunks no longer referenced)
+   */
+  void remove(const chord::uri&);
+
+  /**
+   * indices of the chunks that are not stored
+   */
+  std::vector<std::size_t> missing(const std::vector<chord::uuid>& chunks) const;
+
+  /**
+   * seekable stream of the file, the chunks are read on demand
+   */
+  std::unique_ptr<std::istream> open(const ChunkRecipe&) const;
+};
+
+} // namespace fs
+} // namespace chord
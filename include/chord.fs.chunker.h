@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+
+namespace chord {
+namespace fs {
+
+/**
+ * content-defined chunking (FastCDC)
+ *
+ * the boundaries of the chunks are found by a rolling (gear) hash of
+ * the content - inserting or removing bytes shifts the boundaries of
+ * the surrounding chunks only, the chunks of the rest of the file
+ * remain the same (and are deduplicated).
+ *
+ * the chunks are normalized: a stricter mask is used below the average
+ * size and a looser one above, narrowing the distribution of the sizes.
+ */
+class Chunker {
+  std::size_t min_size;
+  std::size_t avg_size;
+  std::size_t max_size;
+  // masks below (small) and above (large) the average size
+  std::uint64_t mask_s;
+  std::uint64_t mask_l;
+
+ public:
+  static constexpr std::size_t MIN_SIZE = static_cast<std::size_t>(16)*1024;  // 16k
+  static constexpr std::size_t AVG_SIZE = static_cast<std::size_t>(64)*1024;  // 64k
+  static constexpr std::size_t MAX_SIZE = static_cast<std::size_t>(256)*1024; // 256k
+
+  /**
+   * @param avg_size power of two, min_size < avg_size < max_size
+   */
+  explicit Chunker(const std::size_t min_size = MIN_SIZE, const std::size_t avg_size = AVG_SIZE, const std::size_t max_size = MAX_SIZE);
+
+  /**
+   * size of the chunk starting at data - the chunk ends with the data
+   * if no boundary is found within len (< max size) bytes.
+   */
+  std::size_t cut(const char* data, const std::size_t len) const;
+
+  /**
+   * split the stream into chunks, passed in order to the consumer
+   */
+  void split(std::istream&, const std::function<void(const char*, std::size_t)>& consumer) const;
+
+  std::size_t max() const { return max_size; }
+};
+
+} // namespace fs
+} // namespace chord
@@ -2,14 +2,22 @@
 
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/client_context.h>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <set>
+#include <string>
+#include <vector>
 
+#include "chord.fs.chunk.manifest.h"
+#include "chord.fs.chunk.recipe.h"
 #include "chord.fs.replication.h"
 #include "chord.types.h"
 #include "chord.uri.h"
+#include "chord.uuid.h"
 #include "chord_fs.grpc.pb.h"
 #include "chord.i.fs.metadata.manager.h"
 #include "chord.fs.client.options.h"
@@ -17,9 +25,11 @@
 namespace chord { class path; }
 namespace chord { class ChordFacade; }
 namespace chord { class ChannelPool; }
+namespace chord { namespace fs { class ChunkStore; } }
 namespace chord { namespace fs { class DelRequest; } }
 namespace chord { namespace fs { class MetaRequest; } }
 namespace chord { namespace fs { struct Metadata; } }
+namespace chord { namespace fs { class Service; } }
 namespace chord { struct Context; }
 namespace chord { struct node; }
 namespace spdlog { class logger; }
@@ -36,29 +46,119 @@ class Client {
  public:
   enum class Action { ADD, DEL, DIR };
 
+  /**
+   * put of the chunks that differ from the base - the version of the
+   * file held by the receiver
+   */
+  struct Delta {
+    chord::uuid base;
+    std::uint64_t file_size;
+  };
+
+  /**
+   * put forwarded chunk by chunk while the file is being received
+   * (chain replication)
+   */
+  class PutStream {
+    friend class Client;
+
+    grpc::ClientContext client_context;
+    chord::fs::PutResponse res;
+    std::unique_ptr<chord::fs::Filesystem::Stub> stub;
+    std::unique_ptr<grpc::ClientWriter<chord::fs::PutRequest>> writer;
+    bool file_hash_equal{false};
+    bool broken{false};
+
+   public:
+    /**
+     * forward the chunk
+     *
+     * @return false once the stream broke
+     */
+    bool write(const chord::fs::PutRequest&);
+
+    /**
+     * wait until the file has been stored by the replica - and by the
+     * replicas it forwarded the file to
+     */
+    grpc::Status finish();
+
+    /**
+     * abort the put - the replica does not commit the part received
+     */
+    void cancel();
+  };
+
  private:
   static constexpr auto logger_name = "chord.fs.client";
 
+  // chunk hashes per missing / assemble request (paging)
+  static constexpr std::size_t chunks_per_request = 64*1024;
+
+  // attempts of a resumable put and the delay before resuming (times the attempt)
+  static constexpr std::size_t put_attempts = 3;
+  static constexpr std::chrono::milliseconds put_retry_delay{200};
+
   Context &context;
   chord::ChordFacade* chord;
   chord::ChannelPool* channel_pool;
   chord::fs::IMetadataManager* metadata_mgr;
+  chord::fs::Service* local_service{nullptr};
 
   StubFactory make_stub;
   std::shared_ptr<spdlog::logger> logger;
 
-  void init_context(grpc::ClientContext&, const client::options&);
+  void init_context(grpc::ClientContext&, const client::options&, const std::string& rpc);
+
+  bool is_local(const chord::node&) const;
+
+  /**
+   * stub on the bulk lane of the pooled channels - file transfers do not
+   * block the control rpcs to the same node
+   */
+  std::unique_ptr<chord::fs::Filesystem::Stub> make_bulk_stub(const chord::node&);
+
+  /**
+   * put the stream - the stream is hashed first unless the hash is passed
+   */
+  grpc::Status put(const chord::node&, const chord::uri&, std::istream&, const std::optional<chord::uuid>& file_hash, const client::options&);
+
+  /**
+   * single attempt of the put - a resumable put continues at the offset
+   * committed by the receiver
+   */
+  grpc::Status put_attempt(const chord::node&, const chord::uri&, std::istream&, const std::optional<chord::uuid>& file_hash, const std::optional<std::uint64_t>& file_size, const std::optional<ChunkManifest>& base, const bool resumable, const client::options&);
+
+  /**
+   * issue the call to the owner of the hash - retry once if a cached
+   * owner turns out to be stale.
+   */
+  template<typename Call>
+  grpc::Status with_successor(const chord::uuid&, Call&&);
+
+  /**
+   * owner of the hash followed by the nodes holding its replicas
+   */
+  std::vector<chord::node> replica_nodes(const chord::uuid&, const std::uint32_t count);
 
  public:
   Client(Context &context, chord::ChordFacade* chord, chord::fs::IMetadataManager* metadata_mgr, ChannelPool* channel_pool);
 
   Client(Context &context, chord::ChordFacade* chord, StubFactory factory);
 
+  /**
+   * requests to this node are dispatched to the service in-process
+   */
+  void set_local_service(chord::fs::Service*);
+
   // called internally by the chord.fs.service
   grpc::Status put(const chord::node&, const chord::uri&, std::istream&, const client::options& = {});
   grpc::Status put(const chord::node&, const chord::uri&, const chord::path&, const client::options& = {});
 
   grpc::Status put(const chord::uri&, std::istream&, const client::options& = {});
+
+  // called internally by the chord.fs.service
+  std::unique_ptr<PutStream> put_stream(const chord::node&, const chord::uri&, const std::optional<chord::uuid>& file_hash, const client::options& = {}, const std::optional<Delta>& delta = {});
   grpc::Status put(const chord::uri&, const chord::path&, const client::options& = {});
 
   grpc::Status mkdir(const chord::uri&, const client::options& = {});
@@ -69,6 +169,19 @@ class Client {
   grpc::Status get(const chord::uri&, const chord::node&, std::ostream&);
   grpc::Status get(const chord::uri&, const chord::node&, const chord::path&);
 
+  /**
+   * get the range [offset, offset+length) of the file - to the end of
+   * the file if the length is 0
+   */
+  grpc::Status get(const chord::uri&, const chord::node&, std::ostream&, const std::uint64_t offset, const std::uint64_t length);
+
+  /**
+   * get the file in ranges of range_size fetched in parallel from the
+   * owner and the nodes holding its replicas - a failed range is
+   * retried on the next node.
+   */
+  grpc::Status get(const chord::uri&, const chord::path&, const std::uint64_t range_size);
+
   grpc::Status del(const chord::uri&, const bool recursive=false, const client::options& = {});
   grpc::Status del(const chord::node&, const chord::uri&, const bool recursive=false, const client::options& = {});
   grpc::Status del(const chord::node&, const DelRequest*, const client::options& options = {});
@@ -84,6 +197,17 @@ class Client {
   // called internally by the chord.fs.service
   grpc::Status meta(const chord::node&, const chord::uri&, const Action&, std::set<Metadata>&, const client::options& = {});
 
+  /**
+   * chunk manifest of the file stored by the node
+   */
+  grpc::Status chunks(const chord::node&, const chord::uri&, ChunkManifest&, const client::options& = {});
+
+  /**
+   * put the file of the chunk store - sends only the chunks the node
+   * lacks. the whole file is put if the node has no chunk store.
+   */
+  grpc::Status assemble(const chord::node&, const chord::uri&, const ChunkStore&, const ChunkRecipe&, const client::options& = {});
+
 };
 
 }  // namespace fs
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
 #include "chord.fs.replication.h"
 #include "chord.uuid.h"
@@ -12,6 +13,8 @@ namespace client {
   struct options {
     Replication replication = Replication::NONE;
     std::optional<chord::uuid> source;
+    // deadline of the request issued on behalf of - bounds forwarded requests
+    std::optional<std::chrono::system_clock::time_point> deadline;
     union {
       bool recursive = false; // del
       bool rebalance; // put
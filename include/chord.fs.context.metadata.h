@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <optional>
 #include <grpcpp/server_context.h>
 #include <grpcpp/client_context.h>
@@ -19,30 +20,68 @@ struct ContextMetadata {
   static constexpr auto replication_count = "replication.count";
   static constexpr auto replication_index = "replication.index";
   static constexpr auto file_hash = "file.hash";
+  static constexpr auto file_hash_bin = "file.hash-bin";
   static constexpr auto uri = "uri";
   static constexpr auto src = "src";
+  static constexpr auto src_bin = "src-bin";
   static constexpr auto file_hash_equal = "file.hash.equal";
   static constexpr auto rebalance = "rebalance";
+  static constexpr auto delta_base_bin = "delta.base-bin";
+  static constexpr auto file_size = "file.size";
+  static constexpr auto delta_accepted = "delta.accepted";
+  static constexpr auto resume = "put.resume";
+  static constexpr auto committed_offset = "put.offset";
 
-  static client::options from(const grpc::ServerContext*);
+  static client::options from(const grpc::ServerContextBase*);
 
-  static void add(grpc::ClientContext&, const chord::fs::Metadata&);
+  /**
+   * uuids are sent as binary (`-bin`) metadata, the decimal keys are added
+   * for nodes without binary uuids only if `legacy_uuids` is set.
+   */
+  static void add(grpc::ClientContext&, const chord::fs::Metadata&, const bool legacy_uuids = true);
   static void add(grpc::ClientContext&, const chord::fs::Replication&);
   static void add(grpc::ClientContext&, const chord::uri&);
-  static void add(grpc::ClientContext&, std::istream&);
-  static void add(grpc::ClientContext&, const std::optional<chord::uuid>&);
+  static void add(grpc::ClientContext&, std::istream&, const bool legacy_uuids = true);
+  static void add(grpc::ClientContext&, const std::optional<chord::uuid>&, const bool legacy_uuids = true);
   static void add_src(grpc::ClientContext& context);
-  static void add_src(grpc::ClientContext&, const chord::uuid&);
-  static void set_file_hash_equal(grpc::ServerContext* context, const bool=true);
+  static void add_src(grpc::ClientContext&, const chord::uuid&, const bool legacy_uuids = true);
+  static void set_file_hash_equal(grpc::ServerContextBase* context, const bool=true);
 
   static void add_rebalance(grpc::ClientContext&, const bool);
 
-  static chord::fs::Replication replication_from(const grpc::ServerContext*);
-  static std::optional<chord::uuid> file_hash_from(const grpc::ServerContext*);
-  static chord::uri uri_from(const grpc::ServerContext*);
-  static std::optional<chord::uuid> src_from(const grpc::ServerContext*);
+  /**
+   * put only the chunks that differ from the base - the version of the
+   * file expected on the receiver. the receiver tells the client
+   * (initial metadata) whether it holds the base.
+   */
+  static void add_delta(grpc::ClientContext&, const chord::uuid& base, const std::uint64_t file_size);
+  static void set_delta_accepted(grpc::ServerContextBase* context, const bool=true);
+
+  /**
+   * resumable put of the file (size) - the receiver keeps the bytes
+   * received and tells the client (initial metadata) the offset to
+   * continue at.
+   */
+  static void add_resume(grpc::ClientContext&, const std::uint64_t file_size);
+  static void set_committed_offset(grpc::ServerContextBase* context, const std::uint64_t offset);
+
+  static chord::fs::Replication replication_from(const grpc::ServerContextBase*);
+  static std::optional<chord::uuid> file_hash_from(const grpc::ServerContextBase*);
+  static chord::uri uri_from(const grpc::ServerContextBase*);
+  static std::optional<chord::uuid> src_from(const grpc::ServerContextBase*);
   static bool file_hash_equal_from(const grpc::ClientContext&);
-  static bool rebalance_from(const grpc::ServerContext*);
+  static bool rebalance_from(const grpc::ServerContextBase*);
+  static std::optional<chord::uuid> delta_base_from(const grpc::ServerContextBase*);
+  static std::optional<std::uint64_t> file_size_from(const grpc::ServerContextBase*);
+  static bool delta_accepted_from(const grpc::ClientContext&);
+  static std::optional<std::uint64_t> resume_from(const grpc::ServerContextBase*);
+  static std::optional<std::uint64_t> committed_offset_from(const grpc::ClientContext&);
+
+ private:
+  /**
+   * prefers the binary key, falls back to the decimal (legacy) key
+   */
+  static std::optional<chord::uuid> uuid_from(const grpc::ServerContextBase*, const char* bin_key, const char* legacy_key);
 };
 
 }
@@ -7,6 +7,7 @@
 
 #include "chord.fs.monitor.h"
 #include "chord.fs.replication.h"
+#include "chord.fs.callback.service.h"
 #include "chord.fs.client.h"
 #include "chord.fs.service.h"
 #include "chord.i.fs.facade.h"
@@ -46,6 +47,7 @@ public:
   std::unique_ptr<chord::fs::monitor> monitor;
   std::unique_ptr<Client> fs_client;
   std::unique_ptr<Service> fs_service;
+  std::unique_ptr<CallbackService> fs_callback_service;
   std::shared_ptr<spdlog::logger> logger;
 
  private:
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "chord.fs.metadata.h"
+#include "chord.uri.h"
+
+namespace chord {
+namespace fs {
+
+/**
+ * mutations of (possibly) several directories which are applied
+ * atomically by IMetadataManager::apply.
+ */
+class MetadataBatch {
+ public:
+  enum class Action {
+    ADD,
+    DEL,
+    DEL_DIRECTORY
+  };
+
+  struct Mutation {
+    Action action;
+    chord::uri directory;
+    std::set<Metadata> metadata;
+  };
+
+ private:
+  std::vector<Mutation> _mutations;
+
+ public:
+  MetadataBatch& add(const chord::uri& directory, const std::set<Metadata>& metadata) {
+    _mutations.push_back({Action::ADD, directory, metadata});
+    return *this;
+  }
+
+  MetadataBatch& del(const chord::uri& directory, const std::set<Metadata>& metadata) {
+    _mutations.push_back({Action::DEL, directory, metadata});
+    return *this;
+  }
+
+  MetadataBatch& del(const chord::uri& directory) {
+    _mutations.push_back({Action::DEL_DIRECTORY, directory, {}});
+    return *this;
+  }
+
+  const std::vector<Mutation>& mutations() const { return _mutations; }
+  bool empty() const { return _mutations.empty(); }
+  std::size_t size() const { return _mutations.size(); }
+};
+
+}  // namespace fs
+}  // namespace chord
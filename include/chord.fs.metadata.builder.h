@@ -91,6 +91,12 @@ struct MetadataBuilder {
     return meta;
   }
 
+  static std::optional<chord::uuid> file_hash_of(const chord::fs::Data& item) {
+    if(!item.file_hash_bin().empty()) return chord::uuid::from_bytes(item.file_hash_bin());
+    if(!item.file_hash().empty()) return chord::uuid{item.file_hash()};
+    return {};
+  }
+
   /**
    * @todo implement owner / group
    */
@@ -104,7 +110,7 @@ struct MetadataBuilder {
                   static_cast<perms>(item.permissions()),
                   static_cast<type>(item.type()), 
                   item.size(),
-                  !item.file_hash().empty() ? std::optional<chord::uuid>{item.file_hash()} : std::optional<chord::uuid>{},
+                  file_hash_of(item),
                   item.has_node_ref() ? chord::common::make_node(item.node_ref()) : std::optional<chord::node>{},
                   repl};
 
@@ -126,7 +132,7 @@ struct MetadataBuilder {
 
   static std::optional<chord::node> make_node(const chord::fs::MetaResponse& res) {
     if(res.has_node_ref())
-      return {{res.node_ref().uuid(), res.node_ref().endpoint()}};
+      return chord::common::make_node(res.node_ref());
     return {};
   }
 
@@ -149,11 +155,11 @@ struct MetadataBuilder {
     return ret;
   }
 
-  static void addMetadata(const std::set<Metadata>& metadata, chord::fs::MetaResponse* response) {
-    MetadataBuilder::addMetadata(metadata, *response);
+  static void addMetadata(const std::set<Metadata>& metadata, chord::fs::MetaResponse* response, const bool legacy_uuids = true) {
+    MetadataBuilder::addMetadata(metadata, *response, legacy_uuids);
   }
 
-  static void addMetadata(const std::set<Metadata>& metadata, chord::fs::MetaResponse& response) {
+  static void addMetadata(const std::set<Metadata>& metadata, chord::fs::MetaResponse& response, const bool legacy_uuids = true) {
     for (const auto& m : metadata) {
       chord::fs::Data* data = response.add_metadata();
       data->set_filename(m.name);
@@ -161,7 +167,8 @@ struct MetadataBuilder {
       data->set_size(m.file_size);
       data->set_permissions(value_of(m.permissions));
       if(m.file_hash) {
-        data->set_file_hash(m.file_hash.value().string());
+        data->set_file_hash_bin(m.file_hash->bytes());
+        if(legacy_uuids) data->set_file_hash(m.file_hash->string());
       }
       if(m.replication) {
         const auto repl = m.replication;
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "chord.fs.metadata.h"
+#include "chord.lru.cache.h"
+
+namespace chord {
+namespace fs {
+
+/**
+ * size-bounded cache of decoded directories (path -> metadata)
+ *
+ * the cache is split into shards by the hash of the path, each shard
+ * being a LRUCache of its own, to reduce the lock contention.
+ *
+ * entries read from the store are only put if the path has not been
+ * invalidated in the meantime (see generation), i.e. writers must
+ * invalidate after writing to the store.
+ */
+class MetadataCache {
+ public:
+  using value_t = std::shared_ptr<const std::set<Metadata>>;
+
+  static constexpr std::size_t SHARDS = 16;
+
+ private:
+  struct Shard {
+    explicit Shard(const std::size_t capacity) : cache{capacity} {}
+
+    std::mutex mtx;
+    std::uint64_t generation{0};
+    LRUCache<std::string, value_t> cache;
+  };
+
+  const std::size_t _capacity;
+  std::vector<std::unique_ptr<Shard>> shards;
+
+  std::atomic<std::uint64_t> _hits{0};
+  std::atomic<std::uint64_t> _misses{0};
+
+  Shard& shard(const std::string& path) {
+    return *shards[std::hash<std::string>{}(path) % shards.size()];
+  }
+
+ public:
+  explicit MetadataCache(const std::size_t capacity) : _capacity{capacity} {
+    // round up to not end up with zero-sized shards
+    const auto shard_capacity = (capacity + SHARDS - 1) / SHARDS;
+    for(std::size_t i = 0; i < SHARDS; ++i) {
+      shards.push_back(std::make_unique<Shard>(shard_capacity));
+    }
+  }
+
+  MetadataCache(const MetadataCache&) = delete;
+
+  bool enabled() const { return _capacity > 0; }
+  std::size_t capacity() const { return _capacity; }
+
+  std::size_t size() const {
+    std::size_t ret = 0;
+    for(const auto& s : shards) ret += s->cache.size();
+    return ret;
+  }
+
+  std::uint64_t hits() const { return _hits; }
+  std::uint64_t misses() const { return _misses; }
+
+  std::optional<value_t> get(const std::string& path) {
+    auto ret = shard(path).cache.find(path);
+    ++(ret ? _hits : _misses);
+    return ret;
+  }
+
+  /**
+   * generation of the path to be passed to put
+   */
+  std::uint64_t generation(const std::string& path) {
+    auto& s = shard(path);
+    std::lock_guard<std::mutex> lck(s.mtx);
+    return s.generation;
+  }
+
+  /**
+   * put the value unless the path has been invalidated since generation
+   */
+  bool put(const std::string& path, value_t value, const std::uint64_t generation) {
+    auto& s = shard(path);
+    std::lock_guard<std::mutex> lck(s.mtx);
+    if(s.generation != generation) return false;
+    s.cache.put(path, std::move(value));
+    return true;
+  }
+
+  void invalidate(const std::string& path) {
+    auto& s = shard(path);
+    std::lock_guard<std::mutex> lck(s.mtx);
+    ++s.generation;
+    s.cache.erase(path);
+  }
+
+  void clear() {
+    for(auto& s : shards) {
+      std::lock_guard<std::mutex> lck(s->mtx);
+      ++s->generation;
+      s->cache.clear();
+    }
+  }
+};
+
+}  // namespace fs
+}  // namespace chord
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "chord.fs.chunk.manifest.h"
+#include "chord.fs.chunk.recipe.h"
+#include "chord.fs.metadata.h"
+
+namespace chord {
+namespace fs {
+
+/**
+ * Binary encoding of the metadata of a directory.
+ *
+ * layout (version 1):
+ *   magic (1 byte) | version (1 byte) | varint count | metadata*
+ *
+ * metadata:
+ *   varint name | varint owner | varint group | varint permissions
+ *   | varint type | varint file_size | flags (1 byte)
+ *   | [file_hash (32 byte)] | [node_ref uuid (32 byte) | varint endpoint]
+ *   | varint replication.index | varint replication.count
+ *
+ * strings are prefixed by their varint-encoded size, uuids are
+ * stored as fixed-width big-endian 32 byte values.
+ */
+struct MetadataCodec {
+  static constexpr std::uint8_t MAGIC = 0xCF;
+  static constexpr std::uint8_t VERSION = 1;
+
+  static std::string encode(const std::map<std::string, Metadata>&);
+  static void encode(const Metadata&, std::string&);
+
+  /**
+   * single directory entry: magic (1 byte) | version (1 byte) | metadata
+   */
+  static std::string encode_entry(const Metadata&);
+  static Metadata decode_entry(std::string_view);
+
+  /**
+   * decode binary or legacy (boost text archive) records
+   */
+  static std::map<std::string, Metadata> decode(std::string_view);
+
+  /**
+   * true if the record was written by the boost text archive
+   */
+  static bool is_legacy(std::string_view);
+
+  static std::map<std::string, Metadata> decode_legacy(std::string_view);
+
+  /**
+   * chunk manifest of a file:
+   *   magic (1 byte) | version (1 byte) | file_hash (32 byte)
+   *   | varint chunk_size | varint file_size | varint count | chunk hash (32 byte)*
+   */
+  static std::string encode_chunks(const ChunkManifest&);
+  static ChunkManifest decode_chunks(std::string_view);
+
+  /**
+   * chunk recipe of a file (chunk store):
+   *   magic (1 byte) | version (1 byte) | file_hash (32 byte)
+   *   | varint file_size | varint count | (chunk hash (32 byte) | varint size)*
+   */
+  static std::string encode_recipe(const ChunkRecipe&);
+  static ChunkRecipe decode_recipe(std::string_view);
+};
+
+}  // namespace fs
+}  // namespace chord
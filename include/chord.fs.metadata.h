@@ -155,7 +155,10 @@ namespace serialization {
 template<class Archive>
 void serialize(Archive & ar, chord::uuid &uuid, [[maybe_unused]] const unsigned int version)
 {
-  ar & uuid.value();
+  // keep the (legacy) boost representation within the archives
+  auto value = uuid.value();
+  ar & value;
+  uuid = chord::uuid{value};
 }
 
 template<class Archive>
@@ -1,14 +1,31 @@
 #pragma once
 
 // metadata strategy: rocksdb
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+#include <rocksdb/write_batch.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
 #include <set>
 #include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "chord.context.h"
 #include "chord.crypto.h"
+#include "chord.fs.metadata.batch.h"
 #include "chord.fs.metadata.builder.h"
+#include "chord.fs.metadata.cache.h"
+#include "chord.fs.metadata.codec.h"
 #include "chord.fs.metadata.h"
+#include "chord.fs.metadata.merge.operator.h"
+#include "chord.fs.metadata.prefix.h"
 #include "chord.i.fs.metadata.manager.h"
 #include "chord.uri.h"
 #include "chord.utils.h"
@@ -20,9 +37,53 @@ namespace fs {
 class MetadataManager : public IMetadataManager {
   static constexpr auto logger_name = "chord.fs.metadata.manager";
 
+  /**
+   * primary key space: path + '\0' + name -> metadata
+   *
+   * every entry of a directory is stored as its own key, i.e.
+   * adding or removing an entry is a point write and a directory
+   * is listed by iterating the prefix path + '\0'.
+   */
+  static constexpr char key_separator = '\0';
+
+  static inline const EmptyEntryCompactionFilter empty_entry_filter{};
+
+  /**
+   * secondary key space: sha256(uri) (32 byte, big-endian) + path -> ''
+   *
+   * enables range scans on the ring (see get(from, to)) without
+   * re-hashing every key of the default column family.
+   */
+  static constexpr auto uri_hash_column_family = "uri.hash";
+
+  /**
+   * chunk key space: path -> chunk manifest (see MetadataCodec)
+   *
+   * kept apart from the entries to not decode the manifests of
+   * large files when listing their directory.
+   */
+  static constexpr auto chunks_column_family = "chunks";
+
+  /**
+   * chunk store key spaces (see ChunkStore):
+   *   recipes: path -> chunk recipe (see MetadataCodec)
+   *   refs:    chunk hash (32 byte, big-endian) -> reference count (8 byte, big-endian)
+   */
+  static constexpr auto recipes_column_family = "recipes";
+  static constexpr auto refs_column_family = "refs";
+
  private:
   Context &context;
   std::unique_ptr<rocksdb::DB> db;
+  rocksdb::ColumnFamilyHandle* default_cf{nullptr};
+  rocksdb::ColumnFamilyHandle* uri_hash_cf{nullptr};
+  rocksdb::ColumnFamilyHandle* chunks_cf{nullptr};
+  rocksdb::ColumnFamilyHandle* recipes_cf{nullptr};
+  rocksdb::ColumnFamilyHandle* refs_cf{nullptr};
+  rocksdb::WriteOptions write_options;
+  // reference counts are read, modified and written
+  std::mutex refs_mtx;
+  MetadataCache cache;
   std::shared_ptr<spdlog::logger> logger;
 
 
@@ -32,52 +93,377 @@ class MetadataManager : public IMetadataManager {
     throw__exception(status.ToString());
   }
 
-  std::map<std::string, Metadata> deserialize(const std::string& metadata) {
-    std::map<std::string, Metadata> ret;
+  static std::string entry_prefix(const std::string& path) {
+    return path + key_separator;
+  }
 
-    if(metadata.empty()) return ret;
+  static std::string entry_key(const std::string& path, const std::string& name) {
+    return entry_prefix(path) + name;
+  }
+
+  /**
+   * first key after all entries of path
+   */
+  static std::string entry_prefix_end(const std::string& path) {
+    return path + static_cast<char>(key_separator + 1);
+  }
+
+  static bool is_entry_key(const rocksdb::Slice& key) {
+    return key.ToStringView().find(key_separator) != std::string_view::npos;
+  }
+
+  static std::string path_of_entry(const rocksdb::Slice& key) {
+    const auto view = key.ToStringView();
+    return std::string{view.substr(0, view.find(key_separator))};
+  }
 
-    std::stringstream ss{metadata};
-    boost::archive::text_iarchive ia{ss};
-    ia >> ret;
+  /**
+   * read options for scans across directories (see DirectoryPrefixTransform)
+   */
+  static rocksdb::ReadOptions total_order() {
+    rocksdb::ReadOptions options;
+    options.total_order_seek = true;
+    return options;
+  }
+
+  static Metadata deserialize(const rocksdb::Slice& value) {
+    return MetadataCodec::decode_entry(value.ToStringView());
+  }
+
+  static std::string serialize(const Metadata& metadata) {
+    return MetadataCodec::encode_entry(metadata);
+  }
+
+  static std::string uri_hash_key(const std::string& path) {
+    return chord::crypto::sha256(chord::utils::as_uri(path)).bytes() + path;
+  }
+
+  static std::string encode_refs(const std::uint64_t refs) {
+    std::string ret(sizeof(refs), '\0');
+    for(std::size_t i = 0; i < ret.size(); ++i) {
+      ret[ret.size() - 1 - i] = static_cast<char>((refs >> (8 * i)) & 0xFF);
+    }
     return ret;
   }
 
-  std::string serialize(const std::map<std::string, Metadata>& metadata) {
-    std::stringstream ss;
-    boost::archive::text_oarchive oa{ss};
-    oa << metadata;
-    return ss.str();
+  static std::uint64_t decode_refs(const std::string_view value) {
+    std::uint64_t refs = 0;
+    for(const auto byte : value) {
+      refs = (refs << 8) | static_cast<unsigned char>(byte);
+    }
+    return refs;
   }
 
-  void initialize() {
-    rocksdb::DB *db_tmp;
+  static std::string path_of(const rocksdb::Slice& uri_hash_key) {
+    return uri_hash_key.ToString().substr(uuid::UUID_BYTES);
+  }
+
+  bool has_uri_hash_column_family(const rocksdb::Options& options) const {
+    std::vector<std::string> column_families;
+    // fails if the database does not exist yet
+    if(!rocksdb::DB::ListColumnFamilies(options, context.meta_directory, &column_families).ok()) {
+      return false;
+    }
+    return std::find(column_families.begin(), column_families.end(), uri_hash_column_family) != column_families.end();
+  }
+
+  /**
+   * directories written before the per-entry layout are stored as
+   * a single record keyed by their path; the root always exists.
+   */
+  bool has_directory_records() {
+    std::string value;
+    return db->Get(rocksdb::ReadOptions(), "/", &value).ok();
+  }
+
+  /**
+   * migrate metadata directories stored as one (binary or boost
+   * text archive) record per directory to one key per entry.
+   */
+  void split_directory_records() {
+    logger->info("[initialize] splitting directory records for {}", context.meta_directory);
+    rocksdb::WriteBatch batch;
+    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(total_order())};
+    for(it->SeekToFirst(); it->Valid(); it->Next()) {
+      if(is_entry_key(it->key())) continue;
+
+      const auto path = it->key().ToString();
+      for(const auto& [name, meta] : MetadataCodec::decode(it->value().ToStringView())) {
+        check_status(batch.Put(entry_key(path, name), serialize(meta)));
+      }
+      check_status(batch.Delete(path));
+    }
+    check_status(it->status());
+    check_status(db->Write(write_options, &batch));
+  }
+
+  /**
+   * migrate metadata directories created before the uri hash
+   * index existed by (re-)building the index from the default
+   * column family.
+   */
+  void build_uri_hash_index() {
+    logger->info("[initialize] building uri hash index for {}", context.meta_directory);
+    rocksdb::WriteBatch batch;
+    std::string last;
+    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(total_order())};
+    for(it->SeekToFirst(); it->Valid(); it->Next()) {
+      auto path = path_of_entry(it->key());
+      if(path == last || it->value().empty()) continue;
+      check_status(batch.Put(uri_hash_cf, uri_hash_key(path), ""));
+      last = std::move(path);
+    }
+    check_status(it->status());
+    check_status(db->Write(write_options, &batch));
+  }
+
+  static rocksdb::CompressionType compression_of(const std::string& compression) {
+    if(compression == "none") return rocksdb::kNoCompression;
+    if(compression == "snappy") return rocksdb::kSnappyCompression;
+    if(compression == "zlib") return rocksdb::kZlibCompression;
+    if(compression == "lz4") return rocksdb::kLZ4Compression;
+    if(compression == "zstd") return rocksdb::kZSTD;
+    throw__exception("unknown meta compression: " + compression);
+  }
+
+  /**
+   * rocksdb options as configured by the context (meta-*)
+   */
+  rocksdb::Options make_options() const {
     rocksdb::Options options;
     options.create_if_missing = true;
+    options.create_missing_column_families = true;
+    options.max_background_jobs = context.meta_background_jobs;
+    options.write_buffer_size = context.meta_write_buffer_mb << 20;
+    options.compression = compression_of(context.meta_compression);
+
+    rocksdb::BlockBasedTableOptions table_options;
+    if(context.meta_block_cache_mb > 0) {
+      table_options.block_cache = rocksdb::NewLRUCache(context.meta_block_cache_mb << 20);
+    } else {
+      table_options.no_block_cache = true;
+    }
+    if(context.meta_bloom_bits_per_key > 0) {
+      table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(static_cast<double>(context.meta_bloom_bits_per_key)));
+    }
+    // shared by all column families (incl. the block cache)
+    options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+    return options;
+  }
 
-    check_status(rocksdb::DB::Open(options, context.meta_directory, &db_tmp));
+  void initialize() {
+    const auto options = make_options();
+    write_options.disableWAL = context.meta_disable_wal;
+
+    const bool migrate = !has_uri_hash_column_family(options);
+
+    rocksdb::ColumnFamilyOptions entry_options{options};
+    entry_options.merge_operator = std::make_shared<DirectoryEntryMergeOperator>();
+    entry_options.compaction_filter = &empty_entry_filter;
+    entry_options.prefix_extractor = std::make_shared<DirectoryPrefixTransform>();
+
+    std::vector<rocksdb::ColumnFamilyDescriptor> column_families {
+      {rocksdb::kDefaultColumnFamilyName, entry_options},
+      {uri_hash_column_family, rocksdb::ColumnFamilyOptions(options)},
+      {chunks_column_family, rocksdb::ColumnFamilyOptions(options)},
+      {recipes_column_family, rocksdb::ColumnFamilyOptions(options)},
+      {refs_column_family, rocksdb::ColumnFamilyOptions(options)}
+    };
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+
+    rocksdb::DB *db_tmp;
+    check_status(rocksdb::DB::Open(options, context.meta_directory, column_families, &handles, &db_tmp));
     db.reset(db_tmp);
+    default_cf = handles[0];
+    uri_hash_cf = handles[1];
+    chunks_cf = handles[2];
+    recipes_cf = handles[3];
+    refs_cf = handles[4];
+
+    if(has_directory_records()) split_directory_records();
+    if(migrate) build_uri_hash_index();
 
     // make root
     __add(chord::utils::as_uri("/"), {{".", "", "", perms::all, type::directory}});
   }
 
+  bool has_entry(const std::string& path, const std::string& name) {
+    std::string value;
+    const auto status = db->Get(rocksdb::ReadOptions(), entry_key(path, name), &value);
+    if(status.IsNotFound()) return false;
+    check_status(status);
+    // absent (see DirectoryEntryMergeOperator)
+    return !value.empty();
+  }
+
+  /**
+   * visit the entries of path in order of their names until
+   * the visitor returns false
+   */
+  template<typename Visitor>
+  void visit(const std::string& path, Visitor&& visitor) {
+    const auto prefix = entry_prefix(path);
+    rocksdb::ReadOptions options;
+    options.prefix_same_as_start = true;
+    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(options)};
+    for(it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+      if(it->value().empty()) continue;
+      if(!visitor(deserialize(it->value()))) break;
+    }
+    check_status(it->status());
+  }
+
+  /**
+   * visit all entries of all directories as (path, metadata)
+   */
+  template<typename Visitor>
+  void visit_all(Visitor&& visitor) {
+    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(total_order())};
+    for(it->SeekToFirst(); it->Valid(); it->Next()) {
+      if(it->value().empty()) continue;
+      visitor(path_of_entry(it->key()), deserialize(it->value()));
+    }
+    check_status(it->status());
+  }
+
+  std::map<std::string, Metadata> list(const std::string& path) {
+    std::map<std::string, Metadata> ret;
+    visit(path, [&](Metadata meta) {
+      auto name = meta.name;
+      ret.emplace_hint(ret.end(), std::move(name), std::move(meta));
+      return true;
+    });
+    return ret;
+  }
+
+  /**
+   * entries of the directory, served from the cache if possible
+   */
+  MetadataCache::value_t lookup(const std::string& path) {
+    if(!cache.enabled()) {
+      return std::make_shared<const std::set<Metadata>>(extract_metadata_set(list(path)));
+    }
+    if(auto cached = cache.get(path)) return *cached;
+
+    const auto generation = cache.generation(path);
+    auto ret = std::make_shared<const std::set<Metadata>>(extract_metadata_set(list(path)));
+    cache.put(path, ret, generation);
+    return ret;
+  }
+
+  bool has_entries(const std::string& path) {
+    bool ret = false;
+    visit(path, [&](const Metadata&) {
+      ret = true;
+      return false;
+    });
+    return ret;
+  }
+
+  void stage_del(rocksdb::WriteBatch& batch, const std::string& path) {
+    check_status(batch.DeleteRange(default_cf, entry_prefix(path), entry_prefix_end(path)));
+    check_status(batch.Delete(uri_hash_cf, uri_hash_key(path)));
+    check_status(batch.Delete(chunks_cf, path));
+  }
+
+  void stage_del(rocksdb::WriteBatch& batch, const std::string& path, const std::set<Metadata>& metadata) {
+    for(const auto& m:metadata) {
+      check_status(batch.Delete(entry_key(path, m.name)));
+    }
+  }
+
+  /**
+   * the path is a directory, i.e. its "." entry is stored - the entry of
+   * a file is stored at the path of the file and has no "." and ".." to
+   * update (see is_mkdir)
+   */
+  bool is_directory(const std::string& path) {
+    return has_entry(path, ".");
+  }
+
+  /**
+   * @param directory the path is a directory - "." and ".." follow the
+   *        replication of the added entries
+   */
+  void stage_add(rocksdb::WriteBatch& batch, const std::string& path, const std::set<Metadata>& metadata, const bool directory) {
+    bool is_dir = false;
+    for (const auto& m : metadata) {
+      is_dir |= m.name == ".";
+      check_status(batch.Put(entry_key(path, m.name), serialize(m)));
+    }
+
+    // always override "." since replication might have changed
+    // do not allow overrides from clients
+    const auto dot = serialize(create_directory(metadata, "."));
+    const auto dotdot = serialize(create_directory(metadata, ".."));
+    if(is_dir) {
+      check_status(batch.Put(entry_key(path, "."), dot));
+      check_status(batch.Put(entry_key(path, ".."), dotdot));
+    } else if(directory) {
+      check_status(batch.Merge(entry_key(path, "."), dot));
+      check_status(batch.Merge(entry_key(path, ".."), dotdot));
+    }
+
+    check_status(batch.Put(uri_hash_cf, uri_hash_key(path), ""));
+  }
+
+  void write(rocksdb::WriteBatch& batch) {
+    check_status(db->Write(write_options, &batch));
+  }
+
+  /**
+   * write the batch and invalidate the cached directories
+   */
+  template<typename Paths>
+  void write(rocksdb::WriteBatch& batch, const Paths& paths) {
+    write(batch);
+    for(const auto& path : paths) cache.invalidate(path);
+  }
+
   void __del(const chord::uri& uri) {
     logger->trace("[DEL] uri {}", uri);
-    check_status(db->Delete(rocksdb::WriteOptions(), uri.path().canonical().string()));
+    const auto path = uri.path().canonical().string();
+    rocksdb::WriteBatch batch;
+    stage_del(batch, path);
+    write(batch, std::array{path});
+  }
+
+  /**
+   * collect all directories with hash in [from, to) of the uri hash index
+   */
+  void collect(const std::string& from, const std::optional<std::string>& to, uri_meta_map_desc& ret) {
+    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(rocksdb::ReadOptions(), uri_hash_cf)};
+    for(it->Seek(from); it->Valid(); it->Next()) {
+      const auto key = it->key();
+      if(to && key.compare(*to) >= 0) break;
+
+      const auto path = path_of(key);
+      const auto map = list(path);
+      if(map.empty()) {
+        logger->warn("[GET] stale uri hash index entry for {}", path);
+        continue;
+      }
+      ret[chord::utils::as_uri(path)] = extract_metadata_set(map);
+    }
+    check_status(it->status());
   }
 
  public:
   explicit MetadataManager(Context &context)
     : context{context},
+      cache{context.meta_cache_size},
       logger{context.logging.factory().get_or_create(logger_name)}
       { initialize(); }
 
   MetadataManager(const MetadataManager&) = delete;
   
   ~MetadataManager() {
-    logger->debug("[~] closing metadata database.");
-    if(db) db->Close();
+    logger->debug("[~] closing metadata database (cache hits: {}, misses: {}).", cache.hits(), cache.misses());
+    if(!db) return;
+    for(auto* handle : {default_cf, uri_hash_cf, chunks_cf, recipes_cf, refs_cf}) {
+      if(handle) db->DestroyColumnFamilyHandle(handle);
+    }
+    db->Close();
   }
 
   std::set<Metadata> del(const chord::uri& directory) override {
@@ -90,9 +476,8 @@ class MetadataManager : public IMetadataManager {
   }
 
   std::set<Metadata> del(const chord::uri& directory, const std::set<Metadata> &metadata, const bool removeIfEmpty) override {
-    std::string value;
     const auto path = directory.path().canonical().string();
-    check_status(db->Get(rocksdb::ReadOptions(), path, &value));
+    if(!has_entries(path)) check_status(rocksdb::Status::NotFound());
 
     logger->trace("[DEL] {}", directory);
     for(const auto& meta:metadata) {
@@ -100,75 +485,67 @@ class MetadataManager : public IMetadataManager {
     }
 
     std::set<Metadata> retVal;
-
-    //map['path'] = metadata
-    auto current = deserialize(value);
+    std::set<std::string> names;
+    rocksdb::WriteBatch batch;
     for(const auto &m:metadata) {
-      retVal.insert(current[m.name]);
-      current.erase(m.name);
+      std::string value;
+      const auto key = entry_key(path, m.name);
+      const auto status = db->Get(rocksdb::ReadOptions(), key, &value);
+      if(status.IsNotFound()) continue;
+      check_status(status);
+      if(value.empty()) continue;
+
+      retVal.insert(deserialize(value));
+      names.insert(m.name);
+      check_status(batch.Delete(key));
     }
 
-    if(is_empty(extract_metadata_set(current)) && removeIfEmpty) {
-      __del(directory);
-    } else {
-      value = serialize(current);
-      check_status(db->Put(rocksdb::WriteOptions(), path, value));
+    if(removeIfEmpty) {
+      // empty directories contain . and .. only
+      std::set<Metadata> remaining;
+      visit(path, [&](Metadata meta) {
+        if(!names.contains(meta.name)) remaining.insert(std::move(meta));
+        return remaining.size() <= 2;
+      });
+      if(is_empty(remaining)) {
+        __del(directory);
+        return retVal;
+      }
     }
 
+    write(batch, std::array{path});
     return retVal;
   }
 
   std::set<Metadata> dir(const chord::uri& directory) override {
-    std::string value;
-    const auto status = db->Get(rocksdb::ReadOptions(), directory.path().canonical().string(), &value);
+    const auto current = lookup(directory.path().canonical().string());
 
-    if(status.ok()) {
+    if(!current->empty()) {
       logger->trace("[DIR] {}", directory);
-      const auto current = deserialize(value);
-      std::set<Metadata> ret;
-      for(const auto &m:current) {
-        ret.insert(m.second);
-        logger->trace("[DIR] `-  {}", m.second);
+      for(const auto &m:*current) {
+        logger->trace("[DIR] `-  {}", m);
       }
-      return ret;
+      return *current;
     }
 
-    throw__exception(std::string{"failed to dir: "} + status.ToString());
+    throw__exception(std::string{"failed to dir: "} + rocksdb::Status::NotFound().ToString());
   }
 
   bool __add(const chord::uri& directory, const std::set<Metadata>& metadata) {
-    std::string value;
     const auto path = directory.path().canonical().string();
-    const auto status = db->Get(rocksdb::ReadOptions(), path, &value);
 
-    if(!status.ok() && !status.IsNotFound()){
-      check_status(status);
-    }
-
-    std::map<std::string, Metadata> current = deserialize(value);
+    logger->trace("[ADD] {}", directory);
 
     bool added = false;
     for (const auto& m : metadata) {
       // TODO check whether m already exists && equals 
-      const auto [_, status] = current.insert_or_assign(m.name, m);
-      added |= status;
-    }
-
-    // always override "." since replication might have changed
-    // do not allow overrides from clients
-    if(current.find(".") != current.end()) {
-      current.insert_or_assign(".", create_directory(metadata, "."));
-      current.insert_or_assign("..", create_directory(metadata, ".."));
+      added |= !has_entry(path, m.name);
+      logger->trace("[ADD] `-  {}", m);
     }
 
-    logger->trace("[ADD] {}", directory);
-    for (const auto& [path, meta]: current) {
-      logger->trace("[ADD] `-  {}", meta);
-    }
-
-    value = serialize(current);
-
-    check_status(db->Put(rocksdb::WriteOptions(), path, value));
+    rocksdb::WriteBatch batch;
+    stage_add(batch, path, metadata, is_directory(path));
+    write(batch, std::array{path});
 
     return added;
   }
@@ -177,45 +554,67 @@ class MetadataManager : public IMetadataManager {
     return __add(directory, metadata);
   }
 
+  /**
+   * apply all mutations in a single write batch - in contrast to
+   * add/del no current state is read (but whether a path is a directory).
+   */
+  void apply(const MetadataBatch& metadata_batch) override {
+    rocksdb::WriteBatch batch;
+    std::set<std::string> paths;
+    // directories created by the batch
+    std::set<std::string> directories;
+    for(const auto& [action, directory, metadata] : metadata_batch.mutations()) {
+      const auto& path = *paths.insert(directory.path().canonical().string()).first;
+      logger->trace("[APPLY] {}", directory);
+      switch(action) {
+        case MetadataBatch::Action::ADD:
+          stage_add(batch, path, metadata, directories.count(path) || is_directory(path));
+          if(std::any_of(metadata.begin(), metadata.end(), [](const Metadata& m) { return m.name == "."; })) directories.insert(path);
+          break;
+        case MetadataBatch::Action::DEL:
+          stage_del(batch, path, metadata);
+          break;
+        case MetadataBatch::Action::DEL_DIRECTORY:
+          //never remove the root
+          if(!directory.path().parent_path().empty()) stage_del(batch, path);
+          break;
+      }
+    }
+    write(batch, paths);
+  }
+
   uri_meta_map_desc get_all() override {
     // needed to first delete the file, then the directory
     uri_meta_map_desc ret;
-    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(rocksdb::ReadOptions())};
-    for(it->SeekToFirst(); it->Valid(); it->Next()) {
-      const std::string& _path = it->key().ToString();
-
-      const auto uri = chord::utils::as_uri(_path);
-      const auto map = deserialize(it->value().ToString());
-      ret[uri] = extract_metadata_set(map);
-    }
+    visit_all([&](const std::string& path, Metadata meta) {
+      ret[chord::utils::as_uri(path)].insert(std::move(meta));
+    });
     return ret;
   }
 
   /**
    * @brief Get all metadata in range (from...to)
    *
+   * Uses the uri hash index, i.e. the interval on the ring
+   * results in (at most) two bounded seeks.
+   *
    * @param from uuid (exclusive)
    * @param to uuid (exclusive)
-   * @todo re-hashing with full-table scan is slow
-   *   1) use an 'index' or
-   *   2) save hash to Metadata (deserialization needed)
    */
   uri_meta_map_desc get(const chord::uuid& from, const chord::uuid& to) override {
     uri_meta_map_desc ret;
-    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(rocksdb::ReadOptions())};
-    for(it->SeekToFirst(); it->Valid(); it->Next()) {
-      const std::string& _path = it->key().ToString();
+    // (from, to) is exclusive - skip all keys prefixed by from
+    const auto lower = (from + 1).bytes();
+    const auto upper = to.bytes();
 
-      const auto uri = chord::utils::as_uri(_path);
-      const auto hash = chord::crypto::sha256(uri);
-
-      if(uuid::between(from, hash, to)) {
-        const auto map = deserialize(it->value().ToString());
-        //TODO refactor this, either always save uri
-        //     or save scheme in metadata
-        ret[uri] = extract_metadata_set(map);
-      }
+    if(from < to) {
+      collect(lower, upper, ret);
+    } else {
+      // wrap around: (from, max] + [0, to)
+      if(from != uuid::max()) collect(lower, {}, ret);
+      collect(uuid{0}.bytes(), upper, ret);
     }
+
     for(const auto& o : ret) {
       logger->trace("[GET] {}", o.first);
       for(const auto &m : o.second) {
@@ -236,52 +635,108 @@ class MetadataManager : public IMetadataManager {
   //TODO 
   IMetadataManager::uri_meta_map_desc get_shallow_copies(const chord::node& node) override {
     IMetadataManager::uri_meta_map_desc ret;
-    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(rocksdb::ReadOptions())};
-
-    for(it->SeekToFirst(); it->Valid(); it->Next()) {
-      const std::string& path = it->key().ToString();
-      const auto map = deserialize(it->value().ToString());
-      const auto uri = chord::utils::as_uri(path);
-      for(const auto& [_, meta] : map) {
-        if(meta.node_ref && meta.node_ref == node) {
-          ret[uri].insert(meta);
-        }
+    visit_all([&](const std::string& path, Metadata meta) {
+      if(meta.node_ref && meta.node_ref == node) {
+        ret[chord::utils::as_uri(path)].insert(std::move(meta));
       }
-    }
+    });
     return ret;
   }
 
   IMetadataManager::uri_meta_map_desc get_replicated(const std::uint32_t min_idx) override {
     IMetadataManager::uri_meta_map_desc ret;
-    std::unique_ptr<rocksdb::Iterator> it{db->NewIterator(rocksdb::ReadOptions())};
-
-    for(it->SeekToFirst(); it->Valid(); it->Next()) {
-      const std::string& path = it->key().ToString();
-      const auto map = deserialize(it->value().ToString());
-      const auto uri = chord::utils::as_uri(path);
-      for(const auto& [_, meta] : map) {
-        if(meta.file_type != type::directory && meta.replication.count > 1 && meta.replication.index >= min_idx) {
-          ret[uri].insert(meta);
-        }
+    visit_all([&](const std::string& path, Metadata meta) {
+      if(meta.file_type != type::directory && meta.replication.count > 1 && meta.replication.index >= min_idx) {
+        ret[chord::utils::as_uri(path)].insert(std::move(meta));
       }
-    }
+    });
     return ret;
   }
 
   bool exists(const chord::uri& uri) override {
-    std::string value;
-    return db->Get(rocksdb::ReadOptions(), uri.path().string(), &value).ok();
+    if(!cache.enabled()) return has_entries(uri.path().canonical().string());
+    return !lookup(uri.path().canonical().string())->empty();
   }
 
   std::set<Metadata> get(const chord::uri& directory) override {
-    std::string value;
-    check_status(db->Get(rocksdb::ReadOptions(), directory.path().string(), &value));
+    const auto current = lookup(directory.path().canonical().string());
+    if(current->empty()) check_status(rocksdb::Status::NotFound());
 
-    const auto map = deserialize(value);
-    for (const auto& [path, meta]: map) {
+    for (const auto& meta: *current) {
       logger->trace("[GET] `-  {}", meta);
     }
-    return extract_metadata_set(map);
+    return *current;
+  }
+
+  std::optional<ChunkManifest> chunks(const chord::uri& file) override {
+    std::string value;
+    const auto status = db->Get(rocksdb::ReadOptions(), chunks_cf, file.path().canonical().string(), &value);
+    if(status.IsNotFound()) return {};
+    check_status(status);
+    return MetadataCodec::decode_chunks(value);
+  }
+
+  void chunks(const chord::uri& file, const ChunkManifest& manifest) override {
+    logger->trace("[CHUNKS] {} ({} chunks)", file, manifest.chunks.size());
+    check_status(db->Put(write_options, chunks_cf, file.path().canonical().string(), MetadataCodec::encode_chunks(manifest)));
+  }
+
+  std::optional<ChunkRecipe> recipe(const chord::uri& file) override {
+    std::string value;
+    const auto status = db->Get(rocksdb::ReadOptions(), recipes_cf, file.path().canonical().string(), &value);
+    if(status.IsNotFound()) return {};
+    check_status(status);
+    return MetadataCodec::decode_recipe(value);
+  }
+
+  std::vector<chord::uuid> recipe(const chord::uri& file, const std::optional<ChunkRecipe>& recipe) override {
+    const auto path = file.path().canonical().string();
+    logger->trace("[RECIPE] {} ({} chunks)", file, recipe ? recipe->chunks.size() : 0);
+
+    const std::lock_guard<std::mutex> lock{refs_mtx};
+    // net change of the references per chunk
+    std::map<chord::uuid, std::int64_t> delta;
+    if(const auto current = this->recipe(file)) {
+      for(const auto& chunk : current->chunks) --delta[chunk.hash];
+    }
+    if(recipe) {
+      for(const auto& chunk : recipe->chunks) ++delta[chunk.hash];
+    }
+
+    std::vector<chord::uuid> released;
+    rocksdb::WriteBatch batch;
+    for(const auto& [chunk, change] : delta) {
+      if(change == 0) continue;
+      const auto count = static_cast<std::int64_t>(refs(chunk)) + change;
+      if(count > 0) {
+        check_status(batch.Put(refs_cf, chunk.bytes(), encode_refs(static_cast<std::uint64_t>(count))));
+      } else {
+        check_status(batch.Delete(refs_cf, chunk.bytes()));
+        released.push_back(chunk);
+      }
+    }
+    if(recipe) {
+      check_status(batch.Put(recipes_cf, path, MetadataCodec::encode_recipe(*recipe)));
+    } else {
+      check_status(batch.Delete(recipes_cf, path));
+    }
+    check_status(db->Write(write_options, &batch));
+    return released;
+  }
+
+  std::uint64_t refs(const chord::uuid& chunk) override {
+    std::string value;
+    const auto status = db->Get(rocksdb::ReadOptions(), refs_cf, chunk.bytes(), &value);
+    if(status.IsNotFound()) return 0;
+    check_status(status);
+    return decode_refs(value);
+  }
+
+  /**
+   * cache of decoded directories (e.g. to inspect hits/misses)
+   */
+  const MetadataCache& directory_cache() const {
+    return cache;
   }
 
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+#include <rocksdb/compaction_filter.h>
+#include <rocksdb/merge_operator.h>
+
+namespace chord {
+namespace fs {
+
+/**
+ * merge operator of directory entries
+ *
+ * the operand replaces an existing entry, entries that do not exist
+ * are kept absent. This allows to blindly update "." and ".." without
+ * knowing whether the directory exists. Absent entries are stored as
+ * empty values which are skipped by the metadata manager and dropped
+ * by the EmptyEntryCompactionFilter.
+ */
+class DirectoryEntryMergeOperator : public rocksdb::AssociativeMergeOperator {
+ public:
+  bool Merge(const rocksdb::Slice& key, const rocksdb::Slice* existing_value,
+             const rocksdb::Slice& value, std::string* new_value,
+             rocksdb::Logger* logger) const override;
+
+  const char* Name() const override { return "chord.fs.DirectoryEntryMergeOperator"; }
+};
+
+class EmptyEntryCompactionFilter : public rocksdb::CompactionFilter {
+ public:
+  bool Filter(int level, const rocksdb::Slice& key, const rocksdb::Slice& existing_value,
+              std::string* new_value, bool* value_changed) const override;
+
+  const char* Name() const override { return "chord.fs.EmptyEntryCompactionFilter"; }
+};
+
+}  // namespace fs
+}  // namespace chord
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string_view>
+
+#include <rocksdb/slice.h>
+#include <rocksdb/slice_transform.h>
+
+namespace chord {
+namespace fs {
+
+/**
+ * prefix extractor of directory entry keys (path + '\0' + name)
+ *
+ * all entries of a directory share the prefix path + '\0', i.e.
+ * the bloom filters answer directory lookups of missing paths
+ * without reading any data block.
+ */
+class DirectoryPrefixTransform : public rocksdb::SliceTransform {
+  static constexpr char separator = '\0';
+
+ public:
+  const char* Name() const override { return "chord.fs.DirectoryPrefixTransform"; }
+
+  rocksdb::Slice Transform(const rocksdb::Slice& key) const override {
+    return {key.data(), key.ToStringView().find(separator) + 1};
+  }
+
+  bool InDomain(const rocksdb::Slice& key) const override {
+    return key.ToStringView().find(separator) != std::string_view::npos;
+  }
+};
+
+}  // namespace fs
+}  // namespace chord
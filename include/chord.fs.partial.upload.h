@@ -0,0 +1,120 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "chord.crypto.h"
+#include "chord.path.h"
+#include "chord.uri.h"
+#include "chord.uuid.h"
+
+namespace chord { struct Context; }
+namespace spdlog { class logger; }
+
+namespace chord {
+namespace fs {
+
+/**
+ * resumable put of a file
+ *
+ * the file is received into <journal>/.partial instead of the data
+ * directory. the bytes received so far and the state of the file hash
+ * are persisted along with it (.state) - an interrupted put of the same
+ * file (hash and size) continues at the committed offset instead of
+ * starting over.
+ *
+ * the state is saved every few megabytes or seconds and once the upload
+ * is closed. after a crash the upload continues at the last saved state,
+ * the data received after it is received again.
+ */
+class PartialUpload {
+ public:
+  /**
+   * uris of the uploads in progress - one upload of a uri at a time
+   */
+  class Registry {
+    std::mutex mtx;
+    std::set<chord::uri> uris;
+    friend class PartialUpload;
+  };
+
+ private:
+  static constexpr auto logger_name = "chord.fs.partial.upload";
+  static constexpr std::uint64_t save_bytes = 8*1024*1024;
+  static constexpr std::chrono::seconds save_period{2};
+
+  Registry& registry;
+  chord::uri uri;
+  chord::path data_path;
+  chord::path state_path;
+  chord::uuid file_hash;
+  std::uint64_t file_size;
+  std::uint64_t committed{0};
+  std::uint64_t saved{0};
+  std::chrono::steady_clock::time_point saved_at;
+  crypto::sha256_hasher hasher;
+  std::ofstream out;
+
+  std::shared_ptr<spdlog::logger> logger;
+
+  PartialUpload(Registry&, const Context&, const chord::uri&, const chord::uuid& file_hash, const std::uint64_t file_size);
+
+  /**
+   * continue the persisted upload - false if there is none (of the file)
+   */
+  bool restore();
+  /**
+   * persist the state of the data written so far
+   */
+  void save();
+
+ public:
+  /**
+   * start (or continue) the upload of the uri - empty while another
+   * upload of the uri is in progress (e.g. the receiver of an interrupted
+   * put has not noticed the interruption yet).
+   */
+  static std::unique_ptr<PartialUpload> open(Registry&, const Context&, const chord::uri&, const chord::uuid& file_hash, const std::uint64_t file_size);
+
+  /**
+   * remove the uploads not resumed within fs_partial_expiry_h
+   */
+  static void expire(const Context&);
+
+  PartialUpload(const PartialUpload&) = delete;
+  PartialUpload& operator=(const PartialUpload&) = delete;
+  /**
+   * saves the state of an unfinished upload
+   */
+  ~PartialUpload();
+
+  /**
+   * bytes received so far - the put continues here
+   */
+  std::uint64_t offset() const { return committed; }
+
+  bool complete() const { return committed == file_size; }
+
+  /**
+   * append the data - throws unless it starts at the committed offset
+   */
+  void write(const std::uint64_t offset, const char* data, const std::size_t len);
+
+  /**
+   * verify the hash of the received file and move it to the target -
+   * the upload is discarded if the hash does not match.
+   */
+  void finish(const chord::path& target);
+
+  /**
+   * drop the upload (and its state)
+   */
+  void discard();
+};
+
+} // namespace fs
+} // namespace chord
@@ -1,23 +1,37 @@
 #pragma once
+#include <cstdint>
 #include <functional>
+#include <iosfwd>
 #include <memory>
+#include <optional>
+#include <set>
 
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/server_context.h>
 
+#include "chord.fs.chunk.manifest.h"
+#include "chord.fs.chunk.recipe.h"
+#include "chord.fs.chunk.store.h"
+#include "chord.fs.client.h"
+#include "chord.fs.partial.upload.h"
 #include "chord.i.fs.metadata.manager.h"
 #include "chord.uri.h"
 #include "chord_fs.grpc.pb.h"
 
 namespace chord { class ChordFacade; }
 namespace chord { class ChannelPool; }
-namespace chord { namespace fs { class Client; } }
+namespace chord { namespace fs { class AssembleRequest; } }
+namespace chord { namespace fs { class CallbackService; } }
+namespace chord { namespace fs { class ChunksRequest; } }
+namespace chord { namespace fs { class ChunksResponse; } }
 namespace chord { namespace fs { class DelRequest; } }
 namespace chord { namespace fs { class DelResponse; } }
 namespace chord { namespace fs { class GetRequest; } }
 namespace chord { namespace fs { class GetResponse; } }
 namespace chord { namespace fs { class MetaRequest; } }
 namespace chord { namespace fs { class MetaResponse; } }
+namespace chord { namespace fs { class MissingRequest; } }
+namespace chord { namespace fs { class MissingResponse; } }
 namespace chord { namespace fs { class PutRequest; } }
 namespace chord { namespace fs { class PutResponse; } }
 namespace chord { namespace fs { class MovRequest; } }
@@ -35,6 +49,9 @@ using ClientFactory = std::function<chord::fs::Client*()>;
 class Service final : public chord::fs::Filesystem::Service {
   static constexpr auto logger_name = "chord.fs.service";
 
+  // chunk hashes per chunks response (paging)
+  static constexpr std::size_t chunks_per_response = 64*1024;
+
   enum class RequestType {
     PUT,
     GET,
@@ -43,19 +60,105 @@ class Service final : public chord::fs::Filesystem::Service {
     MOV
   };
 
+  /**
+   * issue the call to the successor - failing over along the successor
+   * list while the successors are unavailable.
+   */
+  template<typename Call>
+  grpc::Status with_successors(Call&&);
+
   grpc::Status get_from_reference_or_replication(const chord::uri& uri);
-  grpc::Status handle_meta_add(grpc::ServerContext*,const MetaRequest*);
-  grpc::Status handle_meta_del(grpc::ServerContext*,const MetaRequest*);
-  grpc::Status handle_meta_dir(grpc::ServerContext*,const MetaRequest*, MetaResponse*);
-  grpc::Status handle_meta_mov(grpc::ServerContext*,const MetaRequest*, MetaResponse*);
-  grpc::Status handle_del_file(grpc::ServerContext*,const DelRequest*);
-  grpc::Status handle_del_dir(grpc::ServerContext*,const DelRequest*);
-  grpc::Status handle_del_recursive(grpc::ServerContext*, const DelRequest*);
+  grpc::Status handle_meta_add(const MetaRequest*, const client::options&);
+  grpc::Status handle_meta_del(const MetaRequest*, const client::options&);
+  grpc::Status handle_meta_dir(const MetaRequest*, MetaResponse*);
+  grpc::Status handle_del_file(const DelRequest*, const client::options&);
+  grpc::Status handle_del_dir(const DelRequest*, const client::options&);
+  grpc::Status handle_del_recursive(const DelRequest*, const client::options&);
   client::options init_source(const client::options&) const;
 
   fs::client::options update_source(fs::client::options) const;
-  grpc::Status is_valid(grpc::ServerContext*, const RequestType);
-  bool file_hashes_equal(grpc::ServerContext*, grpc::ServerReader<PutRequest>*);
+  grpc::Status is_valid(const client::options&, const RequestType);
+  /**
+   * initial puts of keys owned by another node are rejected (NOT_FOUND),
+   * the client looks up the owner again.
+   */
+  grpc::Status is_responsible(const chord::uri&, const client::options&);
+
+  //--- building blocks of put and get, shared with the callback service
+
+  /**
+   * compare the hash of the put file with the local one and tell the
+   * client (initial metadata) whether the data needs to be sent.
+   */
+  bool file_hashes_equal(grpc::ServerContextBase*);
+  /**
+   * manifest of the local file, empty if unknown or outdated
+   */
+  std::optional<ChunkManifest> stored_chunks(const chord::uri&);
+  /**
+   * manifest of the local file if the client requested a delta put
+   * based on it - the client is told (initial metadata) whether the
+   * delta is accepted.
+   */
+  std::optional<ChunkManifest> delta_base(grpc::ServerContextBase*, const chord::uri&, const bool hashes_equal);
+  /**
+   * upload of a resumable put, received into the journal - the client is
+   * told (initial metadata) the offset to continue at. left empty if the
+   * client did not request a resumable put, aborted while another put of
+   * the uri is being received.
+   */
+  grpc::Status resumable_upload(grpc::ServerContextBase*, const chord::uri&, std::unique_ptr<PartialUpload>&);
+  /**
+   * recipe of the file if it is kept in the chunk store only (no local copy)
+   */
+  std::optional<ChunkRecipe> stored_recipe(const chord::uri&);
+  /**
+   * metadata of the local file - or of the file kept in the chunk store
+   */
+  std::set<Metadata> local_metadata(const chord::uri&, const Replication&);
+  /**
+   * path of the local file of the uri - creates the parent directories
+   */
+  chord::path data_path(const chord::uri&);
+  /**
+   * add the metadata (and the chunk manifest) of the put file and
+   * update the parent
+   */
+  void commit_put(const chord::uri&, const client::options&, ChunkManifest::Builder* chunks = nullptr);
+  /**
+   * split the put file into chunks and replace the local copy (chunk store)
+   */
+  void add_to_chunk_store(const chord::uri&);
+  /**
+   * add the part of the recipe and the chunk carried by the request
+   */
+  grpc::Status assemble(const AssembleRequest&, ChunkRecipe&);
+  /**
+   * set the recipe of the assembled file and add its metadata
+   */
+  grpc::Status commit_assemble(const chord::uri&, const client::options&, const ChunkRecipe&);
+  /**
+   * stream of the put to the next replica, empty if the put is not
+   * replicated (further) or pipelining is disabled
+   */
+  std::unique_ptr<Client::PutStream> forward_put(const chord::uri&, client::options, const std::optional<chord::uuid>& file_hash, const std::optional<Client::Delta>& delta = {});
+  /**
+   * replicate the put file to the successor - unless it has been
+   * forwarded while being received
+   */
+  void replicate_put(const chord::uri&, client::options, const bool forwarded = false);
+  /**
+   * path of the local file of the uri - restored from the referenced
+   * node or a replica if missing.
+   */
+  grpc::Status restore(const chord::uri&, chord::path& data);
+  /**
+   * position the stream of the local file at the range of the get
+   * request - the length is limited to the end of the file.
+   */
+  grpc::Status seek(std::istream&, const GetRequest&, std::uint64_t& length);
+
+  friend class CallbackService;
 
  public:
   explicit Service(Context &context, ChordFacade* chord, IMetadataManager* metadata_mgr, Client* client, chord::fs::monitor* = nullptr);
@@ -78,6 +181,31 @@ class Service final : public chord::fs::Filesystem::Service {
                     const chord::fs::MetaRequest *request,
                     chord::fs::MetaResponse *response) override;
 
+  grpc::Status chunks(grpc::ServerContext*, const ChunksRequest*, ChunksResponse*) override;
+
+  grpc::Status missing(grpc::ServerContext*, const MissingRequest*, MissingResponse*) override;
+
+  grpc::Status assemble(grpc::ServerContext*, grpc::ServerReader<chord::fs::AssembleRequest>*, chord::fs::PutResponse*) override;
+
+  //--- in-process calls of the local client (without serialization),
+  //    the options equal the ones received from the client context.
+  grpc::Status del(const DelRequest*, DelResponse*, const client::options&);
+  grpc::Status mov(const MovRequest*, MovResponse*, const client::options&);
+  grpc::Status meta(const MetaRequest*, MetaResponse*, const client::options&);
+  grpc::Status chunks(const ChunksRequest*, ChunksResponse*);
+  grpc::Status missing(const MissingRequest*, MissingResponse*);
+
+  /**
+   * stream of the local file - read from the chunk store if the file
+   * has no local copy
+   */
+  std::unique_ptr<std::istream> open(const chord::uri&);
+
+  /**
+   * remove the local copy of the file and its recipe (chunk store)
+   */
+  void remove_local(const chord::uri&);
+
  private:
   Context &context;
   ChordFacade *chord;
@@ -86,6 +214,8 @@ class Service final : public chord::fs::Filesystem::Service {
   chord::fs::monitor* monitor;
   ClientFactory make_client;
   std::shared_ptr<spdlog::logger> logger;
+  std::unique_ptr<ChunkStore> chunk_store;
+  PartialUpload::Registry uploads;
 };
 
 } //namespace fs
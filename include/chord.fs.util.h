@@ -2,6 +2,7 @@
 
 #include "chord.file.h"
 #include "chord.uri.h"
+#include "chord.uuid.h"
 #include "chord.context.h"
 #include "chord.fs.monitor.h"
 
@@ -16,6 +17,12 @@ bool remove(const chord::uri&, const Context&, bool delete_empty=false);
 path as_journal_path(const Context&, const path&);
 path as_journal_path(const Context&, const uri&);
 
+/**
+ * sha256 of the file's content - cached in an extended attribute of the
+ * file and reused as long as its size and modification time are unchanged.
+ */
+chord::uuid file_hash(const path&);
+
 } // namespace util
 } // namespace fs
 } // namespace chord
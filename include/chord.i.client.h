@@ -3,6 +3,8 @@
 #include <functional>
 #include <memory>
 
+#include <grpcpp/server_context.h>
+
 #include "chord.grpc.pb.h"
 #include "chord.types.h"
 #include "chord.uuid.h"
@@ -22,7 +24,10 @@ class IClient {
 
   virtual grpc::Status join(const endpoint& addr) =0;
   virtual grpc::Status join(const JoinRequest *req, JoinResponse *res) =0;
-  virtual grpc::Status join(grpc::ClientContext *clientContext, const JoinRequest *req, JoinResponse *res) =0;
+  /**
+   * forward the join request on behalf of the parent request (if any)
+   */
+  virtual grpc::Status join(const grpc::ServerContext *parent, const JoinRequest *req, JoinResponse *res) =0;
 
   virtual grpc::Status ping(const node& addr) =0;
 
@@ -35,7 +40,10 @@ class IClient {
 
   virtual chord::common::RouterEntry successor(const uuid_t &id) =0;
 
-  virtual grpc::Status successor(grpc::ClientContext *context, const chord::SuccessorRequest *req, chord::SuccessorResponse *res) =0;
+  /**
+   * forward the successor request on behalf of the parent request (if any)
+   */
+  virtual grpc::Status successor(const grpc::ServerContext *parent, const chord::SuccessorRequest *req, chord::SuccessorResponse *res) =0;
 
   virtual grpc::Status successor(const chord::SuccessorRequest *req, chord::SuccessorResponse *res) =0;
 
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <set>
 #include <map>
+#include <optional>
+#include <vector>
 
+#include "chord.fs.chunk.manifest.h"
+#include "chord.fs.chunk.recipe.h"
+#include "chord.fs.metadata.batch.h"
 #include "chord.fs.metadata.h"
 #include "chord.uri.h"
 
@@ -35,6 +41,11 @@ protected:
 
   virtual bool add(const chord::uri& directory, const std::set<Metadata>& metadata) = 0;
 
+  /**
+   * apply all mutations of the batch atomically
+   */
+  virtual void apply(const MetadataBatch& batch) = 0;
+
   virtual uri_meta_map_desc get_all() = 0;
   virtual uri_meta_map_desc get(const chord::uuid& from, const chord::uuid& to) = 0;
 
@@ -44,6 +55,26 @@ protected:
   virtual uri_meta_map_desc get_replicated(const std::uint32_t min_idx=0) = 0;
   virtual std::set<Metadata> get(const chord::uri& directory) = 0;
 
+  /**
+   * chunk manifest of the file - removed along with the file
+   */
+  virtual std::optional<ChunkManifest> chunks(const chord::uri& file) = 0;
+  virtual void chunks(const chord::uri& file, const ChunkManifest&) = 0;
+
+  /**
+   * chunk recipe of the file kept in the chunk store. setting (or
+   * resetting) the recipe references its chunks and releases the ones
+   * of the replaced recipe - the chunks no longer referenced by any
+   * recipe are returned.
+   */
+  virtual std::optional<ChunkRecipe> recipe(const chord::uri& file) = 0;
+  virtual std::vector<chord::uuid> recipe(const chord::uri& file, const std::optional<ChunkRecipe>&) = 0;
+
+  /**
+   * number of recipe references to the chunk
+   */
+  virtual std::uint64_t refs(const chord::uuid& chunk) = 0;
+
 };
 
 } //namespace fs
@@ -2,6 +2,7 @@
 
 #include <grpc++/server_context.h>
 #include <grpc/grpc.h>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -28,6 +29,14 @@ class IService {
 
   virtual chord::common::RouterEntry successor(const uuid_t &uuid) = 0;
 
+  /**
+   * successor and the number of hops needed to resolve it
+   */
+  virtual chord::common::RouterEntry successor(const uuid_t &uuid, std::uint32_t &hops) {
+    hops = 0;
+    return successor(uuid);
+  }
+
 
   virtual grpc::Status successor(grpc::ServerContext *context,
                                  const chord::SuccessorRequest *req,
@@ -3,6 +3,7 @@
 #include <map>
 #include <list>
 #include <mutex>
+#include <optional>
 #include <functional>
 #include <stdexcept>
 
@@ -53,6 +54,16 @@ class LRUCache {
       return _get(k);
     }
 
+    /**
+     * get (and touch) the element, empty if not found
+     */
+    std::optional<V> find(const K& k) {
+      std::lock_guard<mutex_t> lck(mtx);
+      const auto it = _touch(k);
+      if(it == _map.end()) return {};
+      return it->second->second;
+    }
+
     V compute_if_absent(const K& k, std::function<V (const K&)> mapping_function) {
       std::lock_guard<mutex_t> lck(mtx);
       if(!_exists(k)) _put(k, mapping_function(k));
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <grpcpp/impl/codegen/status.h>
+
+#include "chord.pb.h"
+#include "chord.node.h"
+
+namespace chord { struct Context; }
+namespace chord { struct Router; }
+namespace spdlog { class logger; }
+
+namespace chord {
+
+/**
+ * handling of the ring maintenance responses - shared by the blocking
+ * (Client) and the callback (AsyncClient) maintenance.
+ *
+ * failed nodes are not removed here: they are evicted once suspected by
+ * the failure detector (see ChordFacade::evict_failed_nodes).
+ */
+namespace maintenance {
+
+/**
+ * feed the failure detector with the outcome of a request to the node
+ */
+void record(const Context&, Router&, const node&, const grpc::Status&);
+
+/**
+ * adopt the predecessor of the successor (if closer) and refresh the
+ * successor list from the stabilize response.
+ *
+ * @return true if the successor is to be notified
+ */
+bool stabilized(const Context&, Router&, spdlog::logger&, const node& successor, const grpc::Status&, const StabilizeResponse&);
+
+/**
+ * log the outcome of the ping of the predecessor
+ */
+void checked(Router&, spdlog::logger&, const node& predecessor, const grpc::Status&, const PingResponse&);
+
+}  // namespace maintenance
+}  // namespace chord
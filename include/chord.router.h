@@ -7,11 +7,13 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 
+#include "chord.failure.detector.h"
 #include "chord.signal.h"
 #include "chord.types.h"
 #include "chord.node.h"
@@ -45,8 +47,23 @@ protected:
 private:
   static constexpr auto logger_name = "chord.router";
 
-  using entry_t = RouterEntry;
-  using sequence_map_t = std::array<RouterEntry, Router::BITS>;
+  /**
+   * run of consecutive finger entries pointing to the same node.
+   *
+   * finger i starts at self + distances[i] and points to the closest
+   * known node strictly behind its start. since the starts are
+   * monotonically increasing every distinct node covers a contiguous
+   * block of entries; the block of a run ends at `end` (exclusive) and
+   * begins where the block of the previous run ends.
+   */
+  struct Finger {
+    chord::uuid distance;
+    size_t end;
+    chord::node node;
+  };
+
+  using distance_map_t = std::array<chord::uuid, Router::BITS>;
+  using finger_map_t = std::vector<Finger>;
 
   chord::Context &context;
   std::shared_ptr<spdlog::logger> logger;
@@ -56,6 +73,12 @@ private:
   void init();
   void cleanup();
 
+  uuid distance_of(const uuid&) const;
+  size_t index_of(const uuid& distance) const;
+  finger_map_t::iterator find(const uuid& distance);
+
+  FailureDetector detector;
+
   signal<const node> event_successor_fail;
   signal<const node> event_predecessor_fail;
 
@@ -63,10 +86,25 @@ private:
   signal<const node, const node> event_predecessor_update;
 
 
+  /**
+   * distances of the finger starts to this node on the ring.
+   */
+  distance_map_t distances;
+  /**
+   * distinct nodes of the finger table ordered by their distance.
+   */
+  finger_map_t fingers;
+  /**
+   * successor list as reported by the successor on stabilize, merged
+   * with the finger table on access (see successors).
+   */
+  std::vector<node> _successors;
+
 protected:
-  sequence_map_t successors;
   std::optional<node> _predecessor;
 
+  RouterEntry entry(const size_t) const;
+
 public:
   explicit Router(const chord::Router&) = delete;
 
@@ -82,8 +120,14 @@ public:
   bool has_successor() const;
   bool has_predecessor() const;
 
+  /**
+   * liveness of the known nodes
+   */
+  inline FailureDetector& failure_detector() { return detector; }
+
   inline signal<const node>& on_successor_fail() { return event_successor_fail; }
   inline signal<const node>& on_predecessor_fail() { return event_predecessor_fail; }
+  inline signal<const node, const node>& on_successor_update() { return event_successor_update; }
   inline signal<const node, const node>& on_predecessor_update() { return event_predecessor_update; }
 
   void update(const std::set<chord::node>&);
@@ -94,12 +138,31 @@ public:
   uuid get(const size_t) const;
   std::set<node> get() const;
 
+  /**
+   * first finger index of every distinct interval of the finger table,
+   * including the trailing interval not covered by any known node.
+   *
+   * a lookup of the first finger of an interval discovers every closer
+   * node of the interval, hence repairing these indices suffices.
+   */
+  std::vector<size_t> intervals() const;
+
   std::string print() const;
   std::ostream& print(std::ostream&) const;
 
   std::optional<node> successor() const;
   node successor_or_self() const;
 
+  /**
+   * closest known successors, closest first - at most successor-list-size nodes.
+   */
+  std::vector<node> successors() const;
+
+  /**
+   * refresh the successor list from the successor list of the successor.
+   */
+  void update_successors(const node& successor, const std::vector<node>& list);
+
   std::optional<node> predecessor() const;
 
   std::vector<node> closest_preceding_nodes(const uuid& uuid);
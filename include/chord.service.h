@@ -2,6 +2,7 @@
 #include "chord_common.pb.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>                    // for function
 #include <memory>
 
@@ -46,6 +47,8 @@ class Service final : public chord::Chord::Service, public IService {
 
   chord::common::RouterEntry successor(const uuid_t &uuid) override;
 
+  chord::common::RouterEntry successor(const uuid_t &uuid, std::uint32_t &hops) override;
+
   grpc::Status successor(grpc::ServerContext *context,
                          const chord::SuccessorRequest *req,
                          chord::SuccessorResponse *res) override;
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "chord.node.h"
+#include "chord.uuid.h"
+
+namespace chord {
+
+/**
+ * cache of key ranges to their owners (successors)
+ *
+ * a lookup of key k resolving to owner o proves that there is no node
+ * in [k, o), hence every key of [k, o] is owned by o. the cache keeps
+ * one such interval per owner and widens it with every lookup that
+ * resolves to the same owner.
+ *
+ * the intervals are only valid until the ring changes, i.e. owners
+ * must be invalidated on churn or if they turn out to be stale. lookups
+ * are only put if the cache has not been invalidated in the meantime
+ * (see generation). since churn further away is not noticed, intervals
+ * expire after the ttl (if any).
+ */
+class SuccessorCache {
+ private:
+  struct Interval {
+    // first key of the interval
+    chord::uuid from;
+    chord::node owner;
+    // hops of the lookup that resolved the owner
+    std::uint32_t hops;
+    std::chrono::steady_clock::time_point expires;
+  };
+
+  using map_t = std::map<chord::uuid, Interval>;
+
+  const std::size_t _capacity;
+  const std::chrono::milliseconds _ttl;
+
+  mutable std::mutex mtx;
+  std::uint64_t _generation{0};
+  // intervals by the uuid of their owner, i.e. by their last key
+  map_t intervals;
+
+  std::atomic<std::uint64_t> _hits{0};
+  std::atomic<std::uint64_t> _misses{0};
+  std::atomic<std::uint64_t> _hops_saved{0};
+
+  /**
+   * interval containing the key - must be protected by mutex
+   */
+  map_t::iterator find(const chord::uuid& key) {
+    if(intervals.empty()) return intervals.end();
+    // first owner at or behind the key - wrapping around the ring
+    auto it = intervals.lower_bound(key);
+    if(it == intervals.end()) it = intervals.begin();
+    const auto& [owner, interval] = *it;
+    return contains(interval.from, key, owner) ? it : intervals.end();
+  }
+
+  static bool contains(const chord::uuid& from, const chord::uuid& key, const chord::uuid& to) {
+    // unsigned arithmetic wraps around the ring
+    return to - key <= to - from;
+  }
+
+  std::chrono::steady_clock::time_point expiry() const {
+    return _ttl.count() > 0 ? std::chrono::steady_clock::now() + _ttl : std::chrono::steady_clock::time_point::max();
+  }
+
+ public:
+  /**
+   * @param ttl expiry of the intervals, zero keeps them until invalidated
+   */
+  explicit SuccessorCache(const std::size_t capacity, const std::chrono::milliseconds ttl = std::chrono::milliseconds::zero())
+    : _capacity{capacity}, _ttl{ttl} {}
+
+  SuccessorCache(const SuccessorCache&) = delete;
+
+  bool enabled() const { return _capacity > 0; }
+  std::size_t capacity() const { return _capacity; }
+  std::chrono::milliseconds ttl() const { return _ttl; }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lck(mtx);
+    return intervals.size();
+  }
+
+  std::uint64_t hits() const { return _hits; }
+  std::uint64_t misses() const { return _misses; }
+
+  /**
+   * sum of the hops of the lookups answered by the cache
+   */
+  std::uint64_t hops_saved() const { return _hops_saved; }
+
+  double hit_ratio() const {
+    const auto total = hits() + misses();
+    return total == 0 ? 0.0 : static_cast<double>(hits()) / static_cast<double>(total);
+  }
+
+  std::optional<chord::node> get(const chord::uuid& key) {
+    std::lock_guard<std::mutex> lck(mtx);
+    const auto it = find(key);
+    if(it == intervals.end()) {
+      ++_misses;
+      return {};
+    }
+    if(it->second.expires <= std::chrono::steady_clock::now()) {
+      intervals.erase(it);
+      ++_misses;
+      return {};
+    }
+    ++_hits;
+    // a cached owner saves at least the round trip to ourselves
+    _hops_saved += it->second.hops + 1;
+    return it->second.owner;
+  }
+
+  /**
+   * generation to be passed to put
+   */
+  std::uint64_t generation() const {
+    std::lock_guard<std::mutex> lck(mtx);
+    return _generation;
+  }
+
+  /**
+   * put the owner of the key unless the cache has been invalidated since generation
+   */
+  bool put(const chord::uuid& key, const chord::node& owner, const std::uint32_t hops, const std::uint64_t generation) {
+    if(!enabled()) return false;
+
+    std::lock_guard<std::mutex> lck(mtx);
+    if(_generation != generation) return false;
+
+    // there is no node in [key, owner), drop owners of that range
+    for(auto it = intervals.lower_bound(key); it != intervals.end() && it->first != owner.uuid && contains(key, it->first, owner.uuid);) {
+      it = intervals.erase(it);
+    }
+    if(key > owner.uuid) {
+      for(auto it = intervals.begin(); it != intervals.end() && it->first < owner.uuid;) {
+        it = intervals.erase(it);
+      }
+    }
+
+    if(const auto it = intervals.find(owner.uuid); it != intervals.end()) {
+      auto& interval = it->second;
+      if(interval.owner != owner) {
+        interval = {key, owner, hops, expiry()};
+        return true;
+      }
+      if(!contains(interval.from, key, owner.uuid)) {
+        // widen the interval
+        interval.from = key;
+        interval.hops = hops;
+      }
+      // the owner has just been confirmed
+      interval.expires = expiry();
+      return true;
+    }
+
+    if(intervals.size() >= _capacity) {
+      // evict the neighbour of the new interval
+      auto it = intervals.lower_bound(owner.uuid);
+      intervals.erase(it == intervals.end() ? intervals.begin() : it);
+    }
+    intervals.emplace(owner.uuid, Interval{key, owner, hops, expiry()});
+    return true;
+  }
+
+  /**
+   * drop the interval containing the key
+   *
+   * @return true if the key has been cached
+   */
+  bool invalidate(const chord::uuid& key) {
+    std::lock_guard<std::mutex> lck(mtx);
+    ++_generation;
+    const auto it = find(key);
+    if(it == intervals.end()) return false;
+    intervals.erase(it);
+    return true;
+  }
+
+  /**
+   * drop all intervals - e.g. on churn
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lck(mtx);
+    ++_generation;
+    intervals.clear();
+  }
+};
+
+}  // namespace chord
@@ -1,41 +1,155 @@
 #pragma once
 
 #include <boost/multiprecision/cpp_int.hpp>
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <chrono>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <random>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <iterator>
 #include <fmt/ostream.h>
 
 namespace chord {
+/**
+ * fixed-width 256-bit unsigned integer.
+ *
+ * the value is stored as four 64-bit limbs, most significant limb first,
+ * hence the lexicographical order of the limbs equals the numerical order.
+ * arithmetic wraps modulo 2^256 like boost's unchecked uint256_t.
+ */
 class uuid {
 public:
+  /**
+   * boost representation, used for conversions (e.g. serialization) only
+   */
   using value_t = boost::multiprecision::uint256_t;
- private:
+  using limb_t = std::uint64_t;
 
   static constexpr int UUID_BITS_MAX = 256;
+  static constexpr std::size_t UUID_BYTES = UUID_BITS_MAX / 8;
+  static constexpr std::size_t LIMBS = UUID_BITS_MAX / 64;
+
+ private:
+
+  std::array<limb_t, LIMBS> limbs{};
+
+  using wide_t = unsigned __int128;
+
+  // 10^9 fits into 32 bits, hence the divisions by the constant compile to multiplications
+  static constexpr std::uint32_t DECIMAL_BASE = 1'000'000'000u;
+  static constexpr int DECIMAL_DIGITS = 9;
+
+  static constexpr int digit(const char c, const int base) {
+    int d = base;
+    if(c >= '0' && c <= '9') d = c - '0';
+    else if(c >= 'a' && c <= 'f') d = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F') d = c - 'A' + 10;
+    return d < base ? d : -1;
+  }
 
-  value_t val;
+  /**
+   * this = this * factor + summand
+   */
+  constexpr void mul_add(const limb_t factor, const limb_t summand) {
+    limb_t carry = summand;
+    for(auto it = limbs.rbegin(); it != limbs.rend(); ++it) {
+      const wide_t cur = static_cast<wide_t>(*it) * factor + carry;
+      *it = static_cast<limb_t>(cur);
+      carry = static_cast<limb_t>(cur >> 64);
+    }
+  }
+
+  static uuid parse(std::string_view str, int base = 10) {
+    if(str.size() > 1 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+      str.remove_prefix(2);
+      base = 16;
+    }
+    uuid ret;
+    for(const auto c : str) {
+      const auto d = digit(c, base);
+      if(d < 0) throw std::runtime_error("Unexpected content found while parsing uuid: " + std::string{str});
+      ret.mul_add(static_cast<limb_t>(base), static_cast<limb_t>(d));
+    }
+    return ret;
+  }
 
  public:
-  uuid() = default;
+  constexpr uuid() = default;
+
+  //cppcheck-suppress noExplicitConstructor
+  inline uuid(const std::string &str) : uuid{parse(str)} {}
 
-  explicit inline uuid(const std::string &str) : val{value_t{str}} {}
+  //cppcheck-suppress noExplicitConstructor
+  inline uuid(const char *str) : uuid{parse(str)} {}
+
+  //cppcheck-suppress noExplicitConstructor
+  inline uuid(const value_t &value) {
+    for(std::size_t i = 0; i < LIMBS; ++i) {
+      limbs[LIMBS - 1 - i] = static_cast<limb_t>(value >> (64 * i));
+    }
+  }
 
-  template <typename T>
+  template <std::integral T>
   //cppcheck-suppress noExplicitConstructor
-  inline uuid(const T &v) : val{value_t{v}} {}
+  constexpr uuid(const T v) {
+    limbs[LIMBS - 1] = static_cast<limb_t>(v);
+    if constexpr (std::is_signed_v<T>) {
+      // sign extension, c.f. unchecked uint256_t
+      if(v < 0) std::fill(limbs.begin(), limbs.end() - 1, std::numeric_limits<limb_t>::max());
+    }
+  }
 
+  /**
+   * interprets the range as big-endian sequence of 32-bit words
+   */
   template <typename Iterator>
   inline uuid(const Iterator beg, const Iterator end) {
-    boost::multiprecision::import_bits(val,
-                                       reinterpret_cast<const unsigned int *>(beg),
-                                       reinterpret_cast<const unsigned int *>(end));
+    const auto* first = reinterpret_cast<const unsigned int *>(beg);
+    const auto* last = reinterpret_cast<const unsigned int *>(end);
+    for(; first != last; ++first) {
+      mul_add(limb_t{1} << 32, *first);
+    }
   }
 
-  inline value_t &value() { return val; }
+  /**
+   * boost representation of the value
+   */
+  inline value_t value() const {
+    value_t ret;
+    for(const auto limb : limbs) {
+      ret = (ret << 64) | limb;
+    }
+    return ret;
+  }
+
+  /**
+   * 2^i - the offset of the i-th finger
+   */
+  static constexpr uuid pow2(const std::size_t i) {
+    uuid ret;
+    ret.limbs[LIMBS - 1 - (i / 64) % LIMBS] = limb_t{1} << (i % 64);
+    return ret;
+  }
 
+  /**
+   * 2^256 - 1
+   */
+  static constexpr uuid max() {
+    uuid ret;
+    ret.limbs.fill(std::numeric_limits<limb_t>::max());
+    return ret;
+  }
 
   /**
    * generate random 256-bit number
@@ -54,6 +168,10 @@ public:
     return uuid{std::begin(array), std::end(array)};
   }
 
+  constexpr bool is_zero() const {
+    return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0;
+  }
+
   /**
    * implicit string conversion operator
    */
@@ -63,87 +181,171 @@ public:
    * value as string
    */
   inline std::string string() const {
-    return val.str();
+    if(is_zero()) return "0";
+
+    // split into base 10^9 chunks, least significant first
+    std::array<std::uint32_t, 2 * LIMBS> words;
+    for(std::size_t i = 0; i < LIMBS; ++i) {
+      words[2 * i] = static_cast<std::uint32_t>(limbs[i] >> 32);
+      words[2 * i + 1] = static_cast<std::uint32_t>(limbs[i]);
+    }
+    std::array<std::uint32_t, (UUID_BITS_MAX * 3 / 10) / DECIMAL_DIGITS + 2> chunks{};
+    std::size_t size = 0;
+    for(std::size_t first = 0; first < words.size();) {
+      std::uint64_t rem = 0;
+      for(auto i = first; i < words.size(); ++i) {
+        const auto cur = (rem << 32) | words[i];
+        words[i] = static_cast<std::uint32_t>(cur / DECIMAL_BASE);
+        rem = cur % DECIMAL_BASE;
+      }
+      chunks[size++] = static_cast<std::uint32_t>(rem);
+      while(first < words.size() && words[first] == 0) ++first;
+    }
+
+    char buf[DECIMAL_DIGITS];
+    auto res = std::to_chars(buf, buf + DECIMAL_DIGITS, chunks[--size]);
+    std::string ret{buf, res.ptr};
+    while(size) {
+      res = std::to_chars(buf, buf + DECIMAL_DIGITS, chunks[--size]);
+      ret.append(static_cast<std::size_t>(DECIMAL_DIGITS - (res.ptr - buf)), '0');
+      ret.append(buf, res.ptr);
+    }
+    return ret;
   }
 
   /**
    * value as hex
    */
   inline std::string hex() const {
-    std::stringstream ss;
-    ss << std::hex << val;
-    auto str = ss.str();
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-    return str;
+    std::string ret;
+    char buf[16];
+    for(const auto limb : limbs) {
+      if(ret.empty() && limb == 0) continue;
+      const auto res = std::to_chars(buf, buf + sizeof(buf), limb, 16);
+      if(!ret.empty()) ret.append(static_cast<std::size_t>(sizeof(buf) - (res.ptr - buf)), '0');
+      ret.append(buf, res.ptr);
+    }
+    return ret.empty() ? "0" : ret;
   }
 
   inline std::string short_hex() const { return hex().substr(0, 5); }
 
-  inline uuid &operator+=(const uuid &other) {
-    val += other.val;
-    return *this;
+  /**
+   * value as fixed-width (32 byte) big-endian byte string
+   *
+   * the byte order preserves the numerical order of the uuids,
+   * i.e. the strings may be compared lexicographically.
+   */
+  inline std::string bytes() const {
+    std::string ret(UUID_BYTES, '\0');
+    auto it = ret.begin();
+    for(const auto limb : limbs) {
+      for(int shift = 56; shift >= 0; shift -= 8) {
+        *it++ = static_cast<char>(limb >> shift);
+      }
+    }
+    return ret;
+  }
+
+  /**
+   * create uuid from a big-endian byte string (see bytes())
+   */
+  static uuid from_bytes(const std::string_view bytes) {
+    uuid ret;
+    for(const auto byte : bytes) {
+      ret.mul_add(limb_t{1} << 8, static_cast<unsigned char>(byte));
+    }
+    return ret;
+  }
+
+  /**
+   * hash of the uuid (its least significant bits)
+   */
+  constexpr std::size_t hash() const {
+    return static_cast<std::size_t>(limbs[LIMBS - 1]);
   }
 
-  inline uuid &operator-=(const uuid &other) {
-    val -= other.val;
+  constexpr uuid &operator+=(const uuid &other) {
+    limb_t carry = 0;
+    for(std::size_t i = LIMBS; i-- > 0;) {
+      const wide_t sum = static_cast<wide_t>(limbs[i]) + other.limbs[i] + carry;
+      limbs[i] = static_cast<limb_t>(sum);
+      carry = static_cast<limb_t>(sum >> 64);
+    }
     return *this;
   }
 
-  inline uuid &operator*=(const uuid &other) {
-    val *= other.val;
+  constexpr uuid &operator-=(const uuid &other) {
+    limb_t borrow = 0;
+    for(std::size_t i = LIMBS; i-- > 0;) {
+      const wide_t diff = static_cast<wide_t>(limbs[i]) - other.limbs[i] - borrow;
+      limbs[i] = static_cast<limb_t>(diff);
+      borrow = static_cast<limb_t>(diff >> 64) & 1;
+    }
     return *this;
   }
 
+  constexpr uuid &operator*=(const uuid &other) {
+    uuid ret;
+    for(std::size_t i = LIMBS; i-- > 0;) {
+      limb_t carry = 0;
+      // only the products of limbs i+j >= LIMBS-1 stay within 256 bits
+      for(std::size_t j = LIMBS; j-- > LIMBS - 1 - i;) {
+        const auto k = i + j - (LIMBS - 1);
+        const wide_t cur = static_cast<wide_t>(limbs[i]) * other.limbs[j] + ret.limbs[k] + carry;
+        ret.limbs[k] = static_cast<limb_t>(cur);
+        carry = static_cast<limb_t>(cur >> 64);
+      }
+    }
+    return *this = ret;
+  }
+
   inline uuid &operator/=(const uuid &other) {
-    val /= other.val;
-    return *this;
+    return *this = uuid{value() / other.value()};
   }
 
-  inline uuid &operator%=(const uuid &other) { 
-    val %= other.val;
-    return *this;
+  inline uuid &operator%=(const uuid &other) {
+    return *this = uuid{value() % other.value()};
   }
 
   /**
    * @brief Check if the uuid is in the interval between the two given uuids on the ring.
    *
-   * Neither of the boundaries is included in the interval. 
+   * Neither of the boundaries is included in the interval.
    */
-  inline bool between(const uuid& from, const uuid& to) const {
-    if(from < to) {
-      return from < *this && *this < to;
-    }
-    return from < *this || *this < to;
+  constexpr bool between(const uuid& from, const uuid& to) const {
+    const bool lower = from < *this;
+    const bool upper = *this < to;
+    return from < to ? (lower & upper) : (lower | upper);
   }
 
-  inline bool operator==(const uuid &other) const { return val == other.val; }
-
-  inline bool operator!=(const uuid &other) const { return val != other.val; }
-
-  inline bool operator>=(const uuid &other) const { return val >= other.val; }
-
-  inline bool operator<=(const uuid &other) const { return val <= other.val; }
-
-  inline bool operator<(const uuid &other) const { return val < other.val; }
+  constexpr bool operator==(const uuid &other) const = default;
 
-  inline bool operator>(const uuid &other) const { return val > other.val; }
+  constexpr std::strong_ordering operator<=>(const uuid &other) const = default;
 
-  inline uuid operator+(const uuid &other) const { return uuid{val + other.val}; }
+  constexpr uuid operator+(const uuid &other) const { return uuid{*this} += other; }
 
-  inline uuid operator-(const uuid &other) const { return uuid{val - other.val}; }
+  constexpr uuid operator-(const uuid &other) const { return uuid{*this} -= other; }
 
-  inline uuid operator*(const uuid &other) const { return uuid{val * other.val}; }
+  constexpr uuid operator*(const uuid &other) const { return uuid{*this} *= other; }
 
-  inline uuid operator/(const uuid &other) const { return uuid{val / other.val}; }
+  inline uuid operator/(const uuid &other) const { return uuid{*this} /= other; }
 
-  inline uuid operator%(const uuid &other) const { return uuid{val % other.val}; }
+  inline uuid operator%(const uuid &other) const { return uuid{*this} %= other; }
 
-  static bool between(const uuid& lower, const uuid& element, const uuid& upper) {
+  static constexpr bool between(const uuid& lower, const uuid& element, const uuid& upper) {
     return element.between(lower, upper);
   }
 
   friend std::istream &operator>>(std::istream &is, uuid &hash) {
-    is >> hash.val;
+    std::string str;
+    if(is >> str) {
+      try {
+        hash = parse(str, (is.flags() & std::ios_base::hex) ? 16 : 10);
+      } catch(const std::runtime_error&) {
+        is.setstate(std::ios_base::failbit);
+      }
+    }
     return is;
   }
 
@@ -152,8 +354,15 @@ public:
     return os;
   }
 };
+
+static_assert(std::is_trivially_copyable_v<uuid>);
+
 }  // namespace chord
 
 using uuid_t = chord::uuid;
 
 template<> struct fmt::formatter<chord::uuid> : ostream_formatter {};
+
+template<> struct std::hash<chord::uuid> {
+  std::size_t operator()(const chord::uuid& uuid) const noexcept { return uuid.hash(); }
+};
@@ -0,0 +1,214 @@
+#include "chord.async.client.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "chord.channel.pool.h"
+#include "chord.common.h"
+#include "chord.context.h"
+#include "chord.deadline.h"
+#include "chord.log.factory.h"
+#include "chord.log.h"
+#include "chord.maintenance.h"
+#include "chord.pb.h"
+#include "chord.router.h"
+
+using grpc::Status;
+using grpc::StatusCode;
+
+using chord::common::make_node;
+using chord::common::make_request;
+using chord::common::set_id;
+
+using chord::StabilizeRequest;
+using chord::StabilizeResponse;
+using chord::NotifyRequest;
+using chord::NotifyResponse;
+using chord::PingRequest;
+using chord::PingResponse;
+using chord::SuccessorRequest;
+using chord::SuccessorResponse;
+
+using namespace std;
+
+namespace chord {
+
+namespace {
+/**
+ * fix fingers round - done once the last probe released the round
+ */
+struct Round {
+  std::function<void()> done;
+  ~Round() {
+    if(done) done();
+  }
+};
+} // namespace
+
+AsyncClient::AsyncClient(const Context& context, Router* router, ChannelPool* channel_pool)
+    : AsyncClient(context, router, [channel_pool](const node& node) { return Chord::NewStub(channel_pool->get(node)); }) {}
+
+AsyncClient::AsyncClient(const Context& context, Router* router, StubFactory make_stub)
+    : context{context},
+      router{router},
+      make_stub{std::move(make_stub)},
+      logger{context.logging.factory().get_or_create(logger_name)} {}
+
+AsyncClient::~AsyncClient() {
+  wait();
+}
+
+void AsyncClient::wait() {
+  std::unique_lock<std::mutex> lck(mtx);
+  idle.wait(lck, [this] { return in_flight.empty(); });
+}
+
+template<typename Request, typename Response>
+bool AsyncClient::call(method_t<Request, Response> method, const std::string& rpc, const node& peer, const uuid& key,
+                       Request req, const std::chrono::milliseconds period,
+                       std::function<void(const Status&, const Response&)> done) {
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    if(!in_flight.emplace(rpc, key).second) {
+      logger->trace("[{}] probe of {} still pending - skipping.", rpc, peer);
+      return false;
+    }
+  }
+
+  auto* call = new Call<Request, Response>{};
+  call->req = std::move(req);
+  call->stub = make_stub(peer);
+  // a probe never outlives its period
+  std::optional<deadline::time_point> budget;
+  if(period.count() > 0) budget = deadline::clock::now() + period;
+  deadline::set(call->client_context, deadline::of(context, rpc, budget));
+
+  auto on_done = [this, call, rpc, peer, key, done = std::move(done)](Status status) mutable {
+    maintenance::record(context, *router, peer, status);
+    try {
+      done(status, call->res);
+    } catch(const std::exception& error) {
+      logger->error("[{}] failed to apply response of {}, reason: {}", rpc, peer, error.what());
+    }
+    // release the captured state before the probe is reported complete
+    done = nullptr;
+    delete call;
+    complete(rpc, key);
+  };
+
+  auto* async = call->stub->async();
+  if(!async) {
+    on_done({StatusCode::UNIMPLEMENTED, "stub does not support the callback api."});
+    return true;
+  }
+  (async->*method)(&call->client_context, &call->req, &call->res, std::move(on_done));
+  return true;
+}
+
+void AsyncClient::complete(const std::string& rpc, const uuid& key) {
+  std::lock_guard<std::mutex> lck(mtx);
+  in_flight.erase({rpc, key});
+  if(in_flight.empty()) idle.notify_all();
+}
+
+void AsyncClient::stabilize() {
+  const auto successor = router->successor();
+
+  //--- return if join failed or uuid == successor (create)
+  if(!successor || successor->uuid == context.uuid()) {
+    logger->trace("[stabilize] no successor found");
+    return;
+  }
+
+  logger->trace("[stabilize] calling stabilize on successor {}", successor->endpoint);
+  call<StabilizeRequest, StabilizeResponse>(&async_interface::stabilize, "stabilize", *successor, successor->uuid,
+      make_request<StabilizeRequest>(context), std::chrono::milliseconds(context.stabilize_period_ms),
+      [this, successor = *successor](const Status& status, const StabilizeResponse& res) {
+    if(maintenance::stabilized(context, *router, *logger, successor, status, res)) {
+      notify();
+    }
+  });
+}
+
+void AsyncClient::notify() {
+  const auto successor = router->successor();
+  if(!successor || successor == context.node()) {
+    logger->warn("[notify] no successor to notify - aborting.");
+    return;
+  }
+
+  logger->trace("calling notify on address {}", *successor);
+  call<NotifyRequest, NotifyResponse>(&async_interface::notify, "notify", *successor, successor->uuid,
+      make_request<NotifyRequest>(context), std::chrono::milliseconds(context.stabilize_period_ms),
+      [this, successor = *successor](const Status& status, const NotifyResponse&) {
+    if(!status.ok()) logger->warn("[notify] failed on {}", successor);
+  });
+}
+
+void AsyncClient::check() {
+  const auto predecessor = router->predecessor();
+  if(!predecessor) {
+    logger->trace("[check] no predecessor, skip.");
+    return;
+  }
+  if(!router->successor()) {
+    logger->trace("[check] no successor, skip.");
+    return;
+  }
+
+  logger->trace("[check] checking predecessor {}", *predecessor);
+  call<PingRequest, PingResponse>(&async_interface::ping, "ping", *predecessor, predecessor->uuid,
+      make_request<PingRequest>(context), std::chrono::milliseconds(context.check_period_ms),
+      [this, predecessor = *predecessor](const Status& status, const PingResponse& res) {
+    maintenance::checked(*router, *logger, predecessor, status, res);
+  });
+}
+
+void AsyncClient::apply_finger(const uuid& id, const node& successor) {
+  logger->trace("fixing finger for {}. received successor {}", id, successor);
+  if(successor == context.node()) {
+    router->remove(id);
+    return;
+  }
+  router->update(successor);
+}
+
+void AsyncClient::fix_fingers(const std::vector<std::size_t>& indices, std::function<void()> done) {
+  auto round = std::make_shared<Round>();
+  round->done = std::move(done);
+
+  const uuid self{context.uuid()};
+  for(const auto index : indices) {
+    const auto id = router->calc_successor_uuid_for_index(index);
+
+    const auto successor = router->successor_or_self();
+    if(id == self || uuid::between(self, id, successor.uuid)) {
+      apply_finger(id, successor);
+      continue;
+    }
+
+    const auto predecessors = router->closest_preceding_nodes(id);
+    const auto predecessor = std::find_if(predecessors.begin(), predecessors.end(), [&](const auto& n) {
+      return n != context.node() && !router->failure_detector().suspects(n);
+    });
+    if(predecessor == predecessors.end()) {
+      logger->warn("failed to fix fingers for {}: no preceding node", id);
+      continue;
+    }
+
+    auto req = make_request<SuccessorRequest>(context);
+    set_id(req, id, context.legacy_uuids);
+    call<SuccessorRequest, SuccessorResponse>(&async_interface::successor, "successor", *predecessor, id,
+        std::move(req), std::chrono::milliseconds(context.check_period_ms),
+        [this, id, round](const Status& status, const SuccessorResponse& res) {
+      if(!status.ok() || !res.has_successor()) {
+        logger->warn("failed to fix fingers for {}", id);
+        return;
+      }
+      apply_finger(id, make_node(res.successor()));
+    });
+  }
+}
+
+}  // namespace chord
@@ -1,8 +1,12 @@
 #include "chord.channel.pool.h"
 
+#include <algorithm>
+
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
 
 #include "chord.context.h"
 #include "chord.log.factory.h"
@@ -20,14 +24,47 @@ ChannelPool::ChannelPool(chord::Context &context)
 
 void ChannelPool::put(const node& node, std::shared_ptr<grpc::Channel> channel) {
   channels.put(node.uuid, channel);
+  bulk_channels.put(node.uuid, channel);
 }
 
-std::shared_ptr<grpc::Channel> ChannelPool::get(const node& node) {
-  return channels.compute_if_absent(node.uuid, [&]([[maybe_unused]] const uuid& key) { return ChannelPool::create_channel(node.endpoint); });
+std::shared_ptr<grpc::Channel> ChannelPool::get(const node& node, const lane which) {
+  auto& pool = which == lane::BULK ? bulk_channels : channels;
+  const auto create = [&]([[maybe_unused]] const uuid& key) {
+    return ChannelPool::create_channel(node.endpoint, context.channel_keepalive_ms);
+  };
+
+  auto channel = pool.compute_if_absent(node.uuid, create);
+  // transient failures are handled by the channel (reconnect with backoff)
+  if(channel->GetState(false) == GRPC_CHANNEL_SHUTDOWN) {
+    logger->debug("replacing shut down channel to {}", node);
+    pool.erase(node.uuid);
+    channel = pool.compute_if_absent(node.uuid, create);
+  }
+  return channel;
 }
 
 std::shared_ptr<grpc::Channel> ChannelPool::create_channel(const endpoint& endpoint) {
  return grpc::CreateChannel(endpoint, grpc::InsecureChannelCredentials());
 }
 
+std::shared_ptr<grpc::Channel> ChannelPool::create_channel(const endpoint& endpoint, const int keepalive_ms) {
+  grpc::ChannelArguments args;
+  // own connection per channel: the lanes to a peer do not share it
+  args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  if(keepalive_ms > 0) {
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, keepalive_ms);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, std::min(keepalive_ms, 10000));
+    args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+  }
+  return grpc::CreateCustomChannel(endpoint, grpc::InsecureChannelCredentials(), args);
+}
+
+void ChannelPool::configure(grpc::ServerBuilder& builder, const int keepalive_ms) {
+  if(keepalive_ms <= 0) return;
+  // accept the keepalive pings of the peers' channels
+  builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+  builder.AddChannelArgument(GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, keepalive_ms);
+  builder.AddChannelArgument(GRPC_ARG_HTTP2_MAX_PING_STRIKES, 0);
+}
+
 } // namespace chord
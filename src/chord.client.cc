@@ -4,9 +4,11 @@
 #include <fstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <grpcpp/channel.h>
 #include <grpcpp/create_channel.h>
+#include <grpcpp/server_context.h>
 
 #include "chord.grpc.pb.h"
 #include "chord.pb.h"
@@ -14,8 +16,10 @@
 #include "chord.log.h"
 #include "chord.context.h"
 #include "chord.common.h"
+#include "chord.deadline.h"
 #include "chord.exception.h"
 #include "chord.log.factory.h"
+#include "chord.maintenance.h"
 #include "chord.log.h"
 #include "chord.node.h"
 #include "chord.router.h"
@@ -24,6 +28,7 @@
 
 using grpc::Channel;
 using grpc::ClientContext;
+using grpc::ServerContext;
 using grpc::Status;
 
 using chord::common::Header;
@@ -33,6 +38,10 @@ using chord::common::make_entry;
 using chord::common::make_header;
 using chord::common::set_source;
 using chord::common::make_request;
+using chord::common::id_of;
+using chord::common::set_id;
+using chord::common::set_uuid;
+using chord::common::uuid_of;
 
 using chord::JoinResponse;
 using chord::JoinRequest;
@@ -58,16 +67,42 @@ Client::Client(const Context &context, Router *router, ChannelPool* channel_pool
 Client::Client(const Context &context, Router *router, ChannelPool* channel_pool, StubFactory make_stub)
     : context{context}, router{router}, channel_pool{channel_pool}, make_stub{std::move(make_stub)}, logger{context.logging.factory().get_or_create(logger_name)} {}
 
-void Client::init_context([[maybe_unused]] ClientContext& client_context) {
-  // left blank intentionally
-  std::chrono::system_clock::time_point deadline = std::chrono::system_clock::now() + std::chrono::seconds(60); //std::chrono::milliseconds(context.client_timeout_ms);
-  client_context.set_deadline(deadline);
+void Client::init_context(ClientContext& client_context, const std::string& rpc) {
+  deadline::set(client_context, deadline::of(context, rpc));
+}
+
+std::unique_ptr<ClientContext> Client::forward_context(const ServerContext* parent, const std::string& rpc) {
+  if(!parent) {
+    auto client_context = std::make_unique<ClientContext>();
+    init_context(*client_context, rpc);
+    return client_context;
+  }
+  // propagates the cancellation of the parent
+  auto client_context = ClientContext::FromServerContext(*parent);
+  deadline::set(*client_context, deadline::of(context, rpc, parent->deadline()));
+  return client_context;
+}
+
+Status Client::check_budget(const ServerContext* parent) const {
+  if(!parent) return Status::OK;
+  if(parent->IsCancelled()) {
+    return {grpc::StatusCode::CANCELLED, "request cancelled by the origin."};
+  }
+  if(deadline::exceeded(parent->deadline())) {
+    return {grpc::StatusCode::DEADLINE_EXCEEDED, "deadline of the origin exceeded."};
+  }
+  return Status::OK;
+}
+
+Status Client::record(const node& node, const Status& status) {
+  maintenance::record(context, *router, node, status);
+  return status;
 }
 
 Status Client::inform_about_leave(const node& node) {
   // inform node (successor || predecessor)
   ClientContext clientContext;
-  init_context(clientContext);
+  init_context(clientContext, "leave");
   auto req = make_request<LeaveRequest>(context);
   LeaveResponse res;
 
@@ -77,7 +112,7 @@ Status Client::inform_about_leave(const node& node) {
 
   auto entries = req.mutable_entries();
   for(const auto& node : router->get()) {
-   entries->Add(make_entry(node));
+   entries->Add(make_entry(node, context.legacy_uuids));
   }
   return make_stub(node)->leave(&clientContext, req, &res);
 }
@@ -124,11 +159,10 @@ void Client::leave() {
 }
 
 signal<const node>& Client::on_predecessor_fail() {
-  //return event_predecessor_fail;
   return router->on_predecessor_fail();
 }
 signal<const node>& Client::on_successor_fail() {
-  return event_successor_fail;
+  return router->on_successor_fail();
 }
 
 Status Client::join(const endpoint& addr) {
@@ -136,6 +170,7 @@ Status Client::join(const endpoint& addr) {
 
 
   ClientContext clientContext;
+  init_context(clientContext, "join");
   auto req = make_request<JoinRequest>(context);
   auto stub = Chord::NewStub(ChannelPool::create_channel(addr));
 
@@ -160,21 +195,23 @@ Status Client::join(const endpoint& addr) {
 }
 
 Status Client::join(const JoinRequest *req, JoinResponse *res) {
-  ClientContext clientContext;
-  init_context(clientContext);
-  return join(&clientContext, req, res);
+  return join(nullptr, req, res);
 }
 
-Status Client::join(ClientContext *clientContext, const JoinRequest *req, JoinResponse *res) {
+Status Client::join(const ServerContext *parent, const JoinRequest *req, JoinResponse *res) {
 
-  logger->trace("forwarding join of {}", req->header().src().uuid());
+  const auto src = uuid_of(req->header().src());
+  logger->trace("forwarding join of {}", src);
   JoinRequest copy(*req);
 
-  const auto predecessors = router->closest_preceding_nodes(uuid_t(req->header().src().uuid()));
+  const auto predecessors = router->closest_preceding_nodes(src);
 
   for(const auto& predecessor:predecessors) {
+    if(router->failure_detector().suspects(predecessor)) continue;
+    if(const auto budget = check_budget(parent); !budget.ok()) return budget;
     logger->trace("forwarding request to {}", predecessor);
-    const auto status = make_stub(predecessor)->join(clientContext, copy, res);
+    const auto clientContext = forward_context(parent, "join");
+    const auto status = record(predecessor, make_stub(predecessor)->join(clientContext.get(), copy, res));
     if(status.ok()) return status;
   }
 
@@ -184,7 +221,7 @@ Status Client::join(ClientContext *clientContext, const JoinRequest *req, JoinRe
 
 void Client::stabilize() {
   ClientContext clientContext;
-  init_context(clientContext);
+  init_context(clientContext, "stabilize");
   auto req = make_request<StabilizeRequest>(context);
   StabilizeResponse res;
 
@@ -196,33 +233,12 @@ void Client::stabilize() {
     return;
   }
 
-  const auto endpoint = successor->endpoint;
+  logger->trace("[stabilize] calling stabilize on successor {}", successor->endpoint);
+  const auto status = record(*successor, make_stub(*successor)->stabilize(&clientContext, req, &res));
 
-  logger->trace("[stabilize] calling stabilize on successor {}", endpoint);
-  const auto status = make_stub(*successor)->stabilize(&clientContext, req, &res);
-
-  if (!status.ok()) {
-    logger->warn("[stabilize] failed - removing endpoint {}?", endpoint);
-    router->remove(*successor);
-    event_successor_fail(*successor);
-    return;
+  if(maintenance::stabilized(context, *router, *logger, *successor, status, res)) {
+    notify();
   }
-
-  if (res.has_predecessor()) {
-    const auto pred = make_node(res.predecessor());
-    logger->trace("received stabilize response with predecessor {}", pred);
-
-    const uuid_t self(context.uuid());
-    const uuid_t succ(successor->uuid); //router->successor()->uuid); TODO do we really need to re-fetch the successor from router?
-    if(uuid::between(self, pred.uuid, succ)) {
-      router->update(pred);
-      //router->set_successor(0, pred);
-    }
-  } else {
-    logger->trace("received empty routing entry");
-  }
-
-  notify();
 }
 
 Status Client::notify(const node& target, const node& old_node, const node& new_node) {
@@ -232,7 +248,7 @@ Status Client::notify(const node& target, const node& old_node, const node& new_
   const auto endpoint = target.endpoint;
 
   ClientContext clientContext;
-  init_context(clientContext);
+  init_context(clientContext, "notify");
   auto req = make_request<NotifyRequest>(context);
   NotifyResponse res;
 
@@ -240,12 +256,12 @@ Status Client::notify(const node& target, const node& old_node, const node& new_
 
   // TODO rename proto
   const auto old_node_ = req.mutable_old_node();
-  old_node_->set_uuid(old_node.uuid);
+  set_uuid(*old_node_, old_node.uuid, context.legacy_uuids);
   old_node_->set_endpoint(old_node.endpoint);
   const auto new_node_ = req.mutable_new_node();
-  new_node_->set_uuid(new_node.uuid);
+  set_uuid(*new_node_, new_node.uuid, context.legacy_uuids);
   new_node_->set_endpoint(new_node.endpoint);
-  return make_stub(target)->notify(&clientContext, req, &res);
+  return record(target, make_stub(target)->notify(&clientContext, req, &res));
 }
 
 Status Client::notify() {
@@ -258,36 +274,42 @@ Status Client::notify() {
   }
 
   ClientContext clientContext;
-  init_context(clientContext);
+  init_context(clientContext, "notify");
   auto req = make_request<NotifyRequest>(context);
   NotifyResponse res;
 
   logger->trace("calling notify on address {}", successor);
 
-  return make_stub(*successor)->notify(&clientContext, req, &res);
+  return record(*successor, make_stub(*successor)->notify(&clientContext, req, &res));
 }
 
 Status Client::ping(const node& node) {
+  // this node is alive - no need for a loopback call
+  if(node == context.node()) return Status::OK;
+
   ClientContext clientContext;
-  init_context(clientContext);
+  init_context(clientContext, "ping");
   auto req = make_request<PingRequest>(context);
   PingResponse res;
 
   logger->trace("[ping] {}", node);
 
-  return make_stub(node)->ping(&clientContext, req, &res);
+  return record(node, make_stub(node)->ping(&clientContext, req, &res));
 }
 
-Status Client::successor([[maybe_unused]] ClientContext *clientContext, const SuccessorRequest *req, SuccessorResponse *res) {
+Status Client::successor(const ServerContext *parent, const SuccessorRequest *req, SuccessorResponse *res) {
 
-  logger->trace("[successor] trying to find successor of {}", req->id());
+  const auto id = id_of(*req);
+  logger->trace("[successor] trying to find successor of {}", id);
   SuccessorRequest copy(*req);
   copy.mutable_header()->CopyFrom(make_header(context));
 
-  const auto predecessors = router->closest_preceding_nodes(uuid{req->id()});
+  const auto predecessors = router->closest_preceding_nodes(id);
   for(const auto& predecessor : predecessors) {
-    ClientContext ctxt;
-    const auto status = make_stub(predecessor)->successor(&ctxt, copy, res);
+    if(router->failure_detector().suspects(predecessor)) continue;
+    if(const auto budget = check_budget(parent); !budget.ok()) return budget;
+    const auto clientContext = forward_context(parent, "successor");
+    const auto status = record(predecessor, make_stub(predecessor)->successor(clientContext.get(), copy, res));
     if(status.ok()) return status;
   }
 
@@ -296,17 +318,15 @@ Status Client::successor([[maybe_unused]] ClientContext *clientContext, const Su
 
 /** called by chord.service **/
 Status Client::successor(const SuccessorRequest *req, SuccessorResponse *res) {
-  ClientContext clientContext;
-  return successor(&clientContext, req, res);
+  return successor(nullptr, req, res);
 }
 
 RouterEntry Client::successor(const uuid_t &uuid) {
-  ClientContext clientContext;
   auto req = make_request<SuccessorRequest>(context);
-  req.set_id(uuid);
+  set_id(req, uuid, context.legacy_uuids);
   SuccessorResponse res;
 
-  const auto status = successor(&clientContext, &req, &res);
+  const auto status = successor(nullptr, &req, &res);
 
   if (!status.ok()) throw__grpc_exception(status);
 
@@ -327,21 +347,12 @@ void Client::check() {
   }
 
   ClientContext clientContext;
+  init_context(clientContext, "ping");
   auto req = make_request<PingRequest>(context);
   PingResponse res;
 
-  const auto endpoint = predecessor->endpoint;//router->get(predecessor);
-
   logger->trace("[check] checking predecessor {}", *predecessor);
-  const auto status = make_stub(*predecessor)->ping(&clientContext, req, &res);
-
-  if (!status.ok()) {
-    logger->warn("[check] predecessor failed.");
-    router->remove(*predecessor);
-    //we format the router's event
-    //event_predecessor_fail(*predecessor);
-  } else if(!res.has_header()) {
-    logger->error("[check] returned without header, should remove endpoint {}@{}?", *predecessor, endpoint);
-  }
+  const auto status = record(*predecessor, make_stub(*predecessor)->ping(&clientContext, req, &res));
+  maintenance::checked(*router, *logger, *predecessor, status, res);
 }
 }
@@ -20,7 +20,7 @@ chord::common::Header make_header(const chord::node &node) {
 chord::common::Header make_header(const Context &context) {
   Header header;
   RouterEntry src;
-  src.set_uuid(context.uuid());
+  set_uuid(src, context.uuid(), context.legacy_uuids);
   src.set_endpoint(context.advertise_addr);
   header.mutable_src()->CopyFrom(src);
   return header;
@@ -32,22 +32,31 @@ chord::node make_node(const grpc::ServerContext* context, const RouterEntry& ent
   if(pos != std::string::npos) {
     const auto advertised_port = host.substr(pos+1);
     const auto peer = context->peer();
-    return {uuid_t{entry.uuid()}, peer.substr(0, peer.rfind(':')) + ":" + advertised_port};
+    return {uuid_of(entry), peer.substr(0, peer.rfind(':')) + ":" + advertised_port};
   }
   const auto peer = context->peer();
-  return {uuid_t{entry.uuid()}, entry.endpoint() };
+  return {uuid_of(entry), entry.endpoint() };
 }
 
 chord::node make_node(const RouterEntry& entry) {
-  return {uuid_t{entry.uuid()}, entry.endpoint()};
+  return {uuid_of(entry), entry.endpoint()};
 }
 
-RouterEntry make_entry(const chord::node& node) {
+RouterEntry make_entry(const chord::node& node, const bool legacy_uuids) {
   RouterEntry ret;
-  ret.set_uuid(node.uuid);
+  set_uuid(ret, node.uuid, legacy_uuids);
   ret.set_endpoint(node.endpoint);
   return ret;
 }
 
+uuid_t uuid_of(const RouterEntry& entry) {
+  return entry.uuid_bin().empty() ? uuid_t{entry.uuid()} : uuid_t::from_bytes(entry.uuid_bin());
+}
+
+void set_uuid(RouterEntry& entry, const uuid_t& uuid, const bool legacy_uuids) {
+  entry.set_uuid_bin(uuid.bytes());
+  if(legacy_uuids) entry.set_uuid(uuid);
+}
+
 }
 }
@@ -28,5 +28,14 @@ void Context::validate(const Context& context) {
     if(context.meta_directory == context.data_directory) {
       throw__exception("Meta directory must not be equal to data directory.");
     }
+    if(context.meta_write_buffer_mb == 0) {
+      throw__exception("Meta write buffer size must be positive.");
+    }
+    if(context.meta_background_jobs <= 0) {
+      throw__exception("Meta background jobs must be positive.");
+    }
+    if(context.fs_async_server && (context.fs_max_concurrency == 0 || context.fs_replication_threads == 0)) {
+      throw__exception("Concurrency and replication threads of the async filesystem server must be positive.");
+    }
 }
 } //namespace chord
@@ -6,6 +6,7 @@
 //#include <yaml-cpp/node/node.h>          // for Node
 //#include <yaml-cpp/node/parse.h>         // for Load, LoadFile
 #include <functional>
+#include <map>
 #include <set>
 #include <utility>
 
@@ -165,6 +166,17 @@ namespace chord {
 void operator>>(const YAML::Node& node, Context& context) {
   read(node, "data-directory", context.data_directory);
   read(node, "meta-directory", context.meta_directory);
+  read(node, "meta-block-cache-mb", context.meta_block_cache_mb);
+  read(node, "meta-bloom-bits-per-key", context.meta_bloom_bits_per_key);
+  read(node, "meta-compression", context.meta_compression);
+  read(node, "meta-write-buffer-mb", context.meta_write_buffer_mb);
+  read(node, "meta-background-jobs", context.meta_background_jobs);
+  read(node, "meta-disable-wal", context.meta_disable_wal);
+  read(node, "meta-cache-size", context.meta_cache_size);
+  read(node, "successor-cache-size", context.successor_cache_size);
+  read(node, "successor-cache-ttl-ms", context.successor_cache_ttl_ms);
+  read(node, "successor-list-size", context.successor_list_size);
+  read(node, "legacy-uuids", context.legacy_uuids);
   read(node, "bind-addr", context.bind_addr);
   read(node, "advertise-addr", context.advertise_addr, context.bind_addr);
   read(node, "join-addr", context.join_addr);
@@ -175,7 +187,31 @@ void operator>>(const YAML::Node& node, Context& context) {
   read(node, "register_shutdown_handler", context.register_shutdown_handler);
   read(node, "stabilize-ms", context.stabilize_period_ms);
   read(node, "check-ms", context.check_period_ms);
+  read(node, "failure-phi-threshold", context.failure_phi_threshold);
+  read(node, "failure-max-count", context.failure_max_count);
+  read(node, "client-timeout-ms", context.client_timeout_ms);
+  read(node, "channel-keepalive-ms", context.channel_keepalive_ms);
+  // override the defaults of the given rpcs only
+  std::map<std::string, int> rpc_timeouts_ms;
+  if(read(node, "rpc-timeouts-ms", rpc_timeouts_ms)) {
+    for(const auto& [rpc, timeout] : rpc_timeouts_ms) {
+      context.rpc_timeouts_ms[rpc] = timeout;
+    }
+  }
+  read(node, "fix-fingers-adaptive", context.fix_fingers_adaptive);
+  read(node, "fix-fingers-min-ms", context.fix_fingers_min_period_ms);
+  read(node, "async-maintenance", context.async_maintenance);
+  read(node, "fs-async-server", context.fs_async_server);
+  read(node, "fs-max-concurrency", context.fs_max_concurrency);
+  read(node, "fs-replication-threads", context.fs_replication_threads);
+  read(node, "fs-hash-cache", context.fs_hash_cache);
+  read(node, "fs-delta-uploads", context.fs_delta_uploads);
+  read(node, "fs-chunk-store", context.fs_chunk_store);
+  read(node, "fs-get-range-mb", context.fs_get_range_mb);
+  read(node, "fs-resumable-puts", context.fs_resumable_puts);
+  read(node, "fs-partial-expiry-h", context.fs_partial_expiry_h);
   read(node, "replication-count", context.replication_cnt);
+  read(node, "pipelined-replication", context.pipelined_replication);
 
   set(node, "uuid", std::function<void(uuid_t)>([&](auto v) {context.set_uuid(v);}));
 
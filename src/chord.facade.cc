@@ -1,5 +1,8 @@
 #include "chord.facade.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <grpcpp/server_context.h>
@@ -29,8 +32,12 @@ ChordFacade::ChordFacade(Context& ctx, ChannelPool* channel_pool)
       client{make_unique<Client>(context, router.get(), channel_pool)},
       service{make_unique<Service>(context, router.get(), client.get())},
       scheduler{make_unique<Scheduler>()},
-      logger{ctx.logging.factory().get_or_create(logger_name)}
-      {}
+      _successor_cache{ctx.successor_cache_size, std::chrono::milliseconds(ctx.successor_cache_ttl_ms)},
+      logger{ctx.logging.factory().get_or_create(logger_name)},
+      async_client{ctx.async_maintenance ? make_unique<AsyncClient>(context, router.get(), channel_pool) : nullptr}
+      {
+        init_successor_cache();
+      }
 
 /**
  * Used for testing purposes.
@@ -41,8 +48,22 @@ ChordFacade::ChordFacade(Context& ctx, Router* router, IClient* client, IService
       client{client},
       service{service},
       scheduler{make_unique<Scheduler>()},
+      _successor_cache{ctx.successor_cache_size, std::chrono::milliseconds(ctx.successor_cache_ttl_ms)},
       logger{ctx.logging.factory().get_or_create(logger_name)}
-      {}
+      {
+        init_successor_cache();
+      }
+
+/**
+ * the owners of the cached key ranges change with the ring
+ */
+void ChordFacade::init_successor_cache() {
+  if(!_successor_cache.enabled()) return;
+  router->on_successor_update().connect([this](const node&, const node&) { _successor_cache.clear(); });
+  router->on_predecessor_update().connect([this](const node&, const node&) { _successor_cache.clear(); });
+  router->on_successor_fail().connect([this](const node&) { _successor_cache.clear(); });
+  router->on_predecessor_fail().connect([this](const node&) { _successor_cache.clear(); });
+}
 
 ::grpc::Service* ChordFacade::grpc_service() {
   return service->grpc_service();
@@ -51,6 +72,7 @@ ChordFacade::ChordFacade(Context& ctx, Router* router, IClient* client, IService
 void ChordFacade::stop() {
   logger->trace("shutting down scheduler...");
   stop_scheduler();
+  if(async_client) async_client->wait();
   logger->trace("shutting down chord...");
   leave();
 }
@@ -85,15 +107,85 @@ void ChordFacade::start_scheduler() {
     check_predecessor();
   });
 
+  //--- evict failed nodes
+  scheduler->schedule(chrono::milliseconds(context.stabilize_period_ms), [this] {
+    evict_failed_nodes();
+  });
+
   //--- fix fingers
+  if(context.fix_fingers_adaptive) {
+    router->on_successor_fail().connect([this](const node&) { fingers_churn(); });
+    router->on_predecessor_fail().connect([this](const node&) { fingers_churn(); });
+    router->on_predecessor_update().connect([this](const node&, const node&) { fingers_churn(); });
+    fingers_churn();
+    schedule_fix_fingers();
+    return;
+  }
+
   scheduler->schedule(chrono::milliseconds(context.check_period_ms), [this] {
     next = (next + 1) % Router::BITS;
     logger->trace("fix fingers with next index next: {}", next);
+    if(async_client) {
+      async_client->fix_fingers({next});
+      return;
+    }
     fix_fingers(next);
     logger->trace("[dump] {}", *router);
   });
 }
 
+void ChordFacade::schedule_fix_fingers() {
+  chrono::milliseconds period;
+  {
+    std::scoped_lock<std::mutex> lock(fingers_mtx);
+    period = fingers_period;
+  }
+  scheduler->schedule(chrono::system_clock::now() + period, [this] {
+    if(async_client) {
+      // the next round is scheduled once the probes of this round completed
+      const auto before = router->get();
+      const auto indices = router->intervals();
+      async_client->fix_fingers(indices, [this, before, intervals = indices.size()] {
+        fingers_round(router->get() != before, intervals);
+        logger->trace("[dump] {}", *router);
+        schedule_fix_fingers();
+      });
+      return;
+    }
+    fix_fingers();
+    logger->trace("[dump] {}", *router);
+    schedule_fix_fingers();
+  });
+}
+
+chrono::milliseconds ChordFacade::fingers_min_period() const {
+  return chrono::milliseconds(std::min(context.fix_fingers_min_period_ms, context.check_period_ms));
+}
+
+/**
+ * remove the nodes suspected by the failure detector from the router
+ */
+void ChordFacade::evict_failed_nodes() {
+  auto& detector = router->failure_detector();
+  for(const auto& uuid : detector.suspected()) {
+    logger->warn("[evict] {} is suspected to have failed - removing from router.", uuid);
+    router->remove(uuid);
+    detector.remove(uuid);
+  }
+}
+
+/**
+ * join or churn: repair the finger table at the highest rate
+ */
+void ChordFacade::fingers_churn() {
+  std::scoped_lock<std::mutex> lock(fingers_mtx);
+  fingers_period = fingers_min_period();
+  if(!fingers_unstable_since) {
+    fingers_unstable_since = clock::now();
+    fingers_convergence.reset();
+  }
+}
+
 /**
  * leave chord ring
  */
@@ -141,19 +233,58 @@ void ChordFacade::join() {
 /**
  * successor
  */
-chord::node ChordFacade::successor(const uuid_t &uuid) {
-  return make_node(service->successor(uuid));
+chord::node ChordFacade::successor(const uuid_t &uuid, const bool cached) {
+  // keys between our predecessor and us are owned by this node
+  if(const auto predecessor = router->predecessor();
+      predecessor && uuid::between(predecessor->uuid, uuid, context.uuid())) {
+    return context.node();
+  }
+  if(!cached || !_successor_cache.enabled()) {
+    return make_node(service->successor(uuid));
+  }
+  if(const auto owner = _successor_cache.get(uuid)) {
+    logger->trace("[successor] cached owner of {}: {}", uuid, *owner);
+    return *owner;
+  }
+
+  const auto generation = _successor_cache.generation();
+  std::uint32_t hops = 0;
+  const auto owner = make_node(service->successor(uuid, hops));
+  _successor_cache.put(uuid, owner, hops, generation);
+  logger->trace("[successor] cache hit ratio {:.2f}, saved {} hops", _successor_cache.hit_ratio(), _successor_cache.hops_saved());
+  return owner;
 }
 
 chord::node ChordFacade::successor() {
   return make_node(service->successor(context.uuid()));
 }
 
+std::vector<chord::node> ChordFacade::successors() const {
+  return router->successors();
+}
+
+bool ChordFacade::is_responsible(const uuid_t &uuid) const {
+  const auto predecessor = router->predecessor();
+  return !predecessor || uuid == context.uuid() || uuid::between(predecessor->uuid, uuid, context.uuid());
+}
+
+bool ChordFacade::invalidate(const uuid_t &uuid) {
+  return _successor_cache.invalidate(uuid);
+}
+
+const SuccessorCache& ChordFacade::successor_cache() const {
+  return _successor_cache;
+}
+
 /**
  * stabilize the ring
  */
 void ChordFacade::stabilize() {
-  client->stabilize();
+  if(async_client) {
+    async_client->stabilize();
+  } else {
+    client->stabilize();
+  }
   // lost connection and we know where to join -> re-join
   if(!router->has_successor() && !context.join_addr.empty()) {
     join();
@@ -164,6 +295,10 @@ void ChordFacade::stabilize() {
  * check predecessor
  */
 void ChordFacade::check_predecessor() {
+  if(async_client) {
+    async_client->check();
+    return;
+  }
   client->check();
 }
 
@@ -174,6 +309,43 @@ void ChordFacade::fix_fingers(size_t index) {
   service->fix_fingers(index);
 }
 
+bool ChordFacade::fix_fingers() {
+  const auto before = router->get();
+  // indices resolving to the same node are skipped
+  const auto indices = router->intervals();
+  logger->trace("fix fingers for {} intervals", indices.size());
+  for(const auto index:indices) {
+    fix_fingers(index);
+  }
+  return fingers_round(router->get() != before, indices.size());
+}
+
+/**
+ * adapt the period of the next round to the outcome of the last one
+ */
+bool ChordFacade::fingers_round(const bool changed, const size_t intervals) {
+  if(changed) {
+    fingers_churn();
+    return changed;
+  }
+
+  // stable: back off to the check period
+  std::scoped_lock<std::mutex> lock(fingers_mtx);
+  fingers_period = std::min(std::max(fingers_period * 2, fingers_min_period()),
+                            chrono::milliseconds(context.check_period_ms));
+  if(fingers_unstable_since) {
+    fingers_convergence = chrono::duration_cast<chrono::milliseconds>(clock::now() - *fingers_unstable_since);
+    fingers_unstable_since.reset();
+    logger->info("finger table converged after {}ms ({} intervals)", fingers_convergence->count(), intervals);
+  }
+  return changed;
+}
+
+std::optional<chrono::milliseconds> ChordFacade::fingers_convergence_time() {
+  std::scoped_lock<std::mutex> lock(fingers_mtx);
+  return fingers_convergence;
+}
+
 ChordFacade::event_unary_t& ChordFacade::on_join() {
   return event_join;
 }
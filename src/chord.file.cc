@@ -5,7 +5,6 @@
 #include <algorithm>
 #include <iterator>
 #include <fstream>
-#include <limits>
 #include <filesystem>
 
 #include "chord.exception.h"
@@ -103,7 +102,7 @@ bool file::create_directories(const std::string &path) {
 
 bool file::has_attr(const std::string &path, const std::string &name) {
   const auto read = ::getxattr(path.c_str(), name.c_str(), nullptr, 0);
-  if (read == std::numeric_limits<decltype(read)>::max()) return false;
+  if (read < 0) return false;
 
   return true;
 }
@@ -112,7 +111,7 @@ bool file::has_attr(const std::string &path, const std::string &name) {
 std::optional<std::string> file::attr(const std::string &path, const std::string &name) {
   using namespace std::string_literals;
   auto read = ::getxattr(path.c_str(), name.c_str(), nullptr, 0);
-  if (read == std::numeric_limits<decltype(read)>::max()) return {};
+  if (read < 0) return {};
 
 #if __cplusplus >= 201703L
   std::string value; value.resize(read);
@@ -123,7 +122,7 @@ std::optional<std::string> file::attr(const std::string &path, const std::string
   std::string value(buffer, read);
   delete[] buffer;
 #endif
-  if (read == std::numeric_limits<decltype(read)>::max())
+  if (read < 0)
     throw__exception("failed to get xattr"s + strerror(errno));
 
   return value;
@@ -133,7 +132,7 @@ std::optional<std::string> file::attr(const std::string &path, const std::string
 bool file::attr(const std::string &path, const std::string &name, const std::string &value) {
   using namespace std::string_literals;
   const auto err = ::setxattr(path.c_str(), name.c_str(), value.data(), value.size(), 0);
-  if (err == std::numeric_limits<decltype(err)>::max())
+  if (err < 0)
     throw__exception("failed to set xattr"s + strerror(errno));
 
   return true;
@@ -142,7 +141,7 @@ bool file::attr(const std::string &path, const std::string &name, const std::str
 bool file::attr_remove(const std::string &path, const std::string &name) {
   using namespace std::string_literals;
   const auto err = ::removexattr(path.c_str(), name.c_str());
-  if (err == std::numeric_limits<decltype(err)>::max()) return false;
+  if (err < 0) return false;
 
   return true;
 }
@@ -0,0 +1,523 @@
+#include "chord.fs.callback.service.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <grpcpp/impl/codegen/status_code_enum.h>
+
+#include "chord.common.h"
+#include "chord.context.h"
+#include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.fs.chunk.manifest.h"
+#include "chord.fs.chunk.recipe.h"
+#include "chord.fs.client.options.h"
+#include "chord.fs.context.metadata.h"
+#include "chord.fs.monitor.h"
+#include "chord.fs.partial.upload.h"
+#include "chord.fs.service.h"
+#include "chord.log.factory.h"
+#include "chord.log.h"
+#include "chord.uri.h"
+
+using grpc::CallbackServerContext;
+using grpc::ServerUnaryReactor;
+using grpc::Status;
+using grpc::StatusCode;
+
+using chord::fs::PutRequest;
+using chord::fs::PutResponse;
+using chord::fs::GetRequest;
+using chord::fs::GetResponse;
+using chord::fs::DelRequest;
+using chord::fs::DelResponse;
+using chord::fs::MovRequest;
+using chord::fs::MovResponse;
+using chord::fs::MetaRequest;
+using chord::fs::MetaResponse;
+using chord::fs::ChunksRequest;
+using chord::fs::ChunksResponse;
+using chord::fs::MissingRequest;
+using chord::fs::MissingResponse;
+using chord::fs::AssembleRequest;
+
+using namespace std;
+
+namespace chord {
+namespace fs {
+
+namespace {
+void submit(Scheduler& executor, std::function<void()> task) {
+  executor.schedule(std::chrono::system_clock::now(), std::move(task));
+}
+
+/**
+ * options of the replication done after responding - no longer bounded
+ * by the deadline of the client
+ */
+client::options detached(client::options options) {
+  options.deadline.reset();
+  return options;
+}
+} // namespace
+
+void CallbackService::Slots::acquire(std::function<void()> admitted) {
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    if(available == 0) {
+      waiting.push_back(std::move(admitted));
+      return;
+    }
+    --available;
+  }
+  admitted();
+}
+
+void CallbackService::Slots::release() {
+  std::function<void()> next;
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    if(waiting.empty()) {
+      ++available;
+      return;
+    }
+    next = std::move(waiting.front());
+    waiting.pop_front();
+  }
+  next();
+}
+
+/**
+ * receives the file chunk by chunk - every chunk is written by the put
+ * executor before the next one is read.
+ */
+class CallbackService::PutReactor : public grpc::ServerReadReactor<PutRequest> {
+  CallbackService* callback_service;
+  CallbackServerContext* server_context;
+
+  client::options options;
+  chord::uri uri{"chord:///"};
+  chord::path data;
+  std::optional<monitor::lock> lock;
+  std::fstream file;
+  bool hashes_equal{false};
+  // delta put: size of the file once the changed chunks are written
+  std::optional<std::uint64_t> delta_size;
+  std::optional<ChunkManifest::Builder> chunks;
+  // resumable put: received into the journal
+  std::unique_ptr<PartialUpload> upload;
+  PutRequest req;
+
+  void begin() {
+    auto* service = callback_service->service;
+    options = ContextMetadata::from(server_context);
+    const auto status = service->is_valid(options, fs::Service::RequestType::PUT);
+    if(!status.ok()) {
+      Finish(status);
+      return;
+    }
+
+    try {
+      uri = ContextMetadata::uri_from(server_context);
+      if(const auto status = service->is_responsible(uri, options); !status.ok()) {
+        Finish(status);
+        return;
+      }
+      data = service->data_path(uri);
+
+      lock.emplace(service->monitor, monitor::event::filter{data, chord::fs::monitor::event::flag::CREATED});
+
+      hashes_equal = service->file_hashes_equal(server_context);
+      const auto base = service->delta_base(server_context, uri, hashes_equal);
+      if(!hashes_equal && !base) {
+        const auto status = service->resumable_upload(server_context, uri, upload);
+        if(!status.ok()) {
+          Finish(status);
+          return;
+        }
+      }
+
+      // empty file was put
+      if(!upload && !file::exists(data) && !service->stored_recipe(uri)) {
+        chord::file::create_file(data);
+      }
+
+      if(!hashes_equal) {
+        const auto resumed = upload && upload->offset() > 0;
+        callback_service->logger->trace("[put] {}{}", data, base ? " (delta)" : resumed ? " (resumed)" : "");
+        if(base) {
+          delta_size = ContextMetadata::file_size_from(server_context);
+          chunks.emplace(*base);
+        } else if(!resumed) {
+          chunks.emplace();
+        }
+        // a delta put overwrites the changed chunks only
+        if(!upload) {
+          file.exceptions(ifstream::failbit | ifstream::badbit);
+          file.open(data, base ? fstream::binary | fstream::in | fstream::out : fstream::binary | fstream::out | fstream::trunc);
+        }
+      }
+    } catch(const std::exception& error) {
+      callback_service->logger->error("[put] {}, reason: {}", data, error.what());
+      Finish(Status::CANCELLED);
+      return;
+    }
+
+    StartSendInitialMetadata();
+    if(hashes_equal) {
+      complete();
+    } else {
+      StartRead(&req);
+    }
+  }
+
+  void write() {
+    try {
+      if(upload) {
+        upload->write(req.offset(), req.data().data(), req.size());
+      } else {
+        file.seekp(static_cast<std::streamoff>(req.offset()));
+        file.write(req.data().data(), static_cast<std::streamsize>(req.size()));
+      }
+      if(chunks) chunks->write(req.offset(), req.data().data(), req.size());
+    } catch(const ios_base::failure& error) {
+      callback_service->logger->error("[put] {}, reason: {}", data, error.what());
+      Finish(Status::CANCELLED);
+      return;
+    } catch(const chord::exception& error) {
+      callback_service->logger->error("[put] {}, reason: {}", data, error.what());
+      Finish({StatusCode::DATA_LOSS, error.what()});
+      return;
+    }
+    StartRead(&req);
+  }
+
+  void complete() {
+    if(upload) {
+      if(!upload->complete()) {
+        // kept to be resumed
+        callback_service->logger->info("[put] interrupted {} at {}", uri, upload->offset());
+        Finish({StatusCode::ABORTED, fmt::format("incomplete put, received {} bytes", upload->offset())});
+        return;
+      }
+      try {
+        upload->finish(data);
+      } catch(const std::exception& error) {
+        callback_service->logger->error("[put] {}, reason: {}", data, error.what());
+        Finish({StatusCode::DATA_LOSS, error.what()});
+        return;
+      }
+    }
+
+    try {
+      if(file.is_open()) file.close();
+      if(delta_size) chord::file::resize_file(data, *delta_size);
+      lock.reset();
+      callback_service->service->commit_put(uri, options, chunks ? &*chunks : nullptr);
+    } catch(const std::exception& error) {
+      callback_service->logger->error("[put] {}, reason: {}", data, error.what());
+      Finish(Status::CANCELLED);
+      return;
+    }
+
+    // the reactor might be deleted once finished
+    auto* service = callback_service->service;
+    submit(callback_service->replication_executor, [service, uri = uri, options = detached(options)] {
+      service->replicate_put(uri, options);
+    });
+    Finish(Status::OK);
+  }
+
+ public:
+  PutReactor(CallbackService* callback_service, CallbackServerContext* server_context)
+    : callback_service{callback_service}, server_context{server_context} {
+    callback_service->put_slots.acquire([this] {
+      submit(this->callback_service->put_executor, [this] { begin(); });
+    });
+  }
+
+  void OnSendInitialMetadataDone(bool) override {}
+
+  void OnReadDone(bool ok) override {
+    auto& executor = callback_service->put_executor;
+    if(ok) {
+      submit(executor, [this] { write(); });
+    } else if(server_context->IsCancelled()) {
+      Finish(Status::CANCELLED);
+    } else {
+      // client finished writing
+      submit(executor, [this] { complete(); });
+    }
+  }
+
+  void OnDone() override {
+    auto* service = callback_service;
+    delete this;
+    service->put_slots.release();
+  }
+};
+
+/**
+ * sends the file chunk by chunk - every chunk is read by the get
+ * executor once the previous one has been written.
+ */
+class CallbackService::GetReactor : public grpc::ServerWriteReactor<GetResponse> {
+  //TODO make configurable (see chord.client)
+  static constexpr size_t len = static_cast<long>(512)*1024; // 512k
+
+  CallbackService* callback_service;
+  const GetRequest* req;
+
+  std::unique_ptr<std::istream> file;
+  std::vector<char> buffer;
+  size_t offset{0};
+  // bytes of the requested range left to send
+  std::uint64_t remaining{0};
+  GetResponse res;
+
+  void begin() {
+    auto* service = callback_service->service;
+    try {
+      const auto uri = chord::uri::from(req->uri());
+      chord::path data;
+      const auto status = service->restore(uri, data);
+      if(!status.ok()) {
+        Finish(status);
+        return;
+      }
+
+      callback_service->logger->trace("[get] trying to get {} ({}+{})", data, req->offset(), req->length());
+      file = service->open(uri);
+      // a short read at the end of the file is no failure
+      file->exceptions(ifstream::badbit);
+      const auto seeked = service->seek(*file, *req, remaining);
+      if(!seeked.ok()) {
+        Finish(seeked);
+        return;
+      }
+      offset = req->offset();
+    } catch(const std::exception& error) {
+      callback_service->logger->error("[get] failed to get {}, reason: {}", req->uri(), error.what());
+      Finish(Status::CANCELLED);
+      return;
+    }
+    buffer.resize(len);
+    next();
+  }
+
+  void next() {
+    size_t read = 0;
+    try {
+      file->read(buffer.data(), static_cast<std::streamsize>(std::min<std::uint64_t>(len, remaining)));
+      read = static_cast<size_t>(file->gcount());
+    } catch(const std::exception& error) {
+      callback_service->logger->error("[get] failed to read {}, reason: {}", req->uri(), error.what());
+      Finish(Status::CANCELLED);
+      return;
+    }
+
+    if(read == 0) {
+      Finish(Status::OK);
+      return;
+    }
+
+    res.Clear();
+    //TODO validate hashes
+    chord::common::set_id(res, chord::common::id_of(*req), callback_service->context.legacy_uuids);
+    res.set_data(buffer.data(), read);
+    res.set_offset(offset);
+    res.set_size(read);
+    offset += read;
+    remaining -= read;
+    StartWrite(&res);
+  }
+
+ public:
+  GetReactor(CallbackService* callback_service, const GetRequest* req)
+    : callback_service{callback_service}, req{req} {
+    callback_service->get_slots.acquire([this] {
+      submit(this->callback_service->get_executor, [this] { begin(); });
+    });
+  }
+
+  void OnWriteDone(bool ok) override {
+    if(!ok) {
+      Finish(Status::CANCELLED);
+      return;
+    }
+    submit(callback_service->get_executor, [this] { next(); });
+  }
+
+  void OnDone() override {
+    auto* service = callback_service;
+    delete this;
+    service->get_slots.release();
+  }
+};
+
+/**
+ * receives the recipe of a file of the chunk store and the chunks
+ * missing on this node - every request is processed by the put
+ * executor before the next one is read.
+ */
+class CallbackService::AssembleReactor : public grpc::ServerReadReactor<AssembleRequest> {
+  CallbackService* callback_service;
+  CallbackServerContext* server_context;
+
+  client::options options;
+  chord::uri uri{"chord:///"};
+  ChunkRecipe recipe;
+  AssembleRequest req;
+
+  void begin() {
+    auto* service = callback_service->service;
+    options = ContextMetadata::from(server_context);
+    const auto status = service->is_valid(options, fs::Service::RequestType::PUT);
+    if(!status.ok()) {
+      Finish(status);
+      return;
+    }
+    if(!service->chunk_store) {
+      Finish({StatusCode::UNIMPLEMENTED, "chunk store disabled."});
+      return;
+    }
+    uri = ContextMetadata::uri_from(server_context);
+    if(const auto status = service->is_responsible(uri, options); !status.ok()) {
+      Finish(status);
+      return;
+    }
+    StartRead(&req);
+  }
+
+  void add() {
+    const auto status = callback_service->service->assemble(req, recipe);
+    if(!status.ok()) {
+      Finish(status);
+      return;
+    }
+    StartRead(&req);
+  }
+
+  void complete() {
+    auto* service = callback_service->service;
+    Status status;
+    try {
+      status = service->commit_assemble(uri, options, recipe);
+    } catch(const std::exception& error) {
+      callback_service->logger->error("[assemble] {}, reason: {}", uri, error.what());
+      status = Status::CANCELLED;
+    }
+    if(status.ok()) {
+      submit(callback_service->replication_executor, [service, uri = uri, options = detached(options)] {
+        service->replicate_put(uri, options);
+      });
+    }
+    Finish(status);
+  }
+
+ public:
+  AssembleReactor(CallbackService* callback_service, CallbackServerContext* server_context)
+    : callback_service{callback_service}, server_context{server_context} {
+    callback_service->put_slots.acquire([this] {
+      submit(this->callback_service->put_executor, [this] { begin(); });
+    });
+  }
+
+  void OnReadDone(bool ok) override {
+    auto& executor = callback_service->put_executor;
+    if(ok) {
+      submit(executor, [this] { add(); });
+    } else if(server_context->IsCancelled()) {
+      Finish(Status::CANCELLED);
+    } else {
+      // client finished writing
+      submit(executor, [this] { complete(); });
+    }
+  }
+
+  void OnDone() override {
+    auto* service = callback_service;
+    delete this;
+    service->put_slots.release();
+  }
+};
+
+CallbackService::CallbackService(Context& context, fs::Service* service)
+    : context{context},
+      service{service},
+      put_slots{context.fs_max_concurrency},
+      get_slots{context.fs_max_concurrency},
+      logger{context.logging.factory().get_or_create(logger_name)},
+      put_executor{context.fs_max_concurrency},
+      get_executor{context.fs_max_concurrency},
+      del_executor{context.fs_max_concurrency},
+      mov_executor{context.fs_max_concurrency},
+      meta_executor{context.fs_max_concurrency},
+      replication_executor{context.fs_replication_threads} {}
+
+ServerUnaryReactor* CallbackService::run(CallbackServerContext* server_context, Scheduler& executor, std::function<Status()> handler) {
+  auto* reactor = server_context->DefaultReactor();
+  submit(executor, [this, reactor, handler = std::move(handler)] {
+    try {
+      reactor->Finish(handler());
+    } catch(const std::exception& error) {
+      logger->error("failed to handle request, reason: {}", error.what());
+      reactor->Finish({StatusCode::INTERNAL, error.what()});
+    }
+  });
+  return reactor;
+}
+
+grpc::ServerReadReactor<PutRequest>* CallbackService::put(CallbackServerContext* server_context, [[maybe_unused]] PutResponse* res) {
+  return new PutReactor(this, server_context);
+}
+
+grpc::ServerWriteReactor<GetResponse>* CallbackService::get([[maybe_unused]] CallbackServerContext* server_context, const GetRequest* req) {
+  return new GetReactor(this, req);
+}
+
+ServerUnaryReactor* CallbackService::del(CallbackServerContext* server_context, const DelRequest* req, DelResponse* res) {
+  return run(server_context, del_executor, [this, server_context, req, res] {
+    return service->del(req, res, ContextMetadata::from(server_context));
+  });
+}
+
+ServerUnaryReactor* CallbackService::mov(CallbackServerContext* server_context, const MovRequest* req, MovResponse* res) {
+  return run(server_context, mov_executor, [this, server_context, req, res] {
+    return service->mov(req, res, ContextMetadata::from(server_context));
+  });
+}
+
+ServerUnaryReactor* CallbackService::meta(CallbackServerContext* server_context, const MetaRequest* req, MetaResponse* res) {
+  return run(server_context, meta_executor, [this, server_context, req, res] {
+    return service->meta(req, res, ContextMetadata::from(server_context));
+  });
+}
+
+ServerUnaryReactor* CallbackService::chunks(CallbackServerContext* server_context, const ChunksRequest* req, ChunksResponse* res) {
+  return run(server_context, meta_executor, [this, req, res] {
+    return service->chunks(req, res);
+  });
+}
+
+ServerUnaryReactor* CallbackService::missing(CallbackServerContext* server_context, const MissingRequest* req, MissingResponse* res) {
+  return run(server_context, meta_executor, [this, req, res] {
+    return service->missing(req, res);
+  });
+}
+
+grpc::ServerReadReactor<AssembleRequest>* CallbackService::assemble(CallbackServerContext* server_context, [[maybe_unused]] PutResponse* res) {
+  return new AssembleReactor(this, server_context);
+}
+
+} //namespace fs
+} //namespace chord
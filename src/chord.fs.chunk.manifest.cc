@@ -0,0 +1,67 @@
+#include "chord.fs.chunk.manifest.h"
+
+#include <algorithm>
+
+namespace chord {
+namespace fs {
+
+ChunkManifest::Builder::Builder(const std::uint64_t chunk_size) : chunk_size{chunk_size} {}
+
+ChunkManifest::Builder::Builder(const ChunkManifest& base) : chunk_size{base.chunk_size} {
+  chunks.assign(base.chunks.begin(), base.chunks.end());
+}
+
+void ChunkManifest::Builder::set(const std::uint64_t index, const chord::uuid& hash) {
+  if(chunks.size() <= index) chunks.resize(index + 1);
+  chunks[index] = hash;
+}
+
+void ChunkManifest::Builder::write(const std::uint64_t offset, const char* data, std::size_t len) {
+  if(offset != position) {
+    // the chunk started before is incomplete
+    if(hasher || offset % chunk_size != 0) valid = false;
+    hasher.reset();
+    position = offset;
+  }
+
+  while(len > 0) {
+    const auto take = static_cast<std::size_t>(std::min<std::uint64_t>(len, chunk_size - position % chunk_size));
+    if(!hasher) hasher.emplace();
+    (*hasher)(data, take);
+    data += take;
+    len -= take;
+    position += take;
+
+    if(position % chunk_size == 0) {
+      set(position / chunk_size - 1, hasher->get());
+      hasher.reset();
+    }
+  }
+}
+
+std::optional<ChunkManifest> ChunkManifest::Builder::finish(const chord::uuid& file_hash, const std::uint64_t file_size) {
+  // last chunk
+  if(hasher) {
+    if(position != file_size) valid = false;
+    set((position - 1) / chunk_size, hasher->get());
+    hasher.reset();
+  }
+  if(!valid) return {};
+
+  ChunkManifest manifest;
+  manifest.file_hash = file_hash;
+  manifest.chunk_size = chunk_size;
+  manifest.file_size = file_size;
+
+  const auto count = ChunkManifest::count(file_size, chunk_size);
+  chunks.resize(count);
+  manifest.chunks.reserve(count);
+  for(const auto& chunk : chunks) {
+    if(!chunk) return {};
+    manifest.chunks.push_back(*chunk);
+  }
+  return manifest;
+}
+
+} // namespace fs
+} // namespace chord
@@ -0,0 +1,256 @@
+#include "chord.fs.chunk.store.h"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <streambuf>
+#include <utility>
+
+#include "chord.context.h"
+#include "chord.crypto.h"
+#include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.i.fs.metadata.manager.h"
+#include "chord.log.factory.h"
+#include "chord.log.h"
+
+namespace chord {
+namespace fs {
+
+namespace {
+
+/**
+ * fixed-width (64 digit) hex of the hash
+ */
+std::string hex_of(const chord::uuid& hash) {
+  static constexpr char digits[] = "0123456789abcdef";
+  std::string ret;
+  for(const auto byte : hash.bytes()) {
+    const auto value = static_cast<unsigned char>(byte);
+    ret.push_back(digits[value >> 4]);
+    ret.push_back(digits[value & 0x0F]);
+  }
+  return ret;
+}
+
+/**
+ * reads the chunks of the recipe on demand - one chunk is held at a time
+ */
+class RecipeBuffer : public std::streambuf {
+  const ChunkStore& store;
+  const ChunkRecipe recipe;
+  // offset of each chunk in the file, followed by the file size
+  std::vector<std::uint64_t> offsets;
+  // index of the chunk read next and offset of the chunk held
+  std::size_t next{0};
+  std::uint64_t start{0};
+  std::string chunk;
+
+  std::uint64_t position() const {
+    return start + static_cast<std::uint64_t>(gptr() - eback());
+  }
+
+  void load(const std::size_t index, const std::uint64_t offset) {
+    chunk = store.load(recipe.chunks[index].hash);
+    if(chunk.size() != recipe.chunks[index].size) {
+      throw__exception("corrupt chunk " + recipe.chunks[index].hash.string());
+    }
+    start = offsets[index];
+    next = index + 1;
+    setg(chunk.data(), chunk.data() + (offset - start), chunk.data() + chunk.size());
+  }
+
+ protected:
+  int_type underflow() override {
+    if(gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    if(next >= recipe.chunks.size()) return traits_type::eof();
+    load(next, offsets[next]);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  std::streamsize showmanyc() override {
+    const auto remaining = recipe.file_size - position();
+    return remaining > 0 ? static_cast<std::streamsize>(remaining) : -1;
+  }
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+    off_type base = 0;
+    if(dir == std::ios_base::cur) base = static_cast<off_type>(position());
+    else if(dir == std::ios_base::end) base = static_cast<off_type>(recipe.file_size);
+    return seekpos(pos_type(base + off), which);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+    const auto invalid = pos_type(off_type(-1));
+    if(!(which & std::ios_base::in) || pos < 0) return invalid;
+
+    const auto offset = static_cast<std::uint64_t>(static_cast<off_type>(pos));
+    if(offset > recipe.file_size) return invalid;
+
+    if(offset == recipe.file_size) {
+      chunk.clear();
+      start = recipe.file_size;
+      next = recipe.chunks.size();
+      setg(nullptr, nullptr, nullptr);
+    } else if(eback() && offset >= start && offset < start + chunk.size()) {
+      // within the chunk held
+      setg(eback(), eback() + (offset - start), egptr());
+    } else {
+      const auto last = offsets.begin() + static_cast<std::ptrdiff_t>(recipe.chunks.size());
+      const auto index = static_cast<std::size_t>(std::upper_bound(offsets.begin(), last, offset) - offsets.begin()) - 1;
+      load(index, offset);
+    }
+    return pos;
+  }
+
+ public:
+  RecipeBuffer(const ChunkStore& store, ChunkRecipe recipe)
+    : store{store}, recipe{std::move(recipe)} {
+    offsets.reserve(this->recipe.chunks.size() + 1);
+    std::uint64_t offset = 0;
+    for(const auto& chunk : this->recipe.chunks) {
+      offsets.push_back(offset);
+      offset += chunk.size;
+    }
+    offsets.push_back(offset);
+  }
+};
+
+class RecipeStream : public std::istream {
+  RecipeBuffer buffer;
+
+ public:
+  RecipeStream(const ChunkStore& store, ChunkRecipe recipe)
+    : std::istream{nullptr}, buffer{store, std::move(recipe)} {
+    rdbuf(&buffer);
+  }
+};
+
+}
+
+ChunkStore::ChunkStore(const Context& context, IMetadataManager* metadata_mgr, const Chunker& chunker)
+  : context{context},
+    metadata_mgr{metadata_mgr},
+    chunker{chunker},
+    logger{context.logging.factory().get_or_create(logger_name)} {}
+
+chord::path ChunkStore::chunk_path(const chord::uuid& chunk) const {
+  const auto hex = hex_of(chunk);
+  return context.chunk_directory() / hex.substr(0, 2) / hex;
+}
+
+bool ChunkStore::contains(const chord::uuid& chunk) const {
+  return file::exists(chunk_path(chunk));
+}
+
+chord::uuid ChunkStore::write(const char* data, const std::size_t len) {
+  const auto hash = crypto::sha256(data, len);
+  const auto path = chunk_path(hash);
+  if(file::exists(path)) return hash;
+
+  const auto parent = path.parent_path();
+  if(!file::exists(parent)) file::create_directories(parent);
+
+  // written aside: concurrent writers of the same chunk (or a crash) leave no partial chunk
+  const auto tmp = path.string() + "." + chord::uuid::random().hex();
+  {
+    std::ofstream file;
+    file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    file.open(tmp, std::fstream::binary | std::fstream::trunc);
+    file.write(data, static_cast<std::streamsize>(len));
+  }
+  file::rename(tmp, path);
+  return hash;
+}
+
+chord::uuid ChunkStore::store(const char* data, const std::size_t len) {
+  const std::shared_lock<std::shared_mutex> lock{mtx};
+  return write(data, len);
+}
+
+std::string ChunkStore::load(const chord::uuid& chunk) const {
+  const auto path = chunk_path(chunk);
+  std::ifstream file;
+  file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  try {
+    file.open(path, std::fstream::binary);
+    std::string data(static_cast<std::size_t>(file::file_size(path)), '\0');
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return data;
+  } catch(const std::exception& error) {
+    throw__exception("failed to load chunk " + chunk.string() + ": " + error.what());
+  }
+}
+
+ChunkRecipe ChunkStore::add(const chord::uri& uri, std::istream& istream) {
+  ChunkRecipe recipe;
+  std::vector<chord::uuid> released;
+  {
+    const std::shared_lock<std::shared_mutex> lock{mtx};
+    crypto::sha256_hasher hasher;
+    chunker.split(istream, [&](const char* data, const std::size_t len) {
+      hasher(data, len);
+      recipe.chunks.push_back({write(data, len), static_cast<std::uint32_t>(len)});
+      recipe.file_size += len;
+    });
+    recipe.file_hash = hasher.get();
+    released = metadata_mgr->recipe(uri, recipe);
+  }
+  logger->trace("[add] {}: {} chunks, {} released", uri, recipe.chunks.size(), released.size());
+  release(released);
+  return recipe;
+}
+
+bool ChunkStore::add(const chord::uri& uri, const ChunkRecipe& recipe) {
+  std::vector<chord::uuid> released;
+  {
+    const std::shared_lock<std::shared_mutex> lock{mtx};
+    const auto stored = std::all_of(recipe.chunks.begin(), recipe.chunks.end(), [&](const auto& chunk) {
+        return contains(chunk.hash);
+    });
+    if(!stored) return false;
+    released = metadata_mgr->recipe(uri, recipe);
+  }
+  logger->trace("[add] {}: {} chunks, {} released", uri, recipe.chunks.size(), released.size());
+  release(released);
+  return true;
+}
+
+std::optional<ChunkRecipe> ChunkStore::recipe(const chord::uri& uri) {
+  return metadata_mgr->recipe(uri);
+}
+
+void ChunkStore::remove(const chord::uri& uri) {
+  std::vector<chord::uuid> released;
+  {
+    const std::shared_lock<std::shared_mutex> lock{mtx};
+    released = metadata_mgr->recipe(uri, {});
+  }
+  release(released);
+}
+
+void ChunkStore::release(const std::vector<chord::uuid>& chunks) {
+  if(chunks.empty()) return;
+
+  const std::unique_lock<std::shared_mutex> lock{mtx};
+  for(const auto& chunk : chunks) {
+    if(metadata_mgr->refs(chunk) > 0) continue;
+    file::remove(chunk_path(chunk));
+  }
+}
+
+std::vector<std::size_t> ChunkStore::missing(const std::vector<chord::uuid>& chunks) const {
+  std::vector<std::size_t> ret;
+  for(std::size_t i = 0; i < chunks.size(); ++i) {
+    if(!contains(chunks[i])) ret.push_back(i);
+  }
+  return ret;
+}
+
+std::unique_ptr<std::istream> ChunkStore::open(const ChunkRecipe& recipe) const {
+  return std::make_unique<RecipeStream>(*this, recipe);
+}
+
+} // namespace fs
+} // namespace chord
@@ -0,0 +1,98 @@
+#include "chord.fs.chunker.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <istream>
+#include <vector>
+
+#include "chord.exception.h"
+
+namespace chord {
+namespace fs {
+
+namespace {
+
+// bits the masks of the normalized chunking differ from the average
+constexpr int normalization = 2;
+
+constexpr std::uint64_t splitmix64(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+/**
+ * random values of the bytes - fixed, the chunks of all nodes have to match
+ */
+constexpr std::array<std::uint64_t, 256> make_gear() {
+  std::array<std::uint64_t, 256> gear{};
+  std::uint64_t state = 0;
+  for(auto& value : gear) value = splitmix64(state);
+  return gear;
+}
+
+constexpr auto gear = make_gear();
+
+/**
+ * the highest bits - the gear hash is shifted left, i.e. these depend
+ * on the most bytes of the window
+ */
+constexpr std::uint64_t mask(const int bits) {
+  return bits <= 0 ? 0 : ~std::uint64_t{0} << (64 - bits);
+}
+
+}
+
+Chunker::Chunker(const std::size_t min_size, const std::size_t avg_size, const std::size_t max_size)
+  : min_size{min_size}, avg_size{avg_size}, max_size{max_size} {
+  if(!std::has_single_bit(avg_size) || avg_size < 64 || min_size >= avg_size || avg_size >= max_size) {
+    throw__exception("invalid chunk sizes: the average size must be a power of two between the min and max size.");
+  }
+  const auto bits = std::countr_zero(avg_size);
+  mask_s = mask(bits + normalization);
+  mask_l = mask(bits - normalization);
+}
+
+std::size_t Chunker::cut(const char* data, const std::size_t len) const {
+  if(len <= min_size) return len;
+
+  const auto end = std::min(len, max_size);
+  const auto normal = std::min(end, avg_size);
+  std::uint64_t hash = 0;
+  auto i = min_size;
+  for(; i < normal; ++i) {
+    hash = (hash << 1) + gear[static_cast<unsigned char>(data[i])];
+    if(!(hash & mask_s)) return i + 1;
+  }
+  for(; i < end; ++i) {
+    hash = (hash << 1) + gear[static_cast<unsigned char>(data[i])];
+    if(!(hash & mask_l)) return i + 1;
+  }
+  return end;
+}
+
+void Chunker::split(std::istream& istream, const std::function<void(const char*, std::size_t)>& consumer) const {
+  std::vector<char> buffer(max_size);
+  std::size_t filled = 0;
+  bool end = false;
+
+  for(;;) {
+    // keep the buffer filled - a chunk may end before max size only at the end of the stream
+    if(!end) {
+      const auto read = static_cast<std::size_t>(istream.rdbuf()->sgetn(buffer.data() + filled, static_cast<std::streamsize>(max_size - filled)));
+      end = read < max_size - filled;
+      filled += read;
+    }
+    if(filled == 0) break;
+
+    const auto len = cut(buffer.data(), filled);
+    consumer(buffer.data(), len);
+    std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(len), buffer.begin() + static_cast<std::ptrdiff_t>(filled), buffer.begin());
+    filled -= len;
+  }
+}
+
+} // namespace fs
+} // namespace chord
@@ -5,12 +5,19 @@
 #include <grpcpp/impl/codegen/status_code_enum.h>
 #include <grpcpp/impl/codegen/sync_stream.h>
 #include <grpcpp/security/credentials.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "chord_fs.grpc.pb.h"
 #include "chord_fs.pb.h"
@@ -18,12 +25,17 @@
 #include "chord.context.h"
 #include "chord.facade.h"
 #include "chord.crypto.h"
+#include "chord.deadline.h"
 #include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.fs.chunk.store.h"
 #include "chord.fs.context.metadata.h"
 #include "chord.fs.metadata.builder.h"
 #include "chord.fs.metadata.h"
+#include "chord.fs.service.h"
 #include "chord.fs.replication.h"
 #include "chord.fs.type.h"
+#include "chord.fs.util.h"
 #include "chord.log.factory.h"
 #include "chord.log.h"
 #include "chord.node.h"
@@ -44,6 +56,11 @@ using chord::fs::MetaResponse;
 using chord::fs::MetaRequest;
 using chord::fs::MovResponse;
 using chord::fs::MovRequest;
+using chord::fs::ChunksRequest;
+using chord::fs::ChunksResponse;
+using chord::fs::MissingRequest;
+using chord::fs::MissingResponse;
+using chord::fs::AssembleRequest;
 
 using namespace std;
 using namespace chord::file;
@@ -70,16 +87,75 @@ Client::Client(Context &context, ChordFacade *chord, StubFactory make_stub)
       make_stub{std::move(make_stub)},
       logger{context.logging.factory().get_or_create(logger_name)} {}
 
-void Client::init_context(ClientContext& client_context, const client::options& options) {
+template<typename Call>
+Status Client::with_successor(const chord::uuid& hash, Call&& call) {
+  const auto node = chord->successor(hash);
+  const auto status = call(node);
+
+  const auto code = status.error_code();
+  if((code != StatusCode::NOT_FOUND && code != StatusCode::UNAVAILABLE) || !chord->invalidate(hash)) {
+    return status;
+  }
+
+  const auto owner = chord->successor(hash);
+  if(owner == node) return status;
+
+  logger->debug("[successor] stale owner {} of {} - retrying on {}", node, hash, owner);
+  return call(owner);
+}
+
+namespace {
+/**
+ * options as received by the service from the client context (c.f. init_context)
+ */
+client::options received(const client::options& options) {
+  client::options ret;
+  ret.source = options.source;
+  ret.rebalance = options.rebalance;
+  ret.deadline = options.deadline;
+  return ret;
+}
+
+/**
+ * bytes from the current position to the end of the stream
+ */
+std::optional<std::uint64_t> remaining(std::istream& istream) {
+  const auto begin = istream.tellg();
+  if(begin < 0) return {};
+  istream.seekg(0, std::ios::end);
+  const auto end = istream.tellg();
+  istream.clear();
+  istream.seekg(begin);
+  if(end < begin) return {};
+  return static_cast<std::uint64_t>(end - begin);
+}
+} // namespace
+
+void Client::set_local_service(Service* service) {
+  local_service = service;
+}
+
+bool Client::is_local(const chord::node& node) const {
+  return local_service && node == context.node();
+}
+
+std::unique_ptr<Filesystem::Stub> Client::make_bulk_stub(const chord::node& node) {
+  if(!channel_pool) return Filesystem::NewStub(ChannelPool::create_channel(node.endpoint));
+  return Filesystem::NewStub(channel_pool->get(node, ChannelPool::lane::BULK));
+}
+
+void Client::init_context(ClientContext& client_context, const client::options& options, const std::string& rpc) {
+  deadline::set(client_context, deadline::of(context, rpc, options.deadline));
   if(options.source)
-    ContextMetadata::add_src(client_context, *options.source);
+    ContextMetadata::add_src(client_context, *options.source, context.legacy_uuids);
   ContextMetadata::add_rebalance(client_context, options.rebalance);
 }
 
 Status Client::put(const chord::uri& uri, const chord::path& source, const client::options& options) {
   const auto hash = chord::crypto::sha256(uri);
-  const auto node = chord->successor(hash);
-  return put(node, uri, source, options);
+  return with_successor(hash, [&](const chord::node& node) {
+    return put(node, uri, source, options);
+  });
 }
 
 Status Client::put(const chord::node& node, const chord::uri& uri, const chord::path& source, const client::options& options) {
@@ -88,28 +164,77 @@ Status Client::put(const chord::node& node, const chord::uri& uri, const chord::
     file.exceptions(ifstream::failbit | ifstream::badbit);
     file.open(source, std::fstream::binary);
 
-    return put(node, uri, file, options);
+    // skip the pass hashing the file if its hash has been cached
+    std::optional<chord::uuid> file_hash;
+    if(context.fs_hash_cache) file_hash = util::file_hash(source);
+    return put(node, uri, file, file_hash, options);
   } catch (const std::ios_base::failure& exception) {
     return {StatusCode::CANCELLED, "failed to put", exception.what()};
   }
 }
 
 Status Client::put(const chord::node& node, const chord::uri &uri, istream &istream, const client::options& options) {
+  return put(node, uri, istream, {}, options);
+}
+
+Status Client::put(const chord::node& node, const chord::uri &uri, istream &istream, const std::optional<chord::uuid>& file_hash, const client::options& options) {
 
   if(node == context.node() && options.source && *options.source == context.uuid()) {
     return {StatusCode::ALREADY_EXISTS, "trying to issue request from self - aborting."};
   }
 
+  // delta put: send only the chunks the receiver lacks
+  std::optional<ChunkManifest> base;
+  const auto file_size = remaining(istream);
+  if(context.fs_delta_uploads && file_size && *file_size > ChunkManifest::CHUNK_SIZE) {
+    ChunkManifest manifest;
+    if(chunks(node, uri, manifest, options).ok()) base = std::move(manifest);
+  }
+
+  // resumable put: an interrupted put continues at the offset committed by the receiver
+  const bool resumable = context.fs_resumable_puts && !base && file_size && *file_size > ChunkManifest::CHUNK_SIZE;
+  std::optional<chord::uuid> hash = file_hash;
+  if(resumable && !hash) {
+    hash = chord::crypto::sha256(istream);
+    istream.clear();
+    istream.seekg(0, std::ios::beg);
+  }
+
+  for(std::size_t attempt = 1;; ++attempt) {
+    const auto status = put_attempt(node, uri, istream, hash, file_size, base, resumable, options);
+    const auto code = status.error_code();
+    // a put cancelled by the caller is not resumed
+    const bool interrupted = code == StatusCode::UNAVAILABLE || code == StatusCode::DEADLINE_EXCEEDED || code == StatusCode::ABORTED;
+    if(status.ok() || !resumable || !interrupted || attempt == put_attempts) return status;
+
+    logger->warn("[put] {} interrupted ({}) - resuming ({}/{}).", uri, status.error_message(), attempt, put_attempts - 1);
+    std::this_thread::sleep_for(put_retry_delay * attempt);
+    istream.clear();
+    istream.seekg(0, std::ios::beg);
+  }
+}
+
+Status Client::put_attempt(const chord::node& node, const chord::uri& uri, istream& istream, const std::optional<chord::uuid>& file_hash, const std::optional<std::uint64_t>& file_size, const std::optional<ChunkManifest>& base, const bool resumable, const client::options& options) {
   //TODO make configurable
   constexpr size_t len = static_cast<long>(512)*1024; // 512k
   std::array<char, len> buffer;
 
   ClientContext clientContext;
-  init_context(clientContext, options);
+  init_context(clientContext, options, "put");
   ContextMetadata::add(clientContext, options.replication);
   ContextMetadata::add(clientContext, uri);
   //TODO before calculating the hash maybe compare file size first
-  ContextMetadata::add(clientContext, istream);
+  if(file_hash) {
+    ContextMetadata::add(clientContext, file_hash, context.legacy_uuids);
+  } else {
+    ContextMetadata::add(clientContext, istream, context.legacy_uuids);
+  }
+  if(base) {
+    ContextMetadata::add_delta(clientContext, base->file_hash, *file_size);
+  }
+  if(resumable) {
+    ContextMetadata::add_resume(clientContext, *file_size);
+  }
 
   //if(metadata_mgr->exists(uri)) {
   //  const auto metadata_set = metadata_mgr->get(uri);
@@ -130,7 +255,7 @@ Status Client::put(const chord::node& node, const chord::uri &uri, istream &istr
 
   PutResponse res;
 
-  auto stub = Filesystem::NewStub(grpc::CreateChannel(node.endpoint, grpc::InsecureChannelCredentials()));
+  auto stub = make_bulk_stub(node);
   unique_ptr<ClientWriter<PutRequest> > writer(stub->put(&clientContext, &res));
 
   writer->WaitForInitialMetadata();
@@ -140,7 +265,38 @@ Status Client::put(const chord::node& node, const chord::uri &uri, istream &istr
     logger->info("[put] file hash equals - skip upload.");
   }
 
-  for(size_t read=0, offset=0; !file_hash_equal && istream && (read = static_cast<size_t>(istream.readsome(buffer.data(), len))) > 0;) {
+  const bool delta = base && !file_hash_equal && ContextMetadata::delta_accepted_from(clientContext);
+  if(delta) {
+    std::vector<char> chunk(base->chunk_size);
+    std::size_t sent = 0;
+    for(std::uint64_t index = 0, offset = 0;; ++index) {
+      const auto read = static_cast<std::size_t>(istream.rdbuf()->sgetn(chunk.data(), static_cast<std::streamsize>(chunk.size())));
+      if(read == 0) break;
+
+      const auto chunk_offset = offset;
+      offset += read;
+      // the receiver holds the chunk
+      if(index < base->chunks.size() && chord::crypto::sha256(chunk.data(), read) == base->chunks[index]) continue;
+
+      PutRequest req;
+      req.set_data(chunk.data(), read);
+      req.set_offset(chunk_offset);
+      req.set_size(read);
+      ++sent;
+      if(!writer->Write(req)) break;
+    }
+    logger->debug("[put] {}: sent {} of {} chunks.", uri, sent, ChunkManifest::count(*file_size, base->chunk_size));
+  }
+
+  // continue where the receiver stopped
+  size_t offset = 0;
+  if(const auto committed = ContextMetadata::committed_offset_from(clientContext); resumable && committed && *committed > 0) {
+    offset = static_cast<size_t>(*committed);
+    logger->info("[put] resuming {} at {} of {} bytes.", uri, offset, *file_size);
+    istream.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+  }
+
+  for(size_t read=0; !file_hash_equal && !delta && istream && (read = static_cast<size_t>(istream.readsome(buffer.data(), len))) > 0;) {
       PutRequest req;
       req.set_data(buffer.data(), read);
       req.set_offset(offset);
@@ -158,26 +314,83 @@ Status Client::put(const chord::node& node, const chord::uri &uri, istream &istr
   return writer->Finish();
 }
 
+std::unique_ptr<Client::PutStream> Client::put_stream(const chord::node& node, const chord::uri& uri, const std::optional<chord::uuid>& file_hash, const client::options& options, const std::optional<Delta>& delta) {
+  if(node == context.node()) return nullptr;
+
+  auto stream = std::make_unique<PutStream>();
+  init_context(stream->client_context, options, "put");
+  ContextMetadata::add(stream->client_context, options.replication);
+  ContextMetadata::add(stream->client_context, uri);
+  ContextMetadata::add(stream->client_context, file_hash, context.legacy_uuids);
+  if(delta) {
+    ContextMetadata::add_delta(stream->client_context, delta->base, delta->file_size);
+  }
+
+  stream->stub = make_bulk_stub(node);
+  stream->writer = stream->stub->put(&stream->client_context, &stream->res);
+
+  stream->writer->WaitForInitialMetadata();
+  stream->file_hash_equal = ContextMetadata::file_hash_equal_from(stream->client_context);
+  if(stream->file_hash_equal) {
+    logger->info("[put] file hash of {} equals on {} - skip forwarding.", uri, node);
+  } else if(delta && !ContextMetadata::delta_accepted_from(stream->client_context)) {
+    // the chunks of the delta do not suffice
+    logger->info("[put] {} does not hold the base of {} - skip forwarding.", node, uri);
+    stream->client_context.TryCancel();
+    stream->writer->Finish();
+    return nullptr;
+  }
+  return stream;
+}
+
+bool Client::PutStream::write(const PutRequest& req) {
+  if(file_hash_equal || broken) return !broken;
+  broken = !writer->Write(req);
+  return !broken;
+}
+
+Status Client::PutStream::finish() {
+  writer->WritesDone();
+  const auto status = writer->Finish();
+  if(status.ok() && broken) {
+    return {StatusCode::ABORTED, "broken stream."};
+  }
+  return status;
+}
+
+void Client::PutStream::cancel() {
+  client_context.TryCancel();
+  writer->Finish();
+}
+
 Status Client::put(const chord::uri &uri, istream &istream, const client::options& options) {
   const auto hash = chord::crypto::sha256(uri);
-  const auto node = chord->successor(hash);
   logger->trace("[put] {} ({})", uri, hash);
-  return put(node, uri, istream, options);
+  // a put rejected by a stale owner is sent again from the start
+  const auto start = istream.tellg();
+  return with_successor(hash, [&](const chord::node& node) {
+    if(start != std::istream::pos_type(-1)) {
+      istream.clear();
+      istream.seekg(start);
+    }
+    return put(node, uri, istream, options);
+  });
 }
 
 Status Client::mov(const chord::uri& src, const chord::uri& dst, const client::options& options) {
   if(src == dst) return Status::OK;
 
   const auto hash = chord::crypto::sha256(src);
-  const auto node = chord->successor(hash);
-  return mov(node, src, dst, options);
+  return with_successor(hash, [&](const chord::node& node) {
+    return mov(node, src, dst, options);
+  });
 }
 
 Status Client::mov(const chord::node& node, const chord::uri& src, const chord::uri& dst, const client::options& options) {
   logger->trace("[mov] {} -> {}", src, dst);
 
   ClientContext clientContext;
-  init_context(clientContext, options);
+  init_context(clientContext, options, "mov");
   MovResponse res;
   MovRequest req;
 
@@ -185,6 +398,10 @@ Status Client::mov(const chord::node& node, const chord::uri& src, const chord::
   req.set_dst(dst);
   req.set_force(options.force);
 
+  if(is_local(node)) {
+    return local_service->mov(&req, &res, received(options));
+  }
+
   const auto status = make_stub(node)->mov(&clientContext, req, &res);
 
   return status;
@@ -199,7 +416,7 @@ grpc::Status Client::meta(const chord::node& target, const chord::uri &uri, cons
   logger->trace("[meta] {} ({})", meta_uri, hash);
 
   ClientContext clientContext;
-  init_context(clientContext, options);
+  init_context(clientContext, options, "meta");
   MetaResponse res;
   MetaRequest req;
 
@@ -215,11 +432,12 @@ grpc::Status Client::meta(const chord::node& target, const chord::uri &uri, cons
       data->set_group(m.group);
       if(m.node_ref) {
         auto node_ref = data->mutable_node_ref();
-        node_ref->set_uuid(m.node_ref->uuid.string());
+        chord::common::set_uuid(*node_ref, m.node_ref->uuid, context.legacy_uuids);
         node_ref->set_endpoint(m.node_ref->endpoint);
       }
       if(m.file_hash) {
-        data->set_file_hash(*m.file_hash);
+        data->set_file_hash_bin(m.file_hash->bytes());
+        if(context.legacy_uuids) data->set_file_hash(*m.file_hash);
       }
       data->set_replication_idx(m.replication.index);
       data->set_replication_cnt(m.replication.count);
@@ -240,22 +458,150 @@ grpc::Status Client::meta(const chord::node& target, const chord::uri &uri, cons
       return Status::CANCELLED;
   }
 
+  if(is_local(target)) {
+    return local_service->meta(&req, &res, received(options));
+  }
+
   const auto status = make_stub(target)->meta(&clientContext, req, &res);
 
   return status;
 }
 
+Status Client::chunks(const chord::node& node, const chord::uri& uri, ChunkManifest& manifest, const client::options& options) {
+  ChunksRequest req;
+  req.set_uri(to_string(uri));
+  manifest.chunks.clear();
+
+  // large manifests are paged
+  ChunksResponse res;
+  do {
+    req.set_first(manifest.chunks.size());
+    res.Clear();
+
+    ClientContext clientContext;
+    init_context(clientContext, options, "chunks");
+    const auto status = is_local(node)
+        ? local_service->chunks(&req, &res)
+        : make_stub(node)->chunks(&clientContext, req, &res);
+    if(!status.ok()) return status;
+
+    const auto file_hash = chord::uuid::from_bytes(res.file_hash_bin());
+    if(!manifest.chunks.empty() && file_hash != manifest.file_hash) {
+      return {StatusCode::ABORTED, "file changed while receiving its chunks."};
+    }
+    manifest.file_hash = file_hash;
+    manifest.chunk_size = res.chunk_size();
+    manifest.file_size = res.file_size();
+    for(const auto& chunk : res.chunks()) {
+      manifest.chunks.push_back(chord::uuid::from_bytes(chunk));
+    }
+  } while(res.chunks_size() > 0 && manifest.chunks.size() < res.count());
+
+  if(manifest.chunk_size == 0 || manifest.chunks.size() != res.count()
+      || res.count() != ChunkManifest::count(manifest.file_size, manifest.chunk_size)) {
+    return {StatusCode::DATA_LOSS, "incomplete chunks."};
+  }
+  return Status::OK;
+}
+
+Status Client::assemble(const chord::node& node, const chord::uri& uri, const ChunkStore& store, const ChunkRecipe& recipe, const client::options& options) {
+  if(node == context.node() && options.source && *options.source == context.uuid()) {
+    return {StatusCode::ALREADY_EXISTS, "trying to issue request from self - aborting."};
+  }
+
+  const auto put_file = [&] {
+    logger->debug("[assemble] {} has no chunk store - putting {}.", node, uri);
+    const auto file = store.open(recipe);
+    return put(node, uri, *file, recipe.file_hash, options);
+  };
+
+  // chunks the receiver lacks, large recipes are paged
+  const auto count = recipe.chunks.size();
+  std::vector<std::size_t> missing;
+  for(std::size_t first = 0; first < count; first += chunks_per_request) {
+    const auto last = std::min(count, first + chunks_per_request);
+    MissingRequest req;
+    MissingResponse res;
+    for(auto i = first; i < last; ++i) {
+      req.add_chunks(recipe.chunks[i].hash.bytes());
+    }
+
+    ClientContext clientContext;
+    init_context(clientContext, options, "missing");
+    const auto status = is_local(node)
+        ? local_service->missing(&req, &res)
+        : make_stub(node)->missing(&clientContext, req, &res);
+    if(status.error_code() == StatusCode::UNIMPLEMENTED) return put_file();
+    if(!status.ok()) return status;
+
+    for(const auto index : res.index()) {
+      if(index >= last - first) return {StatusCode::DATA_LOSS, "invalid index of missing chunk."};
+      missing.push_back(first + index);
+    }
+  }
+
+  ClientContext clientContext;
+  init_context(clientContext, options, "put");
+  ContextMetadata::add(clientContext, options.replication);
+  ContextMetadata::add(clientContext, uri);
+
+  PutResponse res;
+  auto stub = make_bulk_stub(node);
+  unique_ptr<ClientWriter<AssembleRequest> > writer(stub->assemble(&clientContext, &res));
+
+  // the recipe - followed by the missing chunks
+  bool ok = true;
+  std::size_t first = 0;
+  do {
+    AssembleRequest req;
+    if(first == 0) {
+      req.set_file_hash_bin(recipe.file_hash.bytes());
+      req.set_file_size(recipe.file_size);
+    }
+    const auto last = std::min(count, first + chunks_per_request);
+    for(auto i = first; i < last; ++i) {
+      req.add_chunks(recipe.chunks[i].hash.bytes());
+      req.add_sizes(recipe.chunks[i].size);
+    }
+    ok = writer->Write(req);
+    first = last;
+  } while(ok && first < count);
+
+  try {
+    for(auto it = missing.begin(); ok && it != missing.end(); ++it) {
+      AssembleRequest req;
+      req.set_data(store.load(recipe.chunks[*it].hash));
+      ok = writer->Write(req);
+    }
+  } catch(const chord::exception& error) {
+    logger->error("[assemble] failed to send {}: {}", uri, error.what());
+    clientContext.TryCancel();
+    writer->Finish();
+    return {StatusCode::CANCELLED, "failed to send chunks", error.what()};
+  }
+  writer->WritesDone();
+
+  const auto status = writer->Finish();
+  if(status.error_code() == StatusCode::UNIMPLEMENTED) return put_file();
+  logger->debug("[assemble] {}: sent {} of {} chunks.", uri, missing.size(), count);
+  return status;
+}
+
 grpc::Status Client::meta(const chord::uri &uri, const Action &action, std::set<Metadata>& m, const client::options& options) {
   const auto hash = chord::crypto::sha256(uri);
-  const auto node = chord->successor(hash);
-  return meta(node, uri, action, m, options);
+  return with_successor(hash, [&](const chord::node& node) {
+    return meta(node, uri, action, m, options);
+  });
 }
 
 Status Client::del(const chord::node& node, const DelRequest* req, const client::options& options) {
   const auto endpoint = node.endpoint;
   ClientContext clientContext;
-  init_context(clientContext, options);
+  init_context(clientContext, options, "del");
   DelResponse res;
+  if(is_local(node)) {
+    return local_service->del(req, &res, received(options));
+  }
   return make_stub(node)->del(&clientContext, *req, &res);
 }
 
@@ -266,7 +612,7 @@ Status Client::del(const chord::node& node, const chord::uri &uri, const bool re
   logger->trace("[del] {} ({}) -> {}", uri, hash, endpoint);
 
   ClientContext clientContext;
-  init_context(clientContext, options);
+  init_context(clientContext, options, "del");
   DelResponse res;
   DelRequest req;
 
@@ -274,6 +620,10 @@ Status Client::del(const chord::node& node, const chord::uri &uri, const bool re
   req.set_uri(uri);
   req.set_recursive(recursive);
 
+  if(is_local(node)) {
+    return local_service->del(&req, &res, received(options));
+  }
+
   const auto status = make_stub(node)->del(&clientContext, req, &res);
 
   return status;
@@ -282,21 +632,18 @@ Status Client::del(const chord::node& node, const chord::uri &uri, const bool re
 // currently only files are supported
 Status Client::del(const chord::uri &uri, const bool recursive, const client::options& options) {
   const auto hash = chord::crypto::sha256(uri);
-  const auto succ = chord->successor(hash);
-  return del(succ, uri, recursive, options);
+  return with_successor(hash, [&](const chord::node& node) {
+    return del(node, uri, recursive, options);
+  });
 }
 
 grpc::Status Client::dir(const chord::uri &uri, std::set<Metadata> &metadata, const client::options& options) {
   //--- find responsible node
   const auto meta_uri = uri::builder{uri.scheme(), uri.path().canonical()}.build();
   const auto hash = chord::crypto::sha256(meta_uri);
-  const auto node = chord->successor(hash);
 
   logger->trace("[dir] {} ({})", meta_uri, hash);
 
-  ClientContext clientContext;
-  init_context(clientContext, options);
-
   MetaResponse res;
   MetaRequest req;
 
@@ -306,7 +653,14 @@ grpc::Status Client::dir(const chord::uri &uri, std::set<Metadata> &metadata, co
   req.set_uri(meta_uri);
   req.set_action(DIR);
 
-  const auto status = make_stub(node)->meta(&clientContext, req, &res);
+  const auto status = with_successor(hash, [&](const chord::node& node) {
+    if(is_local(node)) {
+      return local_service->meta(&req, &res, received(options));
+    }
+    ClientContext clientContext;
+    init_context(clientContext, options, "meta");
+    return make_stub(node)->meta(&clientContext, req, &res);
+  });
 
   const auto meta_res = MetadataBuilder::from(res);
   metadata.insert(meta_res.begin(), meta_res.end());
@@ -332,6 +686,9 @@ grpc::Status Client::dir(const chord::uri &uri, std::set<Metadata> &metadata, co
 //}
 
 Status Client::get(const chord::uri& uri, const chord::path& path) {
+  if(context.fs_get_range_mb > 0) {
+    return get(uri, path, static_cast<std::uint64_t>(context.fs_get_range_mb)*1024*1024);
+  }
   std::ofstream ofile;
   ofile.exceptions(ofstream::failbit | ofstream::badbit);
   ofile.open(path, fstream::binary);
@@ -346,20 +703,26 @@ Status Client::get(const chord::uri& uri, const chord::node& node, const chord::
 }
 
 Status Client::get(const chord::uri &uri, const chord::node& node, std::ostream &ostream) {
+  return get(uri, node, ostream, 0, 0);
+}
+
+Status Client::get(const chord::uri &uri, const chord::node& node, std::ostream &ostream, const std::uint64_t offset, const std::uint64_t length) {
   const auto hash = chord::crypto::sha256(uri);
 
-  logger->trace("[get] {} ({})", uri, hash);
+  logger->trace("[get] {} ({}) {}+{}", uri, hash, offset, length);
 
   ClientContext clientContext;
+  deadline::set(clientContext, deadline::of(context, "get"));
   GetResponse res;
   GetRequest req;
 
-  req.set_id(hash);
+  chord::common::set_id(req, hash, context.legacy_uuids);
   req.set_uri(uri);
+  req.set_offset(offset);
+  req.set_length(length);
 
   // cannot be mocked since make_stub returns unique_ptr<StubInterface> (!)
-  auto channel = channel_pool->get(node);
-  const auto stub = Filesystem::NewStub(channel);
+  const auto stub = make_bulk_stub(node);
   unique_ptr<ClientReader<GetResponse> > reader(stub->get(&clientContext, req));
 
   while (reader->Read(&res)) {
@@ -371,8 +734,117 @@ Status Client::get(const chord::uri &uri, const chord::node& node, std::ostream
 
 Status Client::get(const chord::uri &uri, ostream &ostream) {
   const auto hash = chord::crypto::sha256(uri);
-  const auto node = chord->successor(hash);
-  return get(uri, node, ostream);
+  // nothing has been written to the stream if the owner does not know the file
+  return with_successor(hash, [&](const chord::node& node) {
+    return get(uri, node, ostream);
+  });
+}
+
+std::vector<chord::node> Client::replica_nodes(const chord::uuid& hash, const std::uint32_t count) {
+  std::vector<chord::node> nodes{chord->successor(hash)};
+  try {
+    while(nodes.size() < count) {
+      const auto next = chord->successor(nodes.back().uuid + chord::uuid{1});
+      // less nodes than replicas
+      if(std::find(nodes.begin(), nodes.end(), next) != nodes.end()) break;
+      nodes.push_back(next);
+    }
+  } catch(const chord::exception& error) {
+    logger->debug("[get] failed to look up the replicas of {}: {}", hash, error.what());
+  }
+  return nodes;
+}
+
+Status Client::get(const chord::uri& uri, const chord::path& path, const std::uint64_t range_size) {
+  std::set<Metadata> metadata;
+  const auto status = dir(uri, metadata);
+  const auto meta = std::find_if(metadata.begin(), metadata.end(), [&](const Metadata& m) {
+      return m.name == uri.path().filename() && m.file_type == type::regular;
+  });
+
+  const auto get_whole = [&] {
+    std::ofstream ofile;
+    ofile.exceptions(ofstream::failbit | ofstream::badbit);
+    ofile.open(path, fstream::binary);
+    return get(uri, ofile);
+  };
+
+  if(!status.ok() || meta == metadata.end() || range_size == 0 || meta->file_size <= range_size) {
+    return get_whole();
+  }
+
+  const auto size = static_cast<std::uint64_t>(meta->file_size);
+  const auto ranges = (size + range_size - 1) / range_size;
+  const auto nodes = replica_nodes(chord::crypto::sha256(uri), std::max<std::uint32_t>(meta->replication.count, 1));
+  logger->trace("[get] {} in {} ranges from {} nodes", uri, ranges, nodes.size());
+
+  {
+    std::ofstream ofile;
+    ofile.exceptions(ofstream::failbit | ofstream::badbit);
+    ofile.open(path, fstream::binary | fstream::trunc);
+  }
+  file::resize_file(path, size);
+
+  std::atomic<std::uint64_t> next{0};
+  std::mutex mtx;
+  Status failed;
+
+  // every worker starts on a node of its own and fails over to the next ones
+  const auto fetch = [&](const std::size_t worker) {
+    try {
+      std::ofstream ofile;
+      ofile.exceptions(ofstream::failbit | ofstream::badbit);
+      ofile.open(path, fstream::binary | fstream::in);
+
+      for(auto range = next++; range < ranges; range = next++) {
+        {
+          const std::lock_guard<std::mutex> lock{mtx};
+          if(!failed.ok()) return;
+        }
+        const auto offset = range * range_size;
+        const auto length = std::min(range_size, size - offset);
+
+        Status range_status;
+        for(std::size_t attempt = 0; attempt < nodes.size(); ++attempt) {
+          const auto& node = nodes[(worker + attempt) % nodes.size()];
+          ofile.seekp(static_cast<std::streamoff>(offset));
+          range_status = get(uri, node, ofile, offset, length);
+          if(range_status.ok() && static_cast<std::uint64_t>(ofile.tellp()) != offset + length) {
+            range_status = {StatusCode::DATA_LOSS, "short range"};
+          }
+          if(range_status.ok()) break;
+          logger->warn("[get] failed to get {} ({}+{}) from {}: {}", uri, offset, length, node, range_status.error_message());
+        }
+
+        if(!range_status.ok()) {
+          const std::lock_guard<std::mutex> lock{mtx};
+          failed = range_status;
+          return;
+        }
+      }
+    } catch(const std::exception& error) {
+      const std::lock_guard<std::mutex> lock{mtx};
+      failed = {StatusCode::INTERNAL, fmt::format("failed to get {}: {}", uri, error.what())};
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(std::size_t worker = 0; worker < std::min<std::uint64_t>(nodes.size(), ranges); ++worker) {
+    workers.emplace_back(fetch, worker);
+  }
+  for(auto& worker : workers) worker.join();
+
+  if(!failed.ok()) {
+    logger->warn("[get] failed to get the ranges of {}: {} - getting the file from the owner.", uri, failed.error_message());
+    return get_whole();
+  }
+
+  // a replica lagging behind the owner
+  if(meta->file_hash && crypto::sha256(path) != *meta->file_hash) {
+    logger->warn("[get] hash mismatch of the ranges of {} - getting the file from the owner.", uri);
+    return get_whole();
+  }
+  return Status::OK;
 }
 
 } // namespace fs
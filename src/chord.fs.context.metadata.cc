@@ -2,6 +2,7 @@
 
 #include <grpcpp/impl/codegen/client_context.h>
 #include <grpcpp/impl/codegen/server_context.h>
+#include <chrono>
 #include <string>
 #include <istream>
 #include <cstdlib>
@@ -20,41 +21,62 @@ using grpc::ServerContext;
 namespace chord {
 namespace fs {
 
-client::options ContextMetadata::from(const grpc::ServerContext* serverContext) {
+client::options ContextMetadata::from(const grpc::ServerContextBase* serverContext) {
   client::options options;
   options.replication = replication_from(serverContext);
   options.source = src_from(serverContext);
   options.rebalance = rebalance_from(serverContext);
+  if(serverContext->deadline() != std::chrono::system_clock::time_point::max()) {
+    options.deadline = serverContext->deadline();
+  }
   return options;
 }
 
-void ContextMetadata::add(ClientContext& context, const Metadata& metadata) {
-  if(metadata.file_hash) {
-    context.AddMetadata(ContextMetadata::file_hash, metadata.file_hash.value().string());
-  }
+void ContextMetadata::add(ClientContext& context, const Metadata& metadata, const bool legacy_uuids) {
+  add(context, metadata.file_hash, legacy_uuids);
   add(context, metadata.replication);
 }
 void ContextMetadata::add(grpc::ClientContext& context, const chord::uri& uri) {
   context.AddMetadata(ContextMetadata::uri, to_string(uri));
 }
-void ContextMetadata::add(grpc::ClientContext& context, std::istream& input) {
-  ContextMetadata::add(context, chord::crypto::sha256(input));
+void ContextMetadata::add(grpc::ClientContext& context, std::istream& input, const bool legacy_uuids) {
+  ContextMetadata::add(context, chord::crypto::sha256(input), legacy_uuids);
   input.clear();
   input.seekg(0, std::ios::beg);
 }
-void ContextMetadata::add(grpc::ClientContext& context, const std::optional<chord::uuid>& hash) {
-  if(hash) context.AddMetadata(ContextMetadata::file_hash, *hash);
+void ContextMetadata::add(grpc::ClientContext& context, const std::optional<chord::uuid>& hash, const bool legacy_uuids) {
+  if(!hash) return;
+  context.AddMetadata(ContextMetadata::file_hash_bin, hash->bytes());
+  if(legacy_uuids) context.AddMetadata(ContextMetadata::file_hash, *hash);
 }
 
-void ContextMetadata::add_src(grpc::ClientContext& context, const chord::uuid& src) {
-  context.AddMetadata(ContextMetadata::src, src);
+void ContextMetadata::add_src(grpc::ClientContext& context, const chord::uuid& src, const bool legacy_uuids) {
+  context.AddMetadata(ContextMetadata::src_bin, src.bytes());
+  if(legacy_uuids) context.AddMetadata(ContextMetadata::src, src);
 }
 
 void ContextMetadata::add_rebalance(grpc::ClientContext& context, const bool rebalance) {
   context.AddMetadata(ContextMetadata::rebalance, grpc::to_string(rebalance));
 }
 
-void ContextMetadata::set_file_hash_equal(grpc::ServerContext* context, const bool metadata_only) {
+void ContextMetadata::add_delta(grpc::ClientContext& context, const chord::uuid& base, const std::uint64_t file_size) {
+  context.AddMetadata(ContextMetadata::delta_base_bin, base.bytes());
+  context.AddMetadata(ContextMetadata::file_size, std::to_string(file_size));
+}
+
+void ContextMetadata::set_delta_accepted(grpc::ServerContextBase* context, const bool accepted) {
+  context->AddInitialMetadata(ContextMetadata::delta_accepted, accepted ? "true" : "false");
+}
+
+void ContextMetadata::add_resume(grpc::ClientContext& context, const std::uint64_t file_size) {
+  context.AddMetadata(ContextMetadata::resume, std::to_string(file_size));
+}
+
+void ContextMetadata::set_committed_offset(grpc::ServerContextBase* context, const std::uint64_t offset) {
+  context->AddInitialMetadata(ContextMetadata::committed_offset, std::to_string(offset));
+}
+
+void ContextMetadata::set_file_hash_equal(grpc::ServerContextBase* context, const bool metadata_only) {
   context->AddInitialMetadata(ContextMetadata::file_hash_equal, metadata_only ? "true" : "false");
 }
 
@@ -63,16 +85,11 @@ void ContextMetadata::add(ClientContext& context, const Replication& repl) {
   context.AddMetadata(ContextMetadata::replication_count, std::to_string(repl.count));
 }
 
-std::optional<chord::uuid> ContextMetadata::file_hash_from(const grpc::ServerContext* serverContext) {
-  const auto metadata = serverContext->client_metadata();
-  if(metadata.count(ContextMetadata::file_hash) > 0) {
-    const auto file_hash = metadata.find(ContextMetadata::file_hash)->second;
-    return chord::uuid{std::string(file_hash.begin(), file_hash.end())};
-  }
-  return {};
+std::optional<chord::uuid> ContextMetadata::file_hash_from(const grpc::ServerContextBase* serverContext) {
+  return uuid_from(serverContext, ContextMetadata::file_hash_bin, ContextMetadata::file_hash);
 }
 
-chord::uri ContextMetadata::uri_from(const grpc::ServerContext* serverContext) {
+chord::uri ContextMetadata::uri_from(const grpc::ServerContextBase* serverContext) {
   const auto metadata = serverContext->client_metadata();
   if(metadata.count(ContextMetadata::uri) == 0) {
     throw__exception("missing uri metadata in server context.");
@@ -81,7 +98,7 @@ chord::uri ContextMetadata::uri_from(const grpc::ServerContext* serverContext) {
   return chord::uri{std::string(uri_gstr.begin(), uri_gstr.end())};
 }
 
-Replication ContextMetadata::replication_from(const ServerContext* serverContext) {
+Replication ContextMetadata::replication_from(const grpc::ServerContextBase* serverContext) {
   const auto metadata = serverContext->client_metadata();
   Replication repl;
   if(metadata.count(ContextMetadata::replication_index) > 0 
@@ -95,13 +112,19 @@ Replication ContextMetadata::replication_from(const ServerContext* serverContext
   return repl;
 }
 
-std::optional<chord::uuid> ContextMetadata::src_from(const grpc::ServerContext* serverContext) {
-  const auto metadata = serverContext->client_metadata();
-  if(metadata.count(ContextMetadata::src) == 0) {
-    return {};
+std::optional<chord::uuid> ContextMetadata::src_from(const grpc::ServerContextBase* serverContext) {
+  return uuid_from(serverContext, ContextMetadata::src_bin, ContextMetadata::src);
+}
+
+std::optional<chord::uuid> ContextMetadata::uuid_from(const grpc::ServerContextBase* serverContext, const char* bin_key, const char* legacy_key) {
+  const auto& metadata = serverContext->client_metadata();
+  if(const auto it = metadata.find(bin_key); it != metadata.end()) {
+    return chord::uuid::from_bytes({it->second.data(), it->second.size()});
   }
-  const auto id_gstr = metadata.find(ContextMetadata::src)->second;
-  return chord::uuid{std::string(id_gstr.begin(), id_gstr.end())};
+  if(const auto it = metadata.find(legacy_key); it != metadata.end()) {
+    return chord::uuid{std::string(it->second.begin(), it->second.end())};
+  }
+  return {};
 }
 
 bool ContextMetadata::file_hash_equal_from(const grpc::ClientContext& clientContext) {
@@ -113,7 +136,48 @@ bool ContextMetadata::file_hash_equal_from(const grpc::ClientContext& clientCont
   return false;
 }
 
-bool ContextMetadata::rebalance_from(const grpc::ServerContext* serverContext) {
+std::optional<chord::uuid> ContextMetadata::delta_base_from(const grpc::ServerContextBase* serverContext) {
+  const auto& metadata = serverContext->client_metadata();
+  if(const auto it = metadata.find(ContextMetadata::delta_base_bin); it != metadata.end()) {
+    return chord::uuid::from_bytes({it->second.data(), it->second.size()});
+  }
+  return {};
+}
+
+std::optional<std::uint64_t> ContextMetadata::file_size_from(const grpc::ServerContextBase* serverContext) {
+  const auto& metadata = serverContext->client_metadata();
+  if(const auto it = metadata.find(ContextMetadata::file_size); it != metadata.end()) {
+    return std::strtoull(std::string(it->second.begin(), it->second.end()).c_str(), nullptr, 10);
+  }
+  return {};
+}
+
+bool ContextMetadata::delta_accepted_from(const grpc::ClientContext& clientContext) {
+  const auto metadata = clientContext.GetServerInitialMetadata();
+  if(metadata.count(ContextMetadata::delta_accepted) > 0) {
+    const auto& val = metadata.find(ContextMetadata::delta_accepted)->second;
+    return (val == "1" || val == "true");
+  }
+  return false;
+}
+
+std::optional<std::uint64_t> ContextMetadata::resume_from(const grpc::ServerContextBase* serverContext) {
+  const auto& metadata = serverContext->client_metadata();
+  if(const auto it = metadata.find(ContextMetadata::resume); it != metadata.end()) {
+    return std::strtoull(std::string(it->second.begin(), it->second.end()).c_str(), nullptr, 10);
+  }
+  return {};
+}
+
+std::optional<std::uint64_t> ContextMetadata::committed_offset_from(const grpc::ClientContext& clientContext) {
+  const auto metadata = clientContext.GetServerInitialMetadata();
+  if(const auto it = metadata.find(ContextMetadata::committed_offset); it != metadata.end()) {
+    return std::strtoull(std::string(it->second.begin(), it->second.end()).c_str(), nullptr, 10);
+  }
+  return {};
+}
+
+bool ContextMetadata::rebalance_from(const grpc::ServerContextBase* serverContext) {
   const auto metadata = serverContext->client_metadata();
   if(metadata.count(ContextMetadata::rebalance) > 0) {
     const auto& val = metadata.find(ContextMetadata::rebalance)->second;
@@ -40,8 +40,10 @@ Facade::Facade(Context& context, ChordFacade* chord, ChannelPool* channel_pool)
       monitor{context.monitor ? make_unique<fs::monitor>(context) : nullptr},
       fs_client{make_unique<fs::Client>(context, chord, metadata_mgr.get(), channel_pool)},
       fs_service{make_unique<fs::Service>(context, chord, metadata_mgr.get(), fs_client.get(), monitor.get())},
+      fs_callback_service{context.fs_async_server ? make_unique<fs::CallbackService>(context, fs_service.get()) : nullptr},
       logger{context.logging.factory().get_or_create(logger_name)}
 {
+  fs_client->set_local_service(fs_service.get());
   if(monitor) {
     monitor->events().connect(&Facade::on_fs_event, this);
   }
@@ -63,6 +65,7 @@ Facade::~Facade() {
 }
 
 ::grpc::Service* Facade::grpc_service() {
+  if(fs_callback_service) return fs_callback_service.get();
   return fs_service.get();
 }
 
@@ -246,7 +249,7 @@ Status Facade::rebalance_metadata(const uri& uri, const bool shallow_copy) {
     //if(shallow_copy && is_regular_file(metadata_deleted) && status.error_code() == StatusCode::ALREADY_EXISTS) {
       // metadata already exists on the host - including the local file (!)
       if(is_regular_file(metadata_deleted))
-        fs::util::remove(uri, context, monitor.get());
+        fs_service->remove_local(uri);
       return Status::OK;
     }
 
@@ -264,7 +267,9 @@ void Facade::rebalance(const IMetadataManager::uri_meta_map_desc& metadata, cons
     auto metadata_set = pair.second;
 
     const auto local_path = context.data_directory / uri.path();
-    const bool exists = chord::file::exists(local_path) && chord::file::is_regular_file(local_path);
+    // files of the chunk store have no local copy
+    const bool chunked = context.fs_chunk_store && !chord::file::exists(local_path) && metadata_mgr->recipe(uri);
+    const bool exists = chunked || (chord::file::exists(local_path) && chord::file::is_regular_file(local_path));
     const bool is_shallow_copy = !exists && fs::is_shallow_copy(metadata_set, context);
     const bool is_shallow_copyable = event != RebalanceEvent::LEAVE
                                       && fs::is_shallow_copyable(metadata_set, context);
@@ -272,7 +277,7 @@ void Facade::rebalance(const IMetadataManager::uri_meta_map_desc& metadata, cons
     // handle metadata only
     if(fs::is_directory(metadata_set) || is_shallow_copy || is_shallow_copyable) {
       rebalance_metadata(uri, is_shallow_copyable);
-    } else if(file::exists(local_path)){
+    } else if(chunked || file::exists(local_path)){
       logger->info("[rebalance] trying to rebalance file {}", local_path);
       auto metadata = *metadata_set.begin();
       client::options options;
@@ -282,7 +287,8 @@ void Facade::rebalance(const IMetadataManager::uri_meta_map_desc& metadata, cons
       options.rebalance = true;
       // note that we put the file from the beginning node to refresh all replications
       try {
-        const auto status = fs_client->put(uri, local_path, options);
+        const auto status = chunked ? fs_client->put(uri, *fs_service->open(uri), options)
+                                    : fs_client->put(uri, local_path, options);
       } catch(chord::exception& e) {
         logger->error("[rebalance] failed to put file {}:{}", uri, e.message());
       }
@@ -334,7 +340,8 @@ void Facade::initialize(const IMetadataManager::uri_meta_map_desc& metadata) {
       continue;
     }
     const auto data = context.data_directory / uri.path();
-    if(!file::exists(data)) {
+    const bool chunked = context.fs_chunk_store && metadata_mgr->recipe(uri);
+    if(!file::exists(data) && !chunked) {
       logger->info("[initialize] tracking {}", uri);
       std::set<Metadata> metadata;
       // check for shallow copies
@@ -0,0 +1,280 @@
+#include "chord.fs.metadata.codec.h"
+
+#include <sstream>
+#include <utility>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/serialization/map.hpp>
+
+#include "chord.exception.h"
+#include "chord.fs.perms.h"
+#include "chord.fs.replication.h"
+#include "chord.fs.type.h"
+#include "chord.node.h"
+#include "chord.uuid.h"
+
+namespace chord {
+namespace fs {
+
+namespace {
+
+enum flag : std::uint8_t {
+  FILE_HASH = 1 << 0,
+  NODE_REF = 1 << 1
+};
+
+void put_varint(std::string& out, std::uint64_t value) {
+  while(value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void put_string(std::string& out, const std::string_view str) {
+  put_varint(out, str.size());
+  out.append(str);
+}
+
+void put_uuid(std::string& out, const chord::uuid& uuid) {
+  out.append(uuid.bytes());
+}
+
+struct reader {
+  std::string_view data;
+  std::size_t pos{0};
+
+  void require(const std::size_t len) const {
+    if(data.size() - pos < len) throw__exception("failed to decode metadata: unexpected end of record.");
+  }
+
+  std::uint8_t byte() {
+    require(1);
+    return static_cast<std::uint8_t>(data[pos++]);
+  }
+
+  std::uint64_t varint() {
+    std::uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7) {
+      const auto b = byte();
+      value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+      if(!(b & 0x80)) return value;
+    }
+    throw__exception("failed to decode metadata: malformed varint.");
+  }
+
+  std::string_view bytes(const std::size_t len) {
+    require(len);
+    const auto ret = data.substr(pos, len);
+    pos += len;
+    return ret;
+  }
+
+  std::string string() {
+    return std::string{bytes(static_cast<std::size_t>(varint()))};
+  }
+
+  chord::uuid uuid() {
+    return chord::uuid::from_bytes(bytes(chord::uuid::UUID_BYTES));
+  }
+
+  template<typename T>
+  T as() {
+    return static_cast<T>(varint());
+  }
+};
+
+void check_header(reader& in) {
+  if(in.byte() != MetadataCodec::MAGIC) {
+    throw__exception("failed to decode metadata: invalid magic byte.");
+  }
+  const auto version = in.byte();
+  if(version != MetadataCodec::VERSION) {
+    throw__exception("failed to decode metadata: unsupported version " + std::to_string(version) + ".");
+  }
+}
+
+Metadata decode_metadata(reader& in) {
+  Metadata meta;
+  meta.name = in.string();
+  meta.owner = in.string();
+  meta.group = in.string();
+  meta.permissions = in.as<perms>();
+  meta.file_type = in.as<type>();
+  meta.file_size = in.varint();
+
+  const auto flags = in.byte();
+  if(flags & FILE_HASH) {
+    meta.file_hash = in.uuid();
+  }
+  if(flags & NODE_REF) {
+    auto id = in.uuid();
+    meta.node_ref = chord::node{std::move(id), in.string()};
+  }
+  meta.replication.index = in.as<std::uint32_t>();
+  meta.replication.count = in.as<std::uint32_t>();
+  return meta;
+}
+
+} // namespace
+
+void MetadataCodec::encode(const Metadata& meta, std::string& out) {
+  put_string(out, meta.name);
+  put_string(out, meta.owner);
+  put_string(out, meta.group);
+  put_varint(out, value_of(meta.permissions));
+  put_varint(out, value_of(meta.file_type));
+  put_varint(out, meta.file_size);
+
+  std::uint8_t flags = 0;
+  if(meta.file_hash) flags |= FILE_HASH;
+  if(meta.node_ref) flags |= NODE_REF;
+  out.push_back(static_cast<char>(flags));
+
+  if(meta.file_hash) {
+    put_uuid(out, *meta.file_hash);
+  }
+  if(meta.node_ref) {
+    put_uuid(out, meta.node_ref->uuid);
+    put_string(out, meta.node_ref->endpoint);
+  }
+  put_varint(out, meta.replication.index);
+  put_varint(out, meta.replication.count);
+}
+
+std::string MetadataCodec::encode(const std::map<std::string, Metadata>& metadata) {
+  std::string out;
+  // rough estimate to avoid most of the reallocations
+  out.reserve(2 + 5 + metadata.size() * 64);
+  out.push_back(static_cast<char>(MAGIC));
+  out.push_back(static_cast<char>(VERSION));
+  put_varint(out, metadata.size());
+  for(const auto& [_, meta] : metadata) {
+    encode(meta, out);
+  }
+  return out;
+}
+
+std::string MetadataCodec::encode_entry(const Metadata& metadata) {
+  std::string out;
+  out.reserve(2 + 64);
+  out.push_back(static_cast<char>(MAGIC));
+  out.push_back(static_cast<char>(VERSION));
+  encode(metadata, out);
+  return out;
+}
+
+Metadata MetadataCodec::decode_entry(const std::string_view data) {
+  reader in{data};
+  check_header(in);
+  return decode_metadata(in);
+}
+
+bool MetadataCodec::is_legacy(const std::string_view data) {
+  return !data.empty() && static_cast<std::uint8_t>(data.front()) != MAGIC;
+}
+
+std::map<std::string, Metadata> MetadataCodec::decode_legacy(const std::string_view data) {
+  std::map<std::string, Metadata> ret;
+  std::stringstream ss{std::string{data}};
+  boost::archive::text_iarchive ia{ss};
+  ia >> ret;
+  return ret;
+}
+
+std::map<std::string, Metadata> MetadataCodec::decode(const std::string_view data) {
+  std::map<std::string, Metadata> ret;
+  if(data.empty()) return ret;
+  if(is_legacy(data)) return decode_legacy(data);
+
+  reader in{data};
+  check_header(in);
+
+  const auto count = in.varint();
+  for(std::uint64_t i = 0; i < count; ++i) {
+    auto meta = decode_metadata(in);
+    auto name = meta.name;
+    ret.emplace_hint(ret.end(), std::move(name), std::move(meta));
+  }
+  return ret;
+}
+
+std::string MetadataCodec::encode_chunks(const ChunkManifest& manifest) {
+  std::string out;
+  out.reserve(2 + chord::uuid::UUID_BYTES * (manifest.chunks.size() + 1) + 3 * 10);
+  out.push_back(static_cast<char>(MAGIC));
+  out.push_back(static_cast<char>(VERSION));
+  put_uuid(out, manifest.file_hash);
+  put_varint(out, manifest.chunk_size);
+  put_varint(out, manifest.file_size);
+  put_varint(out, manifest.chunks.size());
+  for(const auto& chunk : manifest.chunks) {
+    put_uuid(out, chunk);
+  }
+  return out;
+}
+
+ChunkManifest MetadataCodec::decode_chunks(const std::string_view data) {
+  reader in{data};
+  check_header(in);
+
+  ChunkManifest manifest;
+  manifest.file_hash = in.uuid();
+  manifest.chunk_size = in.varint();
+  manifest.file_size = in.varint();
+  const auto count = in.varint();
+  if(manifest.chunk_size == 0 || count != ChunkManifest::count(manifest.file_size, manifest.chunk_size)) {
+    throw__exception("failed to decode chunk manifest: invalid chunk count.");
+  }
+  if(count > (data.size() - in.pos) / chord::uuid::UUID_BYTES) {
+    throw__exception("failed to decode chunk manifest: unexpected end of record.");
+  }
+  manifest.chunks.reserve(count);
+  for(std::uint64_t i = 0; i < count; ++i) {
+    manifest.chunks.push_back(in.uuid());
+  }
+  return manifest;
+}
+
+std::string MetadataCodec::encode_recipe(const ChunkRecipe& recipe) {
+  std::string out;
+  out.reserve(2 + chord::uuid::UUID_BYTES + 2 * 10 + (chord::uuid::UUID_BYTES + 3) * recipe.chunks.size());
+  out.push_back(static_cast<char>(MAGIC));
+  out.push_back(static_cast<char>(VERSION));
+  put_uuid(out, recipe.file_hash);
+  put_varint(out, recipe.file_size);
+  put_varint(out, recipe.chunks.size());
+  for(const auto& chunk : recipe.chunks) {
+    put_uuid(out, chunk.hash);
+    put_varint(out, chunk.size);
+  }
+  return out;
+}
+
+ChunkRecipe MetadataCodec::decode_recipe(const std::string_view data) {
+  reader in{data};
+  check_header(in);
+
+  ChunkRecipe recipe;
+  recipe.file_hash = in.uuid();
+  recipe.file_size = in.varint();
+  const auto count = in.varint();
+  if(count > (data.size() - in.pos) / (chord::uuid::UUID_BYTES + 1)) {
+    throw__exception("failed to decode chunk recipe: unexpected end of record.");
+  }
+  recipe.chunks.reserve(count);
+  std::uint64_t size = 0;
+  for(std::uint64_t i = 0; i < count; ++i) {
+    auto& chunk = recipe.chunks.emplace_back();
+    chunk.hash = in.uuid();
+    chunk.size = in.as<std::uint32_t>();
+    size += chunk.size;
+  }
+  if(size != recipe.file_size) {
+    throw__exception("failed to decode chunk recipe: chunk sizes do not match the file size.");
+  }
+  return recipe;
+}
+
+}  // namespace fs
+}  // namespace chord
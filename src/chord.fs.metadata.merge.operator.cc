@@ -0,0 +1,27 @@
+#include "chord.fs.metadata.merge.operator.h"
+
+namespace chord {
+namespace fs {
+
+bool DirectoryEntryMergeOperator::Merge([[maybe_unused]] const rocksdb::Slice& key,
+                                        const rocksdb::Slice* existing_value,
+                                        const rocksdb::Slice& value, std::string* new_value,
+                                        [[maybe_unused]] rocksdb::Logger* logger) const {
+  if(!existing_value || existing_value->empty()) {
+    new_value->clear();
+  } else {
+    new_value->assign(value.data(), value.size());
+  }
+  return true;
+}
+
+bool EmptyEntryCompactionFilter::Filter([[maybe_unused]] int level,
+                                        [[maybe_unused]] const rocksdb::Slice& key,
+                                        const rocksdb::Slice& existing_value,
+                                        [[maybe_unused]] std::string* new_value,
+                                        [[maybe_unused]] bool* value_changed) const {
+  return existing_value.empty();
+}
+
+}  // namespace fs
+}  // namespace chord
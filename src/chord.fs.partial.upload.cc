@@ -0,0 +1,197 @@
+#include "chord.fs.partial.upload.h"
+
+#include <filesystem>
+#include <string>
+
+#include "chord.context.h"
+#include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.log.factory.h"
+#include "chord.log.h"
+
+namespace chord {
+namespace fs {
+
+namespace {
+
+void put_uint64(std::string& out, const std::uint64_t value) {
+  for(int shift = 56; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+std::uint64_t get_uint64(const std::string& in, const std::size_t pos) {
+  std::uint64_t value = 0;
+  for(std::size_t i = 0; i < 8; ++i) {
+    value = (value << 8) | static_cast<unsigned char>(in[pos + i]);
+  }
+  return value;
+}
+
+// file hash | file size | committed offset | state of the hasher
+constexpr std::size_t state_size = 32 + 8 + 8 + crypto::sha256_hasher::state_size;
+
+}
+
+std::unique_ptr<PartialUpload> PartialUpload::open(Registry& registry, const Context& context, const chord::uri& uri, const chord::uuid& file_hash, const std::uint64_t file_size) {
+  {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    if(!registry.uris.insert(uri).second) return nullptr;
+  }
+  try {
+    return std::unique_ptr<PartialUpload>(new PartialUpload{registry, context, uri, file_hash, file_size});
+  } catch(...) {
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.uris.erase(uri);
+    throw;
+  }
+}
+
+void PartialUpload::expire(const Context& context) {
+  const auto directory = context.partial_directory();
+  if(!context.fs_partial_expiry_h || !file::exists(directory)) return;
+
+  const auto expired = std::filesystem::file_time_type::clock::now() - std::chrono::hours(context.fs_partial_expiry_h);
+  std::error_code ec;
+  for(const auto& entry : std::filesystem::directory_iterator(directory.string(), ec)) {
+    if(entry.last_write_time(ec) < expired && !ec) std::filesystem::remove(entry.path(), ec);
+  }
+}
+
+PartialUpload::PartialUpload(Registry& registry, const Context& context, const chord::uri& uri, const chord::uuid& file_hash, const std::uint64_t file_size)
+  : registry{registry},
+    uri{uri},
+    file_hash{file_hash},
+    file_size{file_size},
+    logger{context.logging.factory().get_or_create(logger_name)} {
+  const auto directory = context.partial_directory();
+  if(!file::exists(directory)) file::create_directories(directory);
+
+  const auto name = crypto::sha256(uri).hex();
+  data_path = directory / name;
+  state_path = directory / (name + ".state");
+
+  if(restore()) {
+    logger->debug("[partial] resuming {} at {} of {} bytes", uri, committed, file_size);
+  } else {
+    hasher = crypto::sha256_hasher{};
+    committed = 0;
+  }
+  saved = committed;
+  saved_at = std::chrono::steady_clock::now();
+
+  out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  if(committed == 0) {
+    out.open(data_path, std::fstream::binary | std::fstream::trunc);
+  } else {
+    out.open(data_path, std::fstream::binary | std::fstream::in);
+    out.seekp(static_cast<std::streamoff>(committed));
+  }
+}
+
+PartialUpload::~PartialUpload() {
+  try {
+    if(out.is_open() && committed != saved) save();
+  } catch(const std::exception& error) {
+    logger->warn("[partial] failed to save {}: {}", state_path, error.what());
+  }
+  std::lock_guard<std::mutex> lock(registry.mtx);
+  registry.uris.erase(uri);
+}
+
+bool PartialUpload::restore() {
+  if(!file::exists(state_path) || !file::exists(data_path)) return false;
+
+  try {
+    std::ifstream in;
+    in.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    in.open(state_path, std::fstream::binary);
+    std::string saved(state_size, '\0');
+    in.read(saved.data(), static_cast<std::streamsize>(saved.size()));
+
+    // upload of another version of the file
+    if(chord::uuid::from_bytes(saved.substr(0, 32)) != file_hash || get_uint64(saved, 32) != file_size) return false;
+
+    const auto offset = get_uint64(saved, 40);
+    // data lost (e.g. crash before the data has been written)
+    if(offset > file_size || file::file_size(data_path) < offset) return false;
+
+    hasher = crypto::sha256_hasher{saved.substr(48)};
+    committed = offset;
+    // drop the data received after the state has been saved
+    file::resize_file(data_path, offset);
+    return true;
+  } catch(const std::exception& error) {
+    logger->warn("[partial] failed to restore {}: {} - starting over.", state_path, error.what());
+    return false;
+  }
+}
+
+void PartialUpload::save() {
+  // the saved state never runs ahead of the data
+  out.flush();
+
+  std::string state;
+  state.reserve(state_size);
+  state.append(file_hash.bytes());
+  put_uint64(state, file_size);
+  put_uint64(state, committed);
+  state.append(hasher.state());
+
+  // written aside: an interrupted save leaves the previous state
+  const auto tmp = state_path.string() + ".tmp";
+  {
+    std::ofstream file;
+    file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    file.open(tmp, std::fstream::binary | std::fstream::trunc);
+    file.write(state.data(), static_cast<std::streamsize>(state.size()));
+  }
+  file::rename(tmp, state_path);
+  saved = committed;
+  saved_at = std::chrono::steady_clock::now();
+}
+
+void PartialUpload::write(const std::uint64_t offset, const char* data, const std::size_t len) {
+  if(offset != committed) {
+    throw__exception("unexpected offset " + std::to_string(offset) + " (committed " + std::to_string(committed) + ")");
+  }
+  if(len > file_size - committed) {
+    throw__exception("data beyond the announced file size");
+  }
+
+  out.write(data, static_cast<std::streamsize>(len));
+  hasher(data, len);
+  committed += len;
+  if(committed - saved >= save_bytes || std::chrono::steady_clock::now() - saved_at >= save_period) save();
+}
+
+void PartialUpload::finish(const chord::path& target) {
+  if(!complete()) {
+    throw__exception("incomplete upload (" + std::to_string(committed) + " of " + std::to_string(file_size) + " bytes)");
+  }
+  out.close();
+
+  const auto hash = hasher.get();
+  if(hash != file_hash) {
+    discard();
+    throw__exception("hash mismatch of the received file");
+  }
+
+  try {
+    file::rename(data_path, target);
+  } catch(const std::filesystem::filesystem_error&) {
+    // journal and data directory on different file systems
+    file::copy_file(data_path, target, true);
+    file::remove(data_path);
+  }
+  file::remove(state_path);
+}
+
+void PartialUpload::discard() {
+  if(out.is_open()) out.close();
+  if(file::exists(data_path)) file::remove(data_path);
+  if(file::exists(state_path)) file::remove(state_path);
+}
+
+} // namespace fs
+} // namespace chord
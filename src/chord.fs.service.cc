@@ -13,6 +13,7 @@
 
 #include "chord.fs.common.h"
 #include "chord.fs.monitor.h"
+#include "chord.common.h"
 #include "chord.context.h"
 #include "chord.crypto.h"
 #include "chord.exception.h"
@@ -23,6 +24,8 @@
 #include "chord.fs.metadata.builder.h"
 #include "chord.fs.metadata.h"
 #include "chord.fs.metadata.manager.h"
+#include "chord.fs.partial.upload.h"
+#include "chord.fs.perms.h"
 #include "chord.fs.replication.h"
 #include "chord.fs.util.h"
 #include "chord.fs.type.h"
@@ -44,6 +47,11 @@ using chord::fs::PutResponse;
 using chord::fs::PutRequest;
 using chord::fs::GetResponse;
 using chord::fs::GetRequest;
+using chord::fs::ChunksRequest;
+using chord::fs::ChunksResponse;
+using chord::fs::MissingRequest;
+using chord::fs::MissingResponse;
+using chord::fs::AssembleRequest;
 
 
 using namespace std;
@@ -59,10 +67,27 @@ Service::Service(Context &context, ChordFacade* chord, IMetadataManager* metadat
       metadata_mgr{metadata_mgr},
       monitor{monitor},
       make_client {[this]{ return this->client; }},
-      logger{context.logging.factory().get_or_create(logger_name)} { }
+      logger{context.logging.factory().get_or_create(logger_name)},
+      chunk_store{context.fs_chunk_store ? std::make_unique<ChunkStore>(context, metadata_mgr) : nullptr} {
+  PartialUpload::expire(context);
+}
 
-Status Service::is_valid(ServerContext* serverContext, [[maybe_unused]] const RequestType req_type) {
-  const auto options = ContextMetadata::from(serverContext);
+template<typename Call>
+Status Service::with_successors(Call&& call) {
+  const auto successors = chord->successors();
+  if(successors.empty()) return call(chord->successor());
+
+  Status status;
+  for(const auto& node : successors) {
+    status = call(node);
+    const auto code = status.error_code();
+    if(code != StatusCode::UNAVAILABLE && code != StatusCode::DEADLINE_EXCEEDED) break;
+    logger->warn("[successors] {} is unavailable - failing over to the next successor.", node);
+  }
+  return status;
+}
+
+Status Service::is_valid(const client::options& options, [[maybe_unused]] const RequestType req_type) {
   const bool src_equals_this = options.source == context.uuid();
   if(src_equals_this) {
     const auto message = "received request from self.";
@@ -72,11 +97,21 @@ Status Service::is_valid(ServerContext* serverContext, [[maybe_unused]] const Re
   return Status::OK;
 }
 
+Status Service::is_responsible(const chord::uri& uri, const client::options& options) {
+  // replicas and rebalanced files are sent by the nodes of the ring
+  const bool initial_put = !options.source;
+  if(initial_put && !chord->is_responsible(chord::crypto::sha256(uri))) {
+    logger->debug("[put] {} is not owned by this node - rejecting.", uri);
+    return {StatusCode::NOT_FOUND, "not responsible for " + to_string(uri)};
+  }
+  return Status::OK;
+}
+
 client::options Service::init_source(const client::options& o) const {
   return chord::fs::client::init_source(o, context);
 }
 
-Status Service::handle_meta_dir([[maybe_unused]] ServerContext *serverContext, const MetaRequest *req, MetaResponse *res) {
+Status Service::handle_meta_dir(const MetaRequest *req, MetaResponse *res) {
   const auto uri = uri::from(req->uri());
 
   if(!metadata_mgr->exists(uri)) {
@@ -86,15 +121,14 @@ Status Service::handle_meta_dir([[maybe_unused]] ServerContext *serverContext, c
   }
 
   const auto meta = metadata_mgr->get(uri);
-  MetadataBuilder::addMetadata(meta, *res);
+  MetadataBuilder::addMetadata(meta, *res, context.legacy_uuids);
   return Status::OK;
 }
 
-Status Service::handle_meta_del(ServerContext *serverContext, const MetaRequest *req) {
+Status Service::handle_meta_del(const MetaRequest *req, const client::options& options) {
   const auto uri = uri::from(req->uri());
 
   auto deleted_metadata = metadata_mgr->del(uri, MetadataBuilder::from(req));
-  const auto options = ContextMetadata::from(serverContext);
 
   /**
    * increase and check replication
@@ -103,8 +137,9 @@ Status Service::handle_meta_del(ServerContext *serverContext, const MetaRequest
   std::set<Metadata> metadata = chord::fs::increase_replication_and_clean(deleted_metadata);
 
   if(/*!metadata.empty() && */!is_empty(metadata)) {
-    const auto node = chord->successor();
-    const auto status = make_client()->meta(node, uri, Client::Action::DEL, metadata, init_source(options));
+    with_successors([&](const chord::node& node) {
+      return make_client()->meta(node, uri, Client::Action::DEL, metadata, init_source(options));
+    });
   }
 
   /**
@@ -120,7 +155,7 @@ Status Service::handle_meta_del(ServerContext *serverContext, const MetaRequest
   return Status::OK;
 }
 
-Status Service::handle_meta_add(ServerContext *serverContext, const MetaRequest *req) {
+Status Service::handle_meta_add(const MetaRequest *req, const client::options& options) {
   const auto uri = uri::from(req->uri());
   auto metadata = MetadataBuilder::from(req);
 
@@ -143,8 +178,6 @@ Status Service::handle_meta_add(ServerContext *serverContext, const MetaRequest
 
   const auto added = metadata_mgr->add(uri, is_mkdir(uri, metadata) ? std::set{create_directory(metadata)} : metadata);
 
-  const auto options = ContextMetadata::from(serverContext);
-
   auto max_repl = max_replication(metadata);
   // update the parent (first node triggers replication)
   const auto parent_path = uri.path().parent_path();
@@ -161,11 +194,12 @@ Status Service::handle_meta_add(ServerContext *serverContext, const MetaRequest
     std::set<Metadata> new_metadata = chord::fs::increase_replication_and_clean(metadata);
 
     if(!new_metadata.empty()) {
-      const auto node = chord->successor();
-      const auto status = make_client()->meta(node, uri, Client::Action::ADD, new_metadata, init_source(options));
+      const auto status = with_successors([&](const chord::node& node) {
+        return make_client()->meta(node, uri, Client::Action::ADD, new_metadata, init_source(options));
+      });
 
       if(!is_successful(status)) {
-        logger->warn("[meta][add] failed to add {} ({}) to {}", uri, max_repl, node);
+        logger->warn("[meta][add] failed to add {} ({}) to successor", uri, max_repl);
       }
     }
   }
@@ -173,9 +207,13 @@ Status Service::handle_meta_add(ServerContext *serverContext, const MetaRequest
   return Status::OK;
 }
 
-Status Service::mov([[maybe_unused]] ServerContext *serverContext, const MovRequest *req, [[maybe_unused]] MovResponse *res) {
+Status Service::mov(ServerContext *serverContext, const MovRequest *req, MovResponse *res) {
+  return mov(req, res, ContextMetadata::from(serverContext));
+}
+
+Status Service::mov(const MovRequest *req, [[maybe_unused]] MovResponse *res, const client::options& options) {
   {
-    const auto status = is_valid(serverContext, RequestType::MOV);
+    const auto status = is_valid(options, RequestType::MOV);
     if(!status.ok()) {
       return status;
     }
@@ -183,7 +221,6 @@ Status Service::mov([[maybe_unused]] ServerContext *serverContext, const MovRequ
 
   const auto uri = uri::from(req->src());
   const auto dst = uri::from(req->dst());
-  const auto options = ContextMetadata::from(serverContext);
 
   // check metadata exists
   if(!metadata_mgr->exists(uri)) {
@@ -193,13 +230,15 @@ Status Service::mov([[maybe_unused]] ServerContext *serverContext, const MovRequ
   }
   // check file exists
   auto data = context.data_directory / uri.path();
-  if(!chord::file::exists(data)) {
+  const auto recipe = stored_recipe(uri);
+  if(!chord::file::exists(data) && !recipe) {
     const auto message = "not found: " + to_string(uri);
     logger->info(message);
     return Status{StatusCode::NOT_FOUND, message};
   }
 
-  auto status = make_client()->put(dst, data, options);
+  auto status = recipe ? make_client()->put(dst, *chunk_store->open(*recipe), options)
+                       : make_client()->put(dst, data, options);
   if(status.ok()) {
     return make_client()->del(uri);
   }
@@ -207,10 +246,14 @@ Status Service::mov([[maybe_unused]] ServerContext *serverContext, const MovRequ
   return status;
 }
 
-Status Service::meta([[maybe_unused]] ServerContext *serverContext, const MetaRequest *req, MetaResponse *res) {
+Status Service::meta(ServerContext *serverContext, const MetaRequest *req, MetaResponse *res) {
+  return meta(req, res, ContextMetadata::from(serverContext));
+}
+
+Status Service::meta(const MetaRequest *req, MetaResponse *res, const client::options& options) {
 
   // in case controller service queries...
-  const auto status = is_valid(serverContext, RequestType::META);
+  const auto status = is_valid(options, RequestType::META);
   if(!status.ok()) {
     return status;
   }
@@ -218,11 +261,11 @@ Status Service::meta([[maybe_unused]] ServerContext *serverContext, const MetaRe
   try {
     switch (req->action()) {
       case ADD:
-        return handle_meta_add(serverContext, req);
+        return handle_meta_add(req, options);
       case DEL:
-        return handle_meta_del(serverContext, req);
+        return handle_meta_del(req, options);
       case DIR:
-        return handle_meta_dir(serverContext, req, res);
+        return handle_meta_dir(req, res);
     }
   } catch(const chord::exception& e) {
     const auto uri = uri::from(req->uri());
@@ -233,7 +276,7 @@ Status Service::meta([[maybe_unused]] ServerContext *serverContext, const MetaRe
   return Status::OK;
 }
 
-bool Service::file_hashes_equal(grpc::ServerContext* serverContext, grpc::ServerReader<PutRequest>* reader) {
+bool Service::file_hashes_equal(grpc::ServerContextBase* serverContext) {
   const auto hash = ContextMetadata::file_hash_from(serverContext);
   const auto uri = ContextMetadata::uri_from(serverContext);
 
@@ -249,77 +292,285 @@ bool Service::file_hashes_equal(grpc::ServerContext* serverContext, grpc::Server
     }
   }
   ContextMetadata::set_file_hash_equal(serverContext, hashes_equal);
-  reader->SendInitialMetadata();
   return hashes_equal;
 }
 
-Status Service::put(ServerContext *serverContext, ServerReader<PutRequest> *reader, [[maybe_unused]] PutResponse *response) {
+std::optional<ChunkManifest> Service::stored_chunks(const chord::uri& uri) {
+  // files of the chunk store are not patched in place
+  if(chunk_store || !metadata_mgr->exists(uri)) return {};
 
-  const auto status = is_valid(serverContext, RequestType::PUT);
-  if(!status.ok()) {
-    return status;
+  const auto metadata_set = metadata_mgr->get(uri);
+  if(!fs::is_regular_file(metadata_set)) return {};
+
+  const auto file_hash = metadata_set.begin()->file_hash;
+  auto manifest = metadata_mgr->chunks(uri);
+  // file changed since the manifest has been stored
+  if(!file_hash || !manifest || manifest->file_hash != *file_hash) return {};
+  // no local copy to patch (e.g. node reference or shallow copy)
+  const auto data = context.data_directory / uri.path();
+  if(!file::exists(data) || file::file_size(data) != manifest->file_size) return {};
+  return manifest;
+}
+
+std::optional<ChunkManifest> Service::delta_base(grpc::ServerContextBase* serverContext, const chord::uri& uri, const bool hashes_equal) {
+  const auto base = ContextMetadata::delta_base_from(serverContext);
+  if(!base) return {};
+
+  std::optional<ChunkManifest> manifest;
+  if(!hashes_equal && ContextMetadata::file_size_from(serverContext)) {
+    manifest = stored_chunks(uri);
+    if(manifest && manifest->file_hash != *base) manifest.reset();
+  }
+  ContextMetadata::set_delta_accepted(serverContext, manifest.has_value());
+  return manifest;
+}
+
+Status Service::resumable_upload(grpc::ServerContextBase* serverContext, const chord::uri& uri, std::unique_ptr<PartialUpload>& upload) {
+  const auto file_hash = ContextMetadata::file_hash_from(serverContext);
+  const auto file_size = ContextMetadata::resume_from(serverContext);
+  if(!file_hash || !file_size) return Status::OK;
+
+  upload = PartialUpload::open(uploads, context, uri, *file_hash, *file_size);
+  if(!upload) {
+    logger->info("[put] {} is being received - aborting the concurrent put.", uri);
+    return {StatusCode::ABORTED, "put of the file in progress"};
+  }
+  ContextMetadata::set_committed_offset(serverContext, upload->offset());
+  return Status::OK;
+}
+
+std::optional<ChunkRecipe> Service::stored_recipe(const chord::uri& uri) {
+  if(!chunk_store || file::exists(context.data_directory / uri.path())) return {};
+  return chunk_store->recipe(uri);
+}
+
+std::set<Metadata> Service::local_metadata(const chord::uri& uri, const Replication& repl) {
+  if(const auto recipe = stored_recipe(uri)) {
+    return {Metadata{uri.path().filename(), "", "", perms::all, type::regular, recipe->file_size, recipe->file_hash, {}, repl}};
+  }
+  return MetadataBuilder::for_path(context, uri.path(), repl);
+}
+
+std::unique_ptr<std::istream> Service::open(const chord::uri& uri) {
+  if(const auto recipe = stored_recipe(uri)) {
+    auto stream = chunk_store->open(*recipe);
+    // missing or corrupt chunks
+    stream->exceptions(ifstream::badbit);
+    return stream;
   }
+  auto file = std::make_unique<ifstream>();
+  file->exceptions(ifstream::failbit | ifstream::badbit);
+  file->open(context.data_directory / uri.path(), fstream::binary);
+  return file;
+}
+
+void Service::remove_local(const chord::uri& uri) {
+  if(chunk_store) chunk_store->remove(uri);
+  fs::util::remove(uri, context, monitor);
+}
+
+Status Service::chunks(ServerContext *serverContext, const ChunksRequest *req, ChunksResponse *res) {
+  (void)serverContext;
+  return chunks(req, res);
+}
 
+Status Service::chunks(const ChunksRequest *req, ChunksResponse *res) {
+  try {
+    const auto uri = chord::uri::from(req->uri());
+    const auto manifest = stored_chunks(uri);
+    if(!manifest) {
+      return Status{StatusCode::NOT_FOUND, "no chunks of " + to_string(uri)};
+    }
+
+    const auto count = manifest->chunks.size();
+    res->set_file_hash_bin(manifest->file_hash.bytes());
+    res->set_chunk_size(manifest->chunk_size);
+    res->set_file_size(manifest->file_size);
+    res->set_count(count);
+
+    const auto first = std::min<std::size_t>(req->first(), count);
+    const auto last = std::min(count, first + chunks_per_response);
+    for(auto i = first; i < last; ++i) {
+      res->add_chunks(manifest->chunks[i].bytes());
+    }
+  } catch(const chord::exception& e) {
+    logger->warn("[chunks] failed to get chunks of {}: {}", req->uri(), e.what());
+    return Status{StatusCode::NOT_FOUND, e.what()};
+  }
+  return Status::OK;
+}
+
+path Service::data_path(const chord::uri& uri) {
   path data = context.data_directory;
   if (!file::is_directory(data)) {
     file::create_directories(data);
   }
 
-  auto options = ContextMetadata::from(serverContext);
+  // create parent path
+  data /= uri.path().parent_path();
+  if (!file::exists(data)) {
+    logger->trace("[put] creating directories for {}", data);
+    file::create_directories(data);
+  }
+  data /= uri.path().filename();
+  return data;
+}
+
+Status Service::put(ServerContext *serverContext, ServerReader<PutRequest> *reader, [[maybe_unused]] PutResponse *response) {
+
+  const auto options = ContextMetadata::from(serverContext);
+  const auto status = is_valid(options, RequestType::PUT);
+  if(!status.ok()) {
+    return status;
+  }
+
   const auto uri = ContextMetadata::uri_from(serverContext);
-  bool del_needed = options.rebalance && !options.replication.has_next();
+  {
+    const auto status = is_responsible(uri, options);
+    if(!status.ok()) return status;
+  }
 
   // open - if needed (file hashes do not equal)
   PutRequest req;
+  path data;
+  std::unique_ptr<Client::PutStream> downstream;
+  std::optional<ChunkManifest::Builder> chunks;
+  std::unique_ptr<PartialUpload> upload;
   try {
-    // create parent path
-    data /= uri.path().parent_path();
-    if (!file::exists(data)) {
-      logger->trace("[put] creating directories for {}", data);
-      file::create_directories(data);
-    }
-    data /= uri.path().filename();
+    data = data_path(uri);
 
     const auto lock = monitor::lock(monitor, {data, chord::fs::monitor::event::flag::CREATED});
 
+    const auto hashes_equal = file_hashes_equal(serverContext);
+    const auto base = delta_base(serverContext, uri, hashes_equal);
+    if(!hashes_equal && !base) {
+      const auto status = resumable_upload(serverContext, uri, upload);
+      if(!status.ok()) return status;
+    }
+    reader->SendInitialMetadata();
+
     // empty file was put
-    if(!file::exists(data)) {
+    if(!upload && !file::exists(data) && !stored_recipe(uri)) {
       chord::file::create_file(data);
     }
 
-    if (!file_hashes_equal(serverContext, reader)) {
-      logger->trace("[put] {}", data);
+    if (!hashes_equal) {
+      const auto resumed = upload && upload->offset() > 0;
+      logger->trace("[put] {}{}", data, base ? " (delta)" : resumed ? " (resumed)" : "");
 
-      crypto::sha256_hasher hasher;
+      // chain replication: the next replica receives every chunk as soon as this node does
+      std::optional<Client::Delta> delta;
+      if(base) delta = Client::Delta{base->file_hash, *ContextMetadata::file_size_from(serverContext)};
+      // the next replica lacks the chunks received before the put has been resumed
+      if(!resumed) downstream = forward_put(uri, options, ContextMetadata::file_hash_from(serverContext), delta);
+
+      if(base) {
+        chunks.emplace(*base);
+      } else if(!resumed) {
+        chunks.emplace();
+      }
 
-      ofstream file;
-      file.exceptions(ifstream::failbit | ifstream::badbit);
-      file.open(data, fstream::binary);
+      // a delta put overwrites the changed chunks only
+      fstream file;
+      if(!upload) {
+        file.exceptions(ifstream::failbit | ifstream::badbit);
+        file.open(data, base ? fstream::binary | fstream::in | fstream::out : fstream::binary | fstream::out | fstream::trunc);
+      }
 
       // write
+      // empty file was put - a delta put without changed chunks keeps the base
       if(!reader->Read(&req)) {
-        chord::file::resize_file(data);
+        if(!upload && !base) chord::file::resize_file(data);
       } else do {
         const auto data = req.data().data();
         const auto len = req.size();
-        // TODO use file.seekp(req.offset()) before writing
-        // however hasher will fail if not the whole file is written
-        hasher(data, len);
-        file.write(data, static_cast<std::streamsize>(len));
+        if(upload) {
+          upload->write(req.offset(), data, len);
+        } else {
+          file.seekp(static_cast<std::streamoff>(req.offset()));
+          file.write(data, static_cast<std::streamsize>(len));
+        }
+        if(chunks) chunks->write(req.offset(), data, len);
+        if(downstream) downstream->write(req);
       } while (reader->Read(&req));
 
+      // the part received of a cancelled put is not committed
+      if(serverContext->IsCancelled()) {
+        if(downstream) downstream->cancel();
+        return Status::CANCELLED;
+      }
+
+      if(upload) {
+        if(!upload->complete()) {
+          // kept to be resumed - the next replica must not commit the part received
+          if(downstream) downstream->cancel();
+          logger->info("[put] interrupted {} at {}", uri, upload->offset());
+          return {StatusCode::ABORTED, fmt::format("incomplete put, received {} bytes", upload->offset())};
+        }
+        upload->finish(data);
+      } else {
+        file.close();
+        if(delta) chord::file::resize_file(data, delta->file_size);
+      }
     }
 
   } catch (const ios_base::failure &error) {
     logger->error("[put] {}, reason: {}", data, error.what());
+    if(downstream) downstream->cancel();
     //TODO
     return Status::CANCELLED;
+  } catch (const chord::exception &error) {
+    logger->error("[put] {}, reason: {}", data, error.what());
+    if(downstream) downstream->cancel();
+    return {StatusCode::DATA_LOSS, error.what()};
+  }
+
+  // acknowledged once the whole chain stored the file
+  bool forwarded = false;
+  if(downstream) {
+    const auto status = downstream->finish();
+    forwarded = status.ok();
+    if(!forwarded) {
+      logger->warn("[put] failed to forward {}: {} - replicating after commit.", uri, status.error_message());
+    }
+  }
+
+  commit_put(uri, options, chunks ? &*chunks : nullptr);
+  replicate_put(uri, options, forwarded);
+  return Status::OK;
+}
+
+std::unique_ptr<Client::PutStream> Service::forward_put(const chord::uri& uri, client::options options, const std::optional<chord::uuid>& file_hash, const std::optional<Client::Delta>& delta) {
+  // files of the chunk store are replicated per chunk once committed
+  if(!context.pipelined_replication || chunk_store || !++options.replication) return nullptr;
+
+  try {
+    const auto successors = chord->successors();
+    const auto next = successors.empty() ? chord->successor() : successors.front();
+    return make_client()->put_stream(next, uri, file_hash, init_source(options), delta);
+  } catch(const chord::exception& error) {
+    logger->warn("[put] failed to forward {}: {}", uri, error.what());
+    return nullptr;
   }
+}
 
+void Service::commit_put(const chord::uri& uri, const client::options& options, ChunkManifest::Builder* chunks) {
   // add local metadata
-  auto meta = MetadataBuilder::for_path(context, uri.path(), options.replication);
+  auto meta = local_metadata(uri, options.replication);
   metadata_mgr->add(uri, meta);
 
+  if(chunk_store) {
+    add_to_chunk_store(uri);
+  } else if(chunks && fs::is_regular_file(meta) && meta.begin()->file_hash) {
+    // manifest of the received file - base of the next delta put
+    const auto& file = *meta.begin();
+    if(const auto manifest = chunks->finish(*file.file_hash, file.file_size)) {
+      metadata_mgr->chunks(uri, *manifest);
+    } else {
+      logger->warn("[put] incomplete chunks of {} - no manifest stored.", uri);
+    }
+  }
+
   // trigger recursive metadata replication for parent
   if(options.replication.index == 0) {
     const auto parent_uri = chord::uri{uri.scheme(), uri.path().parent_path()};
@@ -328,38 +579,144 @@ Status Service::put(ServerContext *serverContext, ServerReader<PutRequest> *read
     meta.insert(create_directory(meta, ".."));
     make_client()->meta(parent_uri, Client::Action::ADD, meta, options);
   }
+}
 
-  // handle (recursive) file-replication
-  if(++options.replication) {
+void Service::add_to_chunk_store(const chord::uri& uri) {
+  const auto data = context.data_directory / uri.path();
+  // unchanged file - kept in the chunk store already
+  if(!file::exists(data) || !file::is_regular_file(data)) return;
 
-    const auto next = chord->successor();
+  try {
+    ifstream file;
+    file.exceptions(ifstream::badbit);
+    file.open(data, fstream::binary);
+    chunk_store->add(uri, file);
+  } catch(const std::exception& error) {
+    logger->warn("[put] failed to add {} to the chunk store - keeping the local copy: {}", uri, error.what());
+    return;
+  }
+  // the chunks replace the local copy
+  fs::util::remove(uri, context, monitor);
+}
+
+Status Service::missing(ServerContext *serverContext, const MissingRequest *req, MissingResponse *res) {
+  (void)serverContext;
+  return missing(req, res);
+}
+
+Status Service::missing(const MissingRequest *req, MissingResponse *res) {
+  if(!chunk_store) return {StatusCode::UNIMPLEMENTED, "chunk store disabled."};
+
+  std::vector<chord::uuid> chunks;
+  chunks.reserve(static_cast<std::size_t>(req->chunks_size()));
+  for(const auto& chunk : req->chunks()) {
+    chunks.push_back(chord::uuid::from_bytes(chunk));
+  }
+  for(const auto index : chunk_store->missing(chunks)) {
+    res->add_index(static_cast<std::uint32_t>(index));
+  }
+  return Status::OK;
+}
+
+Status Service::assemble(ServerContext *serverContext, ServerReader<AssembleRequest> *reader, [[maybe_unused]] PutResponse *response) {
+  const auto options = ContextMetadata::from(serverContext);
+  {
+    const auto status = is_valid(options, RequestType::PUT);
+    if(!status.ok()) return status;
+  }
+  if(!chunk_store) return {StatusCode::UNIMPLEMENTED, "chunk store disabled."};
+
+  const auto uri = ContextMetadata::uri_from(serverContext);
+  {
+    const auto status = is_responsible(uri, options);
+    if(!status.ok()) return status;
+  }
+  ChunkRecipe recipe;
+  AssembleRequest req;
+  while(reader->Read(&req)) {
+    const auto status = assemble(req, recipe);
+    if(!status.ok()) return status;
+  }
+
+  const auto status = commit_assemble(uri, options, recipe);
+  if(status.ok()) replicate_put(uri, options);
+  return status;
+}
+
+Status Service::assemble(const AssembleRequest& req, ChunkRecipe& recipe) {
+  if(req.chunks_size() != req.sizes_size()) {
+    return {StatusCode::INVALID_ARGUMENT, "chunk hashes and sizes do not match."};
+  }
+  if(!req.file_hash_bin().empty()) {
+    recipe.file_hash = chord::uuid::from_bytes(req.file_hash_bin());
+    recipe.file_size = req.file_size();
+  }
+  for(int i = 0; i < req.chunks_size(); ++i) {
+    recipe.chunks.push_back({chord::uuid::from_bytes(req.chunks(i)), req.sizes(i)});
+  }
+
+  if(!req.data().empty()) {
+    try {
+      chunk_store->store(req.data().data(), req.data().size());
+    } catch(const std::exception& error) {
+      logger->error("[assemble] failed to store chunk, reason: {}", error.what());
+      return Status::CANCELLED;
+    }
+  }
+  return Status::OK;
+}
+
+Status Service::commit_assemble(const chord::uri& uri, const client::options& options, const ChunkRecipe& recipe) {
+  std::uint64_t file_size = 0;
+  for(const auto& chunk : recipe.chunks) file_size += chunk.size;
+  if(file_size != recipe.file_size) {
+    return {StatusCode::INVALID_ARGUMENT, "chunk sizes do not match the file size."};
+  }
+  if(!chunk_store->add(uri, recipe)) {
+    return {StatusCode::FAILED_PRECONDITION, "missing chunks of " + to_string(uri)};
+  }
+
+  // the local copy of a former version is replaced by the chunks
+  if(file::exists(context.data_directory / uri.path())) {
+    fs::util::remove(uri, context, monitor);
+  }
+  commit_put(uri, options);
+  return Status::OK;
+}
+
+void Service::replicate_put(const chord::uri& uri, client::options options, const bool forwarded) {
+  const bool del_needed = options.rebalance && !options.replication.has_next();
+
+  // handle (recursive) file-replication
+  if(++options.replication && !forwarded) {
 
     path data = context.data_directory;
     data /= uri.path().parent_path();
     data /= uri.path().filename();
 
-    std::ifstream file;
-    file.exceptions(ifstream::failbit | ifstream::badbit);
-    file.open(data, std::fstream::binary);
+    // files of the chunk store: only the chunks the successor lacks are sent
+    const auto recipe = stored_recipe(uri);
+
     //TODO rollback on status ABORTED?
-    make_client()->put(next, uri, file, init_source(options));
+    with_successors([&](const chord::node& next) {
+      if(recipe) return make_client()->assemble(next, uri, *chunk_store, *recipe, init_source(options));
+      return make_client()->put(next, uri, data, init_source(options));
+    });
   }
   if(del_needed) {
     const auto hash = chord::crypto::sha256(uri);
     const auto next = chord->successor();
-    if(next != chord->successor(hash)) {
+    if(next != chord->successor(hash, false)) {
       logger->trace("[put] deletion of file from successor needed.");
       make_client()->del(next, uri, false, init_source(options));
     }
   }
-  return Status::OK;
 }
 
-Status Service::handle_del_file(ServerContext *serverContext, const chord::fs::DelRequest *req) {
+Status Service::handle_del_file(const chord::fs::DelRequest *req, const client::options& options) {
   const auto uri = chord::uri::from(req->uri());
   auto data = context.data_directory / uri.path();
 
-  const auto options = ContextMetadata::from(serverContext);
   const bool initial_delete = !options.source;
 
   auto deleted_metadata = metadata_mgr->del(uri);
@@ -377,6 +734,7 @@ Status Service::handle_del_file(ServerContext *serverContext, const chord::fs::D
     fs::util::remove(uri, context, monitor);
     //file::remove(data);
   }
+  if(chunk_store) chunk_store->remove(uri);
 
   // beg: handle replica
   const auto max_repl = max_replication(deleted_metadata);
@@ -399,11 +757,10 @@ Status Service::handle_del_file(ServerContext *serverContext, const chord::fs::D
   return Status::OK;
 }
 
-Status Service::handle_del_recursive(ServerContext *serverContext, const chord::fs::DelRequest *req) {
+Status Service::handle_del_recursive(const chord::fs::DelRequest *req, const client::options& options) {
 
     const auto uri = chord::uri::from(req->uri());
     const auto metadata = metadata_mgr->get(uri);
-    const auto options = ContextMetadata::from(serverContext);
 
     // handle possibly remote metadata of sub-uris
     for(const auto& m:metadata) {
@@ -424,7 +781,7 @@ Status Service::handle_del_recursive(ServerContext *serverContext, const chord::
     return Status::OK;
 }
 
-Status Service::handle_del_dir(ServerContext *serverContext, const chord::fs::DelRequest *req) {
+Status Service::handle_del_dir(const chord::fs::DelRequest *req, const client::options& options) {
   const auto uri = chord::uri::from(req->uri());
   auto data = context.data_directory / uri.path();
 
@@ -437,12 +794,11 @@ Status Service::handle_del_dir(ServerContext *serverContext, const chord::fs::De
 
   // if already locally deleted or ...
   if(/*!exists || */(!is_empty && req->recursive())) {
-    /*return*/ handle_del_recursive(serverContext, req);
+    /*return*/ handle_del_recursive(req, options);
   } 
 
   // directory was recursively emptied and handle_del_dir was called remotely
   {
-    const auto options = ContextMetadata::from(serverContext);
     const bool initial_delete = !options.source;
 
     // beg: handle local
@@ -488,10 +844,16 @@ Status Service::handle_del_dir(ServerContext *serverContext, const chord::fs::De
   }
 }
 
-Status Service::del([[maybe_unused]] grpc::ServerContext *serverContext,
+Status Service::del(grpc::ServerContext *serverContext,
                     const chord::fs::DelRequest *req,
-                    [[maybe_unused]] chord::fs::DelResponse *res) {
-  const auto status = is_valid(serverContext, RequestType::DEL);
+                    chord::fs::DelResponse *res) {
+  return del(req, res, ContextMetadata::from(serverContext));
+}
+
+Status Service::del(const chord::fs::DelRequest *req,
+                    [[maybe_unused]] chord::fs::DelResponse *res,
+                    const client::options& options) {
+  const auto status = is_valid(options, RequestType::DEL);
   if(!status.ok()) {
     return status;
   }
@@ -518,9 +880,9 @@ Status Service::del([[maybe_unused]] grpc::ServerContext *serverContext,
   }
 
   if(element->file_type == type::directory) {
-    return handle_del_dir(serverContext, req);
+    return handle_del_dir(req, options);
   } else {
-    return handle_del_file(serverContext, req);
+    return handle_del_file(req, options);
   }
 
   return Status::OK;
@@ -567,8 +929,9 @@ Status Service::get_from_reference_or_replication(const chord::uri& uri) {
     // try to get replication
     if(m.replication) {
       try {
-        const auto successor = chord->successor();
-        status = make_client()->get(uri, successor, data);
+        status = with_successors([&](const chord::node& successor) {
+          return make_client()->get(uri, successor, data);
+        });
         if(!status.ok()) {
           logger->warn("[get] failed to get from referenced node - trying to get replication.");
         }
@@ -582,34 +945,60 @@ Status Service::get_from_reference_or_replication(const chord::uri& uri) {
   return Status::CANCELLED;
 }
 
-Status Service::get([[maybe_unused]] ServerContext *serverContext, const GetRequest *req, grpc::ServerWriter<GetResponse> *writer) {
-  ifstream file;
-  file.exceptions(ifstream::failbit | ifstream::badbit);
-
-  path data = context.data_directory;
+Status Service::restore(const chord::uri& uri, path& data) {
+  data = context.data_directory;
   if (!file::is_directory(data)) {
     logger->trace("[get] creating directories for {}", data);
     file::create_directories(data);
   }
-  const auto uri = chord::uri::from(req->uri());
 
   data /= uri.path();
   // try to get file
   if (!file::exists(data)) {
+    // read from the chunk store (see open)
+    if(stored_recipe(uri)) return Status::OK;
     logger->debug("[get] file does not exist, trying to restore from metadata...");
-    const auto status = get_from_reference_or_replication(uri);
-    if(!status.ok()) {
-      return status;
-    }
+    return get_from_reference_or_replication(uri);
   } else if (!file::is_regular_file(data)) {
     logger->error("[get] requested file is not a regular file - aborting.");
     return Status::CANCELLED;
   }
+  return Status::OK;
+}
+
+Status Service::seek(istream& file, const GetRequest& req, std::uint64_t& length) {
+  file.seekg(0, std::ios::end);
+  const auto end = file.tellg();
+  if(end < 0) return {StatusCode::INTERNAL, "failed to determine the file size."};
+
+  const auto size = static_cast<std::uint64_t>(end);
+  if(req.offset() > size) {
+    return {StatusCode::OUT_OF_RANGE, fmt::format("offset {} beyond the end of the file ({} bytes).", req.offset(), size)};
+  }
+  length = size - req.offset();
+  if(req.length() > 0) length = std::min(length, req.length());
+
+  file.seekg(static_cast<std::streamoff>(req.offset()));
+  return Status::OK;
+}
+
+Status Service::get([[maybe_unused]] ServerContext *serverContext, const GetRequest *req, grpc::ServerWriter<GetResponse> *writer) {
+  std::unique_ptr<istream> file;
+
+  const auto uri = chord::uri::from(req->uri());
+  path data;
+  const auto status = restore(uri, data);
+  if(!status.ok()) {
+    return status;
+  }
 
-  logger->trace("[get] trying to get {}", data);
+  logger->trace("[get] trying to get {} ({}+{})", data, req->offset(), req->length());
+  std::uint64_t remaining = 0;
   try {
-    file.open(data, fstream::binary);
-  } catch (const ios_base::failure &error) {
+    file = open(uri);
+    const auto seeked = seek(*file, *req, remaining);
+    if(!seeked.ok()) return seeked;
+  } catch (const std::exception &error) {
     logger->error("[get] failed to open file {}, reason: {}", data, error.what());
     return Status::CANCELLED;
   }
@@ -618,21 +1007,27 @@ Status Service::get([[maybe_unused]] ServerContext *serverContext, const GetRequ
   constexpr size_t len = static_cast<long>(512)*1024; // 512k
   std::array<char, len> buffer;
   //char buffer[len];
-  size_t offset = 0,
+  size_t offset = req->offset(),
          read = 0;
   do {
-    read = static_cast<size_t>(file.readsome(buffer.data(), len));
+    try {
+      read = static_cast<size_t>(file->readsome(buffer.data(), static_cast<std::streamsize>(std::min<std::uint64_t>(len, remaining))));
+    } catch (const std::exception &error) {
+      logger->error("[get] failed to read {}, reason: {}", data, error.what());
+      return Status::CANCELLED;
+    }
     if (read == 0) break;
 
     GetResponse res;
     //TODO validate hashes
-    res.set_id(req->id());
+    chord::common::set_id(res, chord::common::id_of(*req), context.legacy_uuids);
     res.set_data(buffer.data(), read);
     res.set_offset(offset);
     res.set_size(read);
     //TODO write implicit string conversion
     //res.set_uri(uri);
     offset += read;
+    remaining -= read;
 
     if (!writer->Write(res)) {
       throw__exception("[get] broken stream.");
@@ -1,9 +1,45 @@
 #include "chord.fs.util.h"
 
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "chord.crypto.h"
+#include "chord.exception.h"
+
 namespace chord {
 namespace fs {
 namespace util {
 
+namespace {
+constexpr auto file_hash_attr = "user.chord.sha256";
+// files modified more recently might be modified again within the
+// resolution of the modification time - their hash is not cached
+constexpr auto file_hash_min_age = std::chrono::seconds(1);
+
+std::filesystem::file_time_type last_write_time(const path& path) {
+  return std::filesystem::last_write_time(std::filesystem::path{path.string()});
+}
+
+std::string file_hash_key(const path& path, const std::filesystem::file_time_type mtime) {
+  return std::to_string(file::file_size(path)) + ":" + std::to_string(mtime.time_since_epoch().count());
+}
+
+std::optional<chord::uuid> cached_file_hash(const path& path, const std::string& key) {
+  try {
+    const auto cached = file::attr(path, file_hash_attr);
+    if(!cached) return {};
+    const auto separator = cached->rfind(':');
+    if(separator == std::string::npos || cached->substr(0, separator) != key) return {};
+    return chord::uuid{cached->substr(separator + 1)};
+  } catch(const std::exception&) {
+    // extended attributes not supported or corrupt
+    return {};
+  }
+}
+} // namespace
+
 bool remove(const chord::path& path, chord::fs::monitor* monitor) {
   //if(!chord::file::exists(path)) return false;
 
@@ -41,6 +77,24 @@ path as_journal_path(const Context& context, const uri& uri) {
   return as_journal_path(context, uri.path());
 }
 
+chord::uuid file_hash(const path& path) {
+  const auto mtime = last_write_time(path);
+  const auto key = file_hash_key(path, mtime);
+  if(const auto cached = cached_file_hash(path, key)) return *cached;
+
+  const auto hash = crypto::sha256(path);
+  const bool stable = last_write_time(path) == mtime
+                      && std::filesystem::file_time_type::clock::now() - mtime > file_hash_min_age;
+  if(stable) {
+    try {
+      file::attr(path, file_hash_attr, key + ":" + hash.string());
+    } catch(const chord::exception&) {
+      // extended attributes not supported - hash again next time
+    }
+  }
+  return hash;
+}
+
 } // namespace util
 } // namespace fs
 } // namespace chord
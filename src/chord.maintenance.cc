@@ -0,0 +1,66 @@
+#include "chord.maintenance.h"
+
+#include <vector>
+
+#include "chord.common.h"
+#include "chord.context.h"
+#include "chord.failure.detector.h"
+#include "chord.log.h"
+#include "chord.router.h"
+#include "chord.uuid.h"
+
+using grpc::Status;
+using grpc::StatusCode;
+
+using chord::common::make_node;
+
+namespace chord {
+namespace maintenance {
+
+void record(const Context& context, Router& router, const node& node, const Status& status) {
+  if(node == context.node()) return;
+
+  auto& detector = router.failure_detector();
+  // any response proves the node alive
+  if(status.error_code() == StatusCode::UNAVAILABLE || status.error_code() == StatusCode::DEADLINE_EXCEEDED) {
+    detector.failure(node);
+  } else {
+    detector.heartbeat(node);
+  }
+}
+
+bool stabilized(const Context& context, Router& router, spdlog::logger& logger, const node& successor, const Status& status, const StabilizeResponse& res) {
+  if(!status.ok()) {
+    logger.warn("[stabilize] failed on {} (phi {:.2f})", successor.endpoint, router.failure_detector().phi(successor));
+    return false;
+  }
+
+  if(res.has_predecessor()) {
+    const auto pred = make_node(res.predecessor());
+    logger.trace("received stabilize response with predecessor {}", pred);
+    if(uuid::between(context.uuid(), pred.uuid, successor.uuid)) {
+      router.update(pred);
+    }
+  } else {
+    logger.trace("received empty routing entry");
+  }
+
+  std::vector<node> successors;
+  successors.reserve(static_cast<size_t>(res.successors_size()));
+  for(const auto& entry : res.successors()) {
+    successors.push_back(make_node(entry));
+  }
+  router.update_successors(successor, successors);
+  return true;
+}
+
+void checked(Router& router, spdlog::logger& logger, const node& predecessor, const Status& status, const PingResponse& res) {
+  if(!status.ok()) {
+    logger.warn("[check] predecessor failed (phi {:.2f}).", router.failure_detector().phi(predecessor));
+  } else if(!res.has_header()) {
+    logger.error("[check] returned without header, should remove endpoint {}?", predecessor);
+  }
+}
+
+}  // namespace maintenance
+}  // namespace chord
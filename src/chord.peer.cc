@@ -26,6 +26,7 @@ void Peer::start_server() {
 
   ServerBuilder builder;
   builder.AddListeningPort(bind_addr, grpc::InsecureServerCredentials());
+  ChannelPool::configure(builder, context.channel_keepalive_ms);
   builder.RegisterService(chord->grpc_service());
   // controller service
   builder.RegisterService(controller.get());
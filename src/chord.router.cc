@@ -19,7 +19,9 @@
 namespace chord {
 
 Router::Router(chord::Context &context) noexcept
-  : context{context}, logger{context.logging.factory().get_or_create(logger_name)} {
+  : context{context},
+    logger{context.logging.factory().get_or_create(logger_name)},
+    detector{context.failure_phi_threshold, context.failure_max_count, std::chrono::milliseconds(context.check_period_ms)} {
     init();
     context.set_router(this);
 }
@@ -31,14 +33,31 @@ Router::~Router() noexcept {
 void Router::init() {
   std::scoped_lock<mutex_t> lock(mtx);
   for(size_t idx=0; idx < BITS; ++idx) {
-    const auto finger = calc_successor_uuid_for_index(idx);
-    successors[idx] = {finger, {}};
+    distances[idx] = distance_of(calc_successor_uuid_for_index(idx));
   }
+  fingers.clear();
+}
+
+uuid Router::distance_of(const uuid& id) const {
+  // unsigned arithmetic wraps around the ring
+  return id - context.uuid();
+}
+
+size_t Router::index_of(const uuid& distance) const {
+  // number of finger starts in front of the distance
+  return static_cast<size_t>(std::distance(distances.begin(), std::lower_bound(distances.begin(), distances.end(), distance)));
+}
+
+Router::finger_map_t::iterator Router::find(const uuid& distance) {
+  return std::lower_bound(fingers.begin(), fingers.end(), distance, [](const Finger& finger, const uuid& d) {
+      return finger.distance < d;
+  });
 }
 
 void Router::cleanup() {
   std::scoped_lock<mutex_t> lock(mtx);
   _predecessor.reset();
+  _successors.clear();
   init();
 }
 
@@ -48,7 +67,7 @@ void Router::reset() {
 
 bool Router::has_successor() const {
   std::scoped_lock<mutex_t> lock(mtx);
-  return successors.front().valid();
+  return !fingers.empty();
 }
 
 bool Router::has_predecessor() const {
@@ -57,10 +76,9 @@ bool Router::has_predecessor() const {
 }
 
 uuid Router::calc_successor_uuid_for_index(const uuid& self, const size_t i) {
-  namespace mp = boost::multiprecision;
-  const auto _pow = mp::pow(chord::uuid::value_t{2}, static_cast<unsigned int>(i));
-  const auto _mod = std::numeric_limits<chord::uuid::value_t>::max();
-  return (self + _pow) % _mod;
+  // (self + 2^i) % (2^256 - 1)
+  const auto finger = self + uuid::pow2(i);
+  return finger == uuid::max() ? uuid{0} : finger;
 }
 
 uuid Router::calc_successor_uuid_for_index(const size_t i) const {
@@ -73,39 +91,81 @@ node Router::successor_or_self() const {
 
 std::optional<node> Router::successor() const {
   std::scoped_lock<mutex_t> lock(mtx);
-  auto succ = successors.front();
-  if(succ.valid()) return succ.node();
+  if(!fingers.empty()) return fingers.front().node;
   return {};
   //return context.node();
 }
 
+std::vector<node> Router::successors() const {
+  std::scoped_lock<mutex_t> lock(mtx);
+  const auto size = context.successor_list_size;
+
+  std::vector<node> ret;
+  ret.reserve(std::min(size, fingers.size()) + _successors.size());
+  for(auto it = fingers.begin(); it != fingers.end() && ret.size() < size; ++it) {
+    ret.push_back(it->node);
+  }
+  ret.insert(ret.end(), _successors.begin(), _successors.end());
+
+  std::sort(ret.begin(), ret.end(), [this](const node& lhs, const node& rhs) {
+      return distance_of(lhs.uuid) < distance_of(rhs.uuid);
+  });
+  ret.erase(std::unique(ret.begin(), ret.end(), [](const node& lhs, const node& rhs) {
+      return lhs.uuid == rhs.uuid;
+  }), ret.end());
+  if(ret.size() > size) ret.resize(size);
+  return ret;
+}
+
+void Router::update_successors(const node& successor, const std::vector<node>& list) {
+  std::scoped_lock<mutex_t> lock(mtx);
+  _successors.clear();
+  _successors.push_back(successor);
+  for(const auto& n : list) {
+    if(_successors.size() >= context.successor_list_size) break;
+    // the list wraps around the ring in small rings
+    if(n.uuid == context.uuid()) break;
+    if(detector.suspects(n)) continue;
+    _successors.push_back(n);
+  }
+}
+
 void Router::update(const std::set<chord::node>& nodes) {
   std::scoped_lock<mutex_t> lock(mtx);
   std::for_each(nodes.begin(), nodes.end(), [this](const chord::node& n){this->update(n);});
 }
 
 bool Router::update(const chord::node& insert) {
-  //std::scoped_lock<mutex_t> lock(mtx);
-  bool changed = false;
-
   if(insert == context.node()) return false;
 
+  bool changed = false;
   std::optional<node> old_successor;
   std::optional<node> old_predecessor;
-
-  for(auto it=successors.begin(); it != successors.end(); ++it) {
-    if(uuid::between(it->uuid, insert.uuid, (it->valid() ? it->node().uuid : context.uuid()))) {
-      if(successors.begin()->valid() && it == successors.begin()) {
-        old_successor = it->node();
+  {
+    std::scoped_lock<mutex_t> lock(mtx);
+    const auto distance = distance_of(insert.uuid);
+    const auto end = index_of(distance);
+    auto it = find(distance);
+    const auto begin = it == fingers.begin() ? 0 : std::prev(it)->end;
+
+    // only nodes that are the closest successor of at least one finger are kept
+    if(begin < end && (it == fingers.end() || it->distance != distance)) {
+      if(begin == 0 && !fingers.empty()) {
+        old_successor = fingers.front().node;
+      }
+      it = fingers.insert(it, {distance, end, insert});
+      // the next node lost all entries in front of the inserted node
+      if(const auto next = std::next(it); next != fingers.end() && next->end == end) {
+        fingers.erase(next);
       }
-      it->_node = insert;
-      changed |= true;
+      changed = true;
+    }
+
+    if(!_predecessor
+        || (insert != *_predecessor && uuid::between(_predecessor->uuid, insert.uuid, context.uuid()))) {
+      old_predecessor = _predecessor.value_or(context.node());
+      _predecessor = insert;
     }
-  }
-  if(!_predecessor 
-      || (insert != *_predecessor && uuid::between(_predecessor->uuid, insert.uuid, context.uuid()))) {
-    old_predecessor = _predecessor.value_or(context.node());
-    _predecessor = insert;
   }
 
   if(old_successor) event_successor_update(*old_successor, insert);
@@ -114,47 +174,36 @@ bool Router::update(const chord::node& insert) {
 }
 
 bool Router::remove(const chord::uuid& uuid, const bool signal) {
-  std::scoped_lock<mutex_t> lock(mtx);
   bool changed = false;
-  auto replacement = successors.rbegin();
-
-  if(!replacement->valid() || (replacement->node().uuid == uuid && replacement->node().uuid != context.uuid()))
-    //replacement->_node.reset();
-    replacement = successors.rend();
-
-
   std::optional<node> successor_failed;
   std::optional<node> predecessor_failed;
   {
-    auto successor = successors.begin();
-    if(successor->valid() && successor->node().uuid == uuid) {
-      successor_failed = successor->node();
+    std::scoped_lock<mutex_t> lock(mtx);
+    // entries of the removed node implicitly fall back to the next node
+    if(const auto it = find(distance_of(uuid)); it != fingers.end() && it->node.uuid == uuid) {
+      if(it == fingers.begin()) {
+        successor_failed = it->node;
+      }
+      fingers.erase(it);
+      changed = true;
     }
+    std::erase_if(_successors, [&](const node& n) { return n.uuid == uuid; });
+
     if(_predecessor && _predecessor->uuid == uuid) {
       predecessor_failed = _predecessor;
-    }
-  }
-
-  for(auto it=successors.rbegin(); it != successors.rend(); ++it) {
-    if(!it->valid()) continue;
-
-    if(_predecessor && uuid == _predecessor->uuid && it->node().uuid != uuid) {
-      _predecessor = it->node();
-    }
-
-    if(it->node().uuid == uuid) {
-      if(replacement != successors.rend() && replacement->valid()) {
-        it->_node = replacement->node();
+      // replace by the furthest remaining node - if any
+      if(fingers.empty()) {
+        _predecessor.reset();
       } else {
-        it->_node.reset();
+        _predecessor = fingers.back().node;
       }
-    } else if(it->node().uuid != uuid && it->node().uuid != context.uuid())
-      replacement = it;
+    }
   }
 
-  // not found any replacement - reset
-  if(_predecessor && _predecessor->uuid == uuid) {
-    _predecessor.reset();
+  // fail over to the next node of the successor list - it might be
+  // closer than the next node of the finger table
+  if(successor_failed) {
+    if(const auto list = successors(); !list.empty()) update(list.front());
   }
 
   // emit events after fixing / replacing failed node
@@ -179,14 +228,14 @@ std::vector<node> Router::closest_preceding_nodes(const uuid& uuid) {
   std::scoped_lock<mutex_t> lock(mtx);
   std::vector<node> ret;
 
-  for(auto it=std::crbegin(successors); it != crend(successors); ++it) {
-    if(it->valid() && uuid::between(context.uuid(), it->node().uuid, uuid)) {
-      const auto node = it->node();
-      if(ret.empty() || ret.back() != node) ret.push_back(node);
-    }
+  // all nodes between this node and the uuid - the full ring if the uuid is our own
+  const auto distance = distance_of(uuid);
+  auto it = distance == 0 ? fingers.end() : find(distance);
+  ret.reserve(static_cast<size_t>(std::distance(fingers.begin(), it)) + 1);
+  while(it != fingers.begin()) {
+    ret.push_back((--it)->node);
   }
-
-  if(ret.empty() || ret.front() != context.node()) ret.push_back(context.node());
+  ret.push_back(context.node());
 
   return ret;
 }
@@ -197,21 +246,43 @@ std::optional<node> Router::closest_preceding_node(const uuid_t &uuid) {
 
 uuid Router::get(const size_t index) const {
   std::scoped_lock<mutex_t> lock(mtx);
-  auto it = successors.begin();
-  std::advance(it, index);
-  return it->uuid;
+  return context.uuid() + distances.at(index);
 }
 
 std::set<node> Router::get() const {
   std::scoped_lock<mutex_t> lock(mtx);
   std::set<node> ret;
-  for(const auto& entry:successors) {
-    if(entry.valid()) ret.insert(entry.node());
+  for(const auto& finger:fingers) {
+    ret.insert(finger.node);
   }
 
   return ret;
 }
 
+std::vector<size_t> Router::intervals() const {
+  std::scoped_lock<mutex_t> lock(mtx);
+  std::vector<size_t> ret;
+  ret.reserve(fingers.size() + 1);
+  size_t beg = 0;
+  for(const auto& finger:fingers) {
+    ret.push_back(beg);
+    beg = finger.end;
+  }
+  if(beg < BITS) {
+    ret.push_back(beg);
+  }
+  return ret;
+}
+
+Router::RouterEntry Router::entry(const size_t index) const {
+  std::scoped_lock<mutex_t> lock(mtx);
+  const auto it = std::upper_bound(fingers.begin(), fingers.end(), index, [](const size_t idx, const Finger& finger) {
+      return idx < finger.end;
+  });
+  if(it == fingers.end()) return {get(index), {}};
+  return {get(index), it->node};
+}
+
 std::string Router::print() const {
   std::stringstream ss;
   print(ss);
@@ -219,17 +290,15 @@ std::string Router::print() const {
 }
 
 std::ostream& Router::print(std::ostream& os) const {
-  size_t beg = 0, end = 0;
-  auto curr = successors.front();
-  for(const auto& successor:successors) {
-    if(curr.valid() ^ successor.valid() || (curr.valid() && successor.valid() && curr.node() != successor.node())) {
-      os << "\nrouter[" << beg << ".." << end-1 << "]: "; curr.print(os);
-      curr = successor;
-      beg = end;
-    }
-    ++end;
+  std::scoped_lock<mutex_t> lock(mtx);
+  size_t beg = 0;
+  for(const auto& finger:fingers) {
+    os << "\nrouter[" << beg << ".." << finger.end-1 << "]: " << finger.node.string();
+    beg = finger.end;
+  }
+  if(beg < BITS) {
+    os << "\nrouter[" << beg << ".." << BITS-1 << "]: "; RouterEntry{}.print(os);
   }
-  os << "\nrouter[" << beg << ".." << end  << "]: "; curr.print(os);
   return os;
 }
 
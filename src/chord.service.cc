@@ -2,6 +2,7 @@
 
 #include <grpcpp/impl/codegen/server_context.h>
 #include <grpcpp/impl/codegen/status_code_enum.h>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -75,7 +76,7 @@ Status Service::join([[maybe_unused]] ServerContext *serverContext, const JoinRe
    */
   else if(pred && !uuid::between(context.uuid(), src, succ.uuid) 
       && !uuid::between(pred->uuid, src, context.uuid())) {
-    return client->join(req, res);
+    return client->join(serverContext, req, res);
   }
 
   auto* res_succ = res->mutable_successor();
@@ -85,20 +86,20 @@ Status Service::join([[maybe_unused]] ServerContext *serverContext, const JoinRe
     //const auto succ_or_self = succ.value_or(context.node());
     //res_succ->set_uuid(succ_or_self.uuid);
     //res_succ->set_endpoint(succ_or_self.endpoint);
-    res_succ->set_uuid(succ.uuid);
+    set_uuid(*res_succ, succ.uuid, context.legacy_uuids);
     res_succ->set_endpoint(succ.endpoint);
     // predecessor
     const auto self = context.node();
-    res_pred->set_uuid(self.uuid);
+    set_uuid(*res_pred, self.uuid, context.legacy_uuids);
     res_pred->set_endpoint(self.endpoint);
   } else if(uuid::between(pred->uuid, src, context.uuid())) {
     // successor
     const auto successor = context.node();
-    res_succ->set_uuid(successor.uuid);
+    set_uuid(*res_succ, successor.uuid, context.legacy_uuids);
     res_succ->set_endpoint(successor.endpoint);
     // predecessor
     const auto pred_or_self = pred.value_or(context.node());
-    res_pred->set_uuid(pred_or_self.uuid);
+    set_uuid(*res_pred, pred_or_self.uuid, context.legacy_uuids);
     res_pred->set_endpoint(pred_or_self.endpoint);
   }
 
@@ -108,50 +109,61 @@ Status Service::join([[maybe_unused]] ServerContext *serverContext, const JoinRe
 }
 
 RouterEntry Service::successor(const uuid_t &uuid) {
+  std::uint32_t hops;
+  return successor(uuid, hops);
+}
+
+RouterEntry Service::successor(const uuid_t &uuid, std::uint32_t &hops) {
   ServerContext serverContext;
   auto req = make_request<SuccessorRequest>(context);
   SuccessorResponse res;
 
-  req.set_id(uuid);
+  set_id(req, uuid, context.legacy_uuids);
 
   const auto status = successor(&serverContext, &req, &res);
 
   if (!status.ok()) throw__grpc_exception(status);
 
+  hops = res.hops();
   return res.successor();
 }
 
-Status Service::successor([[maybe_unused]] ServerContext *serverContext, const SuccessorRequest *req, SuccessorResponse *res) {
+Status Service::successor(ServerContext *serverContext, const SuccessorRequest *req, SuccessorResponse *res) {
 
   if(!has_valid_header(req)) return Status::CANCELLED;
 
   const auto source = source_of(req);
   router->update(source);
-  logger->trace("[successor] from {} successor of? {}", source, req->id());
-
   //--- destination of the request
-  uuid_t id{req->id()};
-  uuid_t self{context.uuid()};
+  const auto id = id_of(*req);
+  logger->trace("[successor] from {} successor of? {}", source, id);
 
-  auto successor = router->successor_or_self();
+  uuid_t self{context.uuid()};
 
-  while(!client->ping(successor).ok()) {
-    router->remove(successor);
-    successor = router->successor_or_self();
-  }
+  // skip suspected nodes - evicted asynchronously (see ChordFacade::evict_failed_nodes)
+  const auto successors = router->successors();
+  const auto& detector = router->failure_detector();
+  const auto alive = std::find_if(successors.begin(), successors.end(), [&](const node& n) {
+      return !detector.suspects(n);
+  });
+  const auto successor = alive != successors.end() ? *alive : context.node();
 
   if(id == self || uuid::between(self, id, successor.uuid)) {
     logger->trace("[successor] the requested id {} lies between self {} and my successor {}, returning successor", id.string(), self.string(), successor.uuid);
 
     //--- router entry
-    RouterEntry entry = make_entry(successor);
+    RouterEntry entry = make_entry(successor, context.legacy_uuids);
 
     res->mutable_successor()->CopyFrom(entry);
     
     return Status::OK;
   } 
 
-  return client->successor(req, res);
+  const auto status = client->successor(serverContext, req, res);
+  if(status.ok()) {
+    res->set_hops(res->hops() + 1);
+  }
+  return status;
 }
 
 Status Service::stabilize([[maybe_unused]] ServerContext *serverContext, const StabilizeRequest *req, StabilizeResponse *res) {
@@ -169,11 +181,18 @@ Status Service::stabilize([[maybe_unused]] ServerContext *serverContext, const S
     logger->debug("returning predecessor {}", predecessor);
 
     RouterEntry entry;
-    entry.set_uuid(predecessor->uuid);
+    set_uuid(entry, predecessor->uuid, context.legacy_uuids);
     entry.set_endpoint(predecessor->endpoint);
 
     res->mutable_predecessor()->CopyFrom(entry);
   }
+
+  // piggyback the successor list
+  for(const auto& successor : router->successors()) {
+    auto* entry = res->add_successors();
+    set_uuid(*entry, successor.uuid, context.legacy_uuids);
+    entry->set_endpoint(successor.endpoint);
+  }
   set_source(res, context);
 
   return Status::OK;
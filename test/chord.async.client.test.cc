@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/codegen/status.h>
+
+#include "chord.async.client.h"
+#include "chord.context.h"
+#include "chord.node.h"
+#include "chord.pb.h"
+#include "chord.router.h"
+#include "chord.stub.mock.h"
+#include "chord.uuid.h"
+#include "util/chord.test.helper.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::test;
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using callback_t = std::function<void(grpc::Status)>;
+
+/**
+ * stubs of all peers share the async interface, the contacted peers are recorded
+ */
+struct AsyncClientTest : public ::testing::Test {
+  Context context = make_context(5);
+  Router router{context};
+  NiceMock<MockAsyncStub> async;
+  std::vector<node> contacted;
+
+  std::unique_ptr<AsyncClient> make_client() {
+    return std::make_unique<AsyncClient>(context, &router, [this](const node& peer) {
+      contacted.push_back(peer);
+      auto stub = std::make_unique<NiceMock<MockStub>>();
+      ON_CALL(*stub, async()).WillByDefault(Return(&async));
+      return stub;
+    });
+  }
+};
+
+TEST_F(AsyncClientTest, stabilize_applies_response_and_notifies) {
+  const node successor{10, "10"};
+  const node predecessor_of_successor{7, "7"};
+  router.update(successor);
+  auto client = make_client();
+
+  EXPECT_CALL(async, stabilize(_, _, _, _))
+    .WillOnce(Invoke([&](grpc::ClientContext*, const StabilizeRequest*, StabilizeResponse* res, callback_t done) {
+      res->mutable_predecessor()->CopyFrom(make_entry(predecessor_of_successor));
+      res->add_successors()->CopyFrom(make_entry({20, "20"}));
+      done(grpc::Status::OK);
+    }));
+  EXPECT_CALL(async, notify(_, _, _, _))
+    .WillOnce(Invoke([](grpc::ClientContext*, const NotifyRequest*, NotifyResponse*, callback_t done) {
+      done(grpc::Status::OK);
+    }));
+
+  client->stabilize();
+  client->wait();
+
+  ASSERT_EQ(router.successor(), predecessor_of_successor);
+  ASSERT_EQ(contacted, (std::vector<node>{successor, predecessor_of_successor}));
+}
+
+TEST_F(AsyncClientTest, pending_probe_is_not_repeated) {
+  const node successor{10, "10"};
+  router.update(successor);
+  auto client = make_client();
+
+  callback_t pending;
+  EXPECT_CALL(async, stabilize(_, _, _, _))
+    .WillOnce(Invoke([&](grpc::ClientContext* client_context, const StabilizeRequest*, StabilizeResponse*, callback_t done) {
+      // bounded by the stabilize period
+      ASSERT_LT(client_context->deadline(), std::chrono::system_clock::time_point::max());
+      pending = std::move(done);
+    }));
+
+  // the scheduler is not blocked by the slow peer
+  client->stabilize();
+  client->stabilize();
+
+  pending(grpc::Status{grpc::StatusCode::DEADLINE_EXCEEDED, "timeout"});
+  client->wait();
+  ASSERT_GT(router.failure_detector().phi(successor), 0.0);
+}
+
+TEST_F(AsyncClientTest, check_feeds_failure_detector) {
+  const node predecessor{1, "1"};
+  router.update({10, "10"});
+  router.update(predecessor);
+  auto client = make_client();
+
+  EXPECT_CALL(async, ping(_, _, _, _))
+    .Times(3)
+    .WillRepeatedly(Invoke([](grpc::ClientContext*, const PingRequest*, PingResponse*, callback_t done) {
+      done(grpc::Status{grpc::StatusCode::UNAVAILABLE, "down"});
+    }));
+
+  for(int i = 0; i < 3; ++i) client->check();
+  client->wait();
+
+  ASSERT_TRUE(router.failure_detector().suspects(predecessor));
+}
+
+TEST_F(AsyncClientTest, fix_fingers_round) {
+  const node successor{10, "10"};
+  router.update(successor);
+  auto client = make_client();
+
+  // index 0 is resolved locally, index 200 by the successor
+  const auto id = Router::calc_successor_uuid_for_index(context.uuid(), 200);
+  const node finger{id, "finger"};
+  EXPECT_CALL(async, successor(_, _, _, _))
+    .WillOnce(Invoke([&](grpc::ClientContext*, const SuccessorRequest*, SuccessorResponse* res, callback_t done) {
+      res->mutable_successor()->CopyFrom(make_entry(finger));
+      done(grpc::Status::OK);
+    }));
+
+  size_t rounds = 0;
+  client->fix_fingers({0, 200}, [&] { ++rounds; });
+  client->wait();
+
+  ASSERT_EQ(rounds, 1);
+  ASSERT_EQ(contacted, std::vector<node>{successor});
+  ASSERT_TRUE(router.get().contains(finger));
+}
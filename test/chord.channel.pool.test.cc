@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "chord.channel.pool.h"
+#include "chord.context.h"
+#include "chord.node.h"
+#include "util/chord.test.helper.h"
+
+using namespace chord;
+using namespace chord::test;
+
+TEST(ChannelPoolTest, channels_are_pooled_per_lane) {
+  Context context = make_context(0);
+  ChannelPool pool(context);
+  const node peer{1, "127.0.0.1:50999"};
+
+  const auto control = pool.get(peer);
+  ASSERT_EQ(control, pool.get(peer, ChannelPool::lane::CONTROL));
+
+  // bulk transfers use a separate channel
+  const auto bulk = pool.get(peer, ChannelPool::lane::BULK);
+  ASSERT_NE(control, bulk);
+  ASSERT_EQ(bulk, pool.get(peer, ChannelPool::lane::BULK));
+
+  ASSERT_NE(control, pool.get({2, "127.0.0.1:50998"}));
+}
+
+TEST(ChannelPoolTest, put_channel_is_used_on_both_lanes) {
+  Context context = make_context(0);
+  ChannelPool pool(context);
+  const node peer{1, "127.0.0.1:50999"};
+
+  const auto channel = ChannelPool::create_channel(peer.endpoint);
+  pool.put(peer, channel);
+
+  ASSERT_EQ(channel, pool.get(peer, ChannelPool::lane::CONTROL));
+  ASSERT_EQ(channel, pool.get(peer, ChannelPool::lane::BULK));
+}
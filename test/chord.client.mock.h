@@ -11,7 +11,7 @@ class MockClient : public IClient {
   MOCK_METHOD1(join, grpc::Status(const endpoint&));
 
   MOCK_METHOD2(join, grpc::Status(const JoinRequest *req, JoinResponse *res));
-  MOCK_METHOD3(join, grpc::Status(grpc::ClientContext *clientContext, const JoinRequest *req, JoinResponse *res));
+  MOCK_METHOD3(join, grpc::Status(const grpc::ServerContext *parent, const JoinRequest *req, JoinResponse *res));
 
   MOCK_METHOD1(ping, grpc::Status(const node&));
 
@@ -24,7 +24,7 @@ class MockClient : public IClient {
 
   MOCK_METHOD1(successor, chord::common::RouterEntry(const uuid_t &id));
 
-  MOCK_METHOD3(successor, grpc::Status(grpc::ClientContext *context, const chord::SuccessorRequest *req, chord::SuccessorResponse *res));
+  MOCK_METHOD3(successor, grpc::Status(const grpc::ServerContext *parent, const chord::SuccessorRequest *req, chord::SuccessorResponse *res));
 
   MOCK_METHOD2(successor, grpc::Status(const chord::SuccessorRequest *req, chord::SuccessorResponse *res));
   
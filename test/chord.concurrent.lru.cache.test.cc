@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "chord.concurrent.lru.cache.h"
+
+using namespace std;
+using namespace chord;
+
+TEST(chord_concurrent_lru_cache, constructor) {
+  ConcurrentLRUCache<int, string> cache(5);
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.capacity(), 5);
+}
+
+TEST(chord_concurrent_lru_cache, put) {
+  ConcurrentLRUCache<int, string> cache(5, 1);
+  for(int i=0; i < 5; ++i) {
+    ASSERT_FALSE(cache.exists(i));
+    cache.put(i, std::to_string(i));
+    ASSERT_TRUE(cache.exists(i));
+  }
+  ASSERT_FALSE(cache.empty());
+  ASSERT_EQ(cache.size(), 5);
+
+  cache.put(10, "latest");
+  ASSERT_TRUE(cache.exists(10));
+  ASSERT_FALSE(cache.exists(0));
+  ASSERT_EQ(cache.size(), 5);
+  for(int i=1; i < 5; ++i)
+    ASSERT_TRUE(cache.exists(i));
+
+  // replace value
+  cache.put(10, "replaced");
+  ASSERT_EQ(cache.get(10), "replaced");
+  ASSERT_EQ(cache.size(), 5);
+}
+
+TEST(chord_concurrent_lru_cache, erase) {
+  ConcurrentLRUCache<int, string> cache(5);
+  for(int i=0; i < 5; ++i) {
+    cache.put(i, std::to_string(i));
+    ASSERT_TRUE(cache.erase(i));
+    ASSERT_FALSE(cache.erase(i));
+  }
+  ASSERT_TRUE(cache.empty());
+}
+
+TEST(chord_concurrent_lru_cache, get_touch) {
+  ConcurrentLRUCache<int, string> cache(5, 1);
+  for(int i=0; i < 5; ++i) {
+    cache.put(i, std::to_string(i));
+    ASSERT_EQ(cache.get(i), std::to_string(i));
+  }
+
+  //refresh 0
+  cache.get(0);
+  cache.touch(1);
+  ASSERT_EQ(cache.find(3), "3");
+  //replace 2
+  cache.put(1337, "replace 2");
+  ASSERT_FALSE(cache.exists(2));
+  ASSERT_TRUE(cache.exists(0));
+  //replace 4
+  cache.put(1338, "replace 4");
+  ASSERT_FALSE(cache.exists(4));
+
+  ASSERT_FALSE(cache.find(666));
+  ASSERT_THROW(cache.get(666), std::out_of_range);
+}
+
+namespace {
+struct string_hash {
+  using is_transparent = void;
+  size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+}
+
+TEST(chord_concurrent_lru_cache, heterogeneous_lookup) {
+  ConcurrentLRUCache<string, int, string_hash, std::equal_to<>> cache(5);
+  cache.put("key", 1);
+
+  const std::string_view key{"key"};
+  ASSERT_TRUE(cache.exists(key));
+  ASSERT_EQ(cache.find(key), 1);
+  ASSERT_TRUE(cache.erase(key));
+  ASSERT_FALSE(cache.exists(key));
+}
+
+TEST(chord_concurrent_lru_cache, compute_if_absent_single_flight) {
+  ConcurrentLRUCache<int, string> cache(5);
+  std::atomic<int> calls{0};
+
+  std::vector<std::thread> threads;
+  std::vector<string> results(8);
+  for(size_t i=0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] {
+      results[i] = cache.compute_if_absent(42, [&](const int& key) {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::to_string(key);
+      });
+    });
+  }
+  for(auto& t : threads) t.join();
+
+  ASSERT_EQ(calls, 1);
+  for(const auto& result : results) ASSERT_EQ(result, "42");
+  ASSERT_EQ(cache.get(42), "42");
+}
+
+TEST(chord_concurrent_lru_cache, compute_if_absent_propagates_exceptions) {
+  ConcurrentLRUCache<int, string> cache(5);
+
+  ASSERT_THROW(cache.compute_if_absent(1, [](const int&) -> string { throw std::runtime_error("failed"); }), std::runtime_error);
+  ASSERT_FALSE(cache.exists(1));
+
+  // not cached, i.e. retried
+  ASSERT_EQ(cache.compute_if_absent(1, [](const int&) { return string{"1"}; }), "1");
+}
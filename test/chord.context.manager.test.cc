@@ -31,12 +31,35 @@ TEST(chord_context_manager, parse_valid_config) {
       ## folders
       data-directory: "./data-dir"
       meta-directory: "./meta-dir"
+      meta-block-cache-mb: 128
+      meta-bloom-bits-per-key: 12
+      meta-compression: lz4
+      meta-write-buffer-mb: 32
+      meta-background-jobs: 4
+      meta-disable-wal: true
+      meta-cache-size: 4096
+      successor-cache-size: 256
+      successor-cache-ttl-ms: 5000
       ## networking
       bind-addr: 127.0.0.1:50050
       join-addr: 127.0.0.1:50051
       ## details
       stabilize-ms: 5000
       check-ms: 5000
+      client-timeout-ms: 2000
+      rpc-timeouts-ms:
+        successor: 500
+        get: 60000
+      channel-keepalive-ms: 10000
+      fs-async-server: true
+      fs-max-concurrency: 128
+      fs-replication-threads: 2
+      fs-hash-cache: false
+      fs-delta-uploads: true
+      fs-chunk-store: true
+      fs-get-range-mb: 16
+      fs-resumable-puts: true
+      fs-partial-expiry-h: 48
       monitor: true
       register_shutdown_handler: true
       logging:
@@ -64,6 +87,15 @@ TEST(chord_context_manager, parse_valid_config) {
 
   ASSERT_EQ(context.data_directory, "./data-dir");
   ASSERT_EQ(context.meta_directory, "./meta-dir");
+  ASSERT_EQ(context.meta_block_cache_mb, 128);
+  ASSERT_EQ(context.meta_bloom_bits_per_key, 12);
+  ASSERT_EQ(context.meta_compression, "lz4");
+  ASSERT_EQ(context.meta_write_buffer_mb, 32);
+  ASSERT_EQ(context.meta_background_jobs, 4);
+  ASSERT_TRUE(context.meta_disable_wal);
+  ASSERT_EQ(context.meta_cache_size, 4096);
+  ASSERT_EQ(context.successor_cache_size, 256);
+  ASSERT_EQ(context.successor_cache_ttl_ms, 5000);
   ASSERT_EQ(context.bind_addr, "127.0.0.1:50050");
   ASSERT_EQ(context.join_addr, "127.0.0.1:50051");
   ASSERT_EQ(context.advertise_addr, "127.0.0.1:50050");
@@ -71,6 +103,21 @@ TEST(chord_context_manager, parse_valid_config) {
   ASSERT_EQ(context.monitor, true);
   ASSERT_EQ(context.register_shutdown_handler, true);
   ASSERT_EQ(context.check_period_ms, 5000);
+  ASSERT_EQ(context.timeout("join").count(), 2000);
+  ASSERT_EQ(context.timeout("successor").count(), 500);
+  ASSERT_EQ(context.timeout("get").count(), 60000);
+  // defaults of the remaining rpcs are kept
+  ASSERT_EQ(context.timeout("put").count(), 0);
+  ASSERT_EQ(context.channel_keepalive_ms, 10000);
+  ASSERT_TRUE(context.fs_async_server);
+  ASSERT_EQ(context.fs_max_concurrency, 128);
+  ASSERT_EQ(context.fs_replication_threads, 2);
+  ASSERT_FALSE(context.fs_hash_cache);
+  ASSERT_TRUE(context.fs_delta_uploads);
+  ASSERT_TRUE(context.fs_chunk_store);
+  ASSERT_EQ(context.fs_get_range_mb, 16);
+  ASSERT_TRUE(context.fs_resumable_puts);
+  ASSERT_EQ(context.fs_partial_expiry_h, 48);
   ASSERT_EQ(context.uuid(), 1234567890);
   auto formatters = context.logging.formatters;
   ASSERT_EQ(formatters.size(), 1);
@@ -10,7 +10,6 @@ using namespace std;
 using namespace chord;
 
 using chord::test::TmpFile;
-using boost::multiprecision::import_bits;
 
 class CryptoFileTest : public ::testing::Test {
   
@@ -48,8 +47,7 @@ TEST(CryptoTest, initialize) {
 
   //for (auto ch : md) printf("%X", ch);
 
-  auto uid = uuid{0};
-  import_bits(uid.value(), md, md + 32);
+  const auto uid = uuid::from_bytes({reinterpret_cast<const char*>(md), 32});
 
   ASSERT_EQ(uid.hex(), "2c26b46b68ffc68ff99b453c1d30413413422d706483bfa0f98a5e886266e7ae");
   ASSERT_EQ(uid, "19970150736239713706088444570146546354146685096673408908105596072151101138862");
@@ -88,3 +86,21 @@ TEST_F(CryptoFileTest, sha256_object) {
   ASSERT_EQ(hash.string(), "78163808323680042193722866647697615020714063641725196338206602615142164613113");
   ASSERT_EQ(hash.hex(), "accf25d1f41665e077c819907458c7363f30083c223cd3718ec851249ab647f9");
 }
+
+TEST(CryptoTest, sha256_hasher_resumes_from_state) {
+  // not a multiple of the block size (64)
+  const auto data = string(1000, 'x') + "SOMECONTENT";
+
+  for(const std::size_t split : {std::size_t{0}, std::size_t{64}, std::size_t{100}, data.size()}) {
+    crypto::sha256_hasher hasher;
+    hasher(data.data(), split);
+    const auto state = hasher.state();
+    ASSERT_EQ(state.size(), crypto::sha256_hasher::state_size);
+
+    crypto::sha256_hasher resumed{state};
+    resumed(data.data() + split, data.size() - split);
+    ASSERT_EQ(resumed.get(), crypto::sha256(data));
+  }
+
+  ASSERT_THROW(crypto::sha256_hasher{"invalid"}, chord::exception);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "chord.context.h"
+#include "chord.deadline.h"
+
+#include "util/chord.test.helper.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::test;
+
+using namespace std::chrono_literals;
+
+TEST(chord_deadline, timeout_of_rpc) {
+  Context context = make_context(0);
+  context.client_timeout_ms = 2000;
+  context.rpc_timeouts_ms["ping"] = 100;
+
+  const auto now = deadline::clock::now();
+  const auto ping = deadline::of(context, "ping");
+  const auto join = deadline::of(context, "join");
+
+  ASSERT_TRUE(ping && join);
+  ASSERT_LE(*ping, deadline::clock::now() + 100ms);
+  ASSERT_GE(*join, now + 2000ms);
+}
+
+TEST(chord_deadline, unbounded) {
+  Context context = make_context(0);
+  // transfers are not bounded by default
+  ASSERT_FALSE(deadline::of(context, "put"));
+  ASSERT_FALSE(deadline::of(context, "put", deadline::time_point::max()));
+  ASSERT_FALSE(deadline::exceeded({}));
+}
+
+TEST(chord_deadline, bounded_by_budget) {
+  Context context = make_context(0);
+  context.client_timeout_ms = 2000;
+
+  // budget of the origin shrinks the deadline of the forwarded request
+  const auto budget = deadline::clock::now() + 10ms;
+  ASSERT_EQ(deadline::of(context, "successor", budget), budget);
+  ASSERT_EQ(deadline::of(context, "put", budget), budget);
+
+  const auto exceeded = deadline::clock::now() - 1ms;
+  ASSERT_TRUE(deadline::exceeded(deadline::of(context, "successor", exceeded)));
+}
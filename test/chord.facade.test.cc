@@ -0,0 +1,137 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "util/chord.test.helper.h"
+
+#include "chord.client.mock.h"
+#include "chord.context.h"
+#include "chord.facade.h"
+#include "chord.node.h"
+#include "chord.router.h"
+#include "chord.service.mock.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::test;
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::StrictMock;
+
+class ChordFacadeTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      context = make_context(0);
+      context.successor_cache_size = 1024;
+      router = new Router(context);
+      client = new StrictMock<MockClient>();
+      service = new StrictMock<MockService>();
+      facade = std::make_unique<ChordFacade>(context, router, client, service);
+    }
+
+    Context context;
+    Router* router;
+    StrictMock<MockClient>* client;
+    StrictMock<MockService>* service;
+    std::unique_ptr<ChordFacade> facade;
+};
+
+TEST_F(ChordFacadeTest, fix_fingers_repairs_distinct_intervals) {
+  // [0..4] -> 32, [5..5] -> 33, [6..6] -> 128, [7..255] -> <empty>
+  router->update({32, "32"});
+  router->update({33, "33"});
+  router->update({128, "128"});
+
+  EXPECT_CALL(*service, fix_fingers(0));
+  EXPECT_CALL(*service, fix_fingers(5));
+  EXPECT_CALL(*service, fix_fingers(6));
+  EXPECT_CALL(*service, fix_fingers(7));
+
+  ASSERT_FALSE(facade->fix_fingers());
+}
+
+TEST_F(ChordFacadeTest, fix_fingers_measures_convergence) {
+  ASSERT_FALSE(facade->fingers_convergence_time());
+
+  // first round discovers a node in the (empty) ring
+  EXPECT_CALL(*service, fix_fingers(0))
+    .WillOnce(Invoke([this](size_t) { router->update({1024, "1024"}); }));
+  ASSERT_TRUE(facade->fix_fingers());
+  ASSERT_FALSE(facade->fingers_convergence_time());
+
+  // second round does not change the finger table
+  EXPECT_CALL(*service, fix_fingers(_)).Times(2);
+  ASSERT_FALSE(facade->fix_fingers());
+  ASSERT_TRUE(facade->fingers_convergence_time());
+}
+
+TEST_F(ChordFacadeTest, successor_is_cached) {
+  EXPECT_CALL(*service, successor(uuid_t{5}))
+    .WillOnce(Return(make_entry(10, "10")));
+  ASSERT_EQ(facade->successor(5).uuid, 10);
+  // [5, 10] is owned by 10
+  ASSERT_EQ(facade->successor(8).uuid, 10);
+  ASSERT_EQ(facade->successor_cache().hits(), 1);
+
+  // stale owner
+  ASSERT_TRUE(facade->invalidate(8));
+  EXPECT_CALL(*service, successor(uuid_t{8}))
+    .WillOnce(Return(make_entry(9, "9")));
+  ASSERT_EQ(facade->successor(8).uuid, 9);
+}
+
+TEST_F(ChordFacadeTest, successor_cache_is_cleared_on_churn) {
+  EXPECT_CALL(*service, successor(uuid_t{5}))
+    .Times(2)
+    .WillRepeatedly(Return(make_entry(10, "10")));
+  facade->successor(5);
+  router->update({128, "128"});
+  facade->successor(5);
+}
+
+TEST_F(ChordFacadeTest, successor_of_local_key) {
+  // predecessor 200: (200, 0) is owned by this node
+  router->update({200, "200"});
+  ASSERT_EQ(facade->successor(250), context.node());
+  ASSERT_EQ(facade->successor(uuid::max()), context.node());
+  ASSERT_EQ(facade->successor_cache().misses(), 0);
+}
+
+TEST_F(ChordFacadeTest, successor_bypasses_cache) {
+  EXPECT_CALL(*service, successor(uuid_t{5}))
+    .Times(2)
+    .WillRepeatedly(Return(make_entry(10, "10")));
+  facade->successor(5);
+  ASSERT_EQ(facade->successor(5, false).uuid, 10);
+  ASSERT_EQ(facade->successor_cache().hits(), 0);
+}
+
+TEST_F(ChordFacadeTest, is_responsible) {
+  // unknown predecessor
+  ASSERT_TRUE(facade->is_responsible(128));
+
+  // predecessor 200: (200, 0] is owned by this node
+  router->update({200, "200"});
+  ASSERT_TRUE(facade->is_responsible(250));
+  ASSERT_TRUE(facade->is_responsible(context.uuid()));
+  ASSERT_FALSE(facade->is_responsible(200));
+  ASSERT_FALSE(facade->is_responsible(128));
+}
+
+TEST_F(ChordFacadeTest, evict_failed_nodes) {
+  const node failed{32, "32"};
+  router->update(failed);
+  router->update({64, "64"});
+
+  router->failure_detector().failure(failed);
+  facade->evict_failed_nodes();
+  ASSERT_EQ(router->successor(), failed);
+
+  for(auto i = 1u; i < context.failure_max_count; ++i) {
+    router->failure_detector().failure(failed);
+  }
+  facade->evict_failed_nodes();
+  ASSERT_EQ(router->successor()->uuid, 64);
+  ASSERT_TRUE(router->failure_detector().suspected().empty());
+}
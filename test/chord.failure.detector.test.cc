@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "chord.failure.detector.h"
+#include "chord.node.h"
+
+using namespace std;
+using namespace chord;
+
+using ::testing::ElementsAre;
+
+using namespace std::chrono_literals;
+
+TEST(chord_failure_detector, unknown_node_is_alive) {
+  FailureDetector detector(8.0, 3, 1000ms);
+  ASSERT_TRUE(detector.is_alive({10, "10"}));
+  ASSERT_DOUBLE_EQ(detector.phi({10, "10"}), 0.0);
+  ASSERT_TRUE(detector.suspected().empty());
+}
+
+TEST(chord_failure_detector, silence_is_no_failure) {
+  FailureDetector detector(8.0, 3, 1000ms);
+  const node n{10, "10"};
+  const auto now = FailureDetector::clock::now();
+
+  detector.heartbeat(n, now);
+  detector.heartbeat(n, now + 100ms);
+  ASSERT_GT(detector.phi(n, now + 10s), 8.0);
+  ASSERT_TRUE(detector.is_alive(n, now + 10s));
+}
+
+TEST(chord_failure_detector, phi_accrues) {
+  FailureDetector detector(8.0, 3, 1000ms);
+  const node n{10, "10"};
+  const auto now = FailureDetector::clock::now();
+
+  detector.heartbeat(n, now);
+  detector.heartbeat(n, now + 100ms);
+  detector.failure(n, now + 150ms);
+  ASSERT_LT(detector.phi(n, now + 150ms), detector.phi(n, now + 1s));
+
+  // a single failure is tolerated unless phi exceeds the threshold
+  ASSERT_TRUE(detector.is_alive(n, now + 200ms));
+  ASSERT_FALSE(detector.is_alive(n, now + 10s));
+  ASSERT_THAT(detector.suspected(now + 10s), ElementsAre(n.uuid));
+}
+
+TEST(chord_failure_detector, consecutive_failures) {
+  FailureDetector detector(8.0, 3, 1000ms);
+  const node n{10, "10"};
+  const auto now = FailureDetector::clock::now();
+
+  detector.failure(n, now);
+  detector.failure(n, now);
+  ASSERT_TRUE(detector.is_alive(n, now));
+  detector.failure(n, now);
+  ASSERT_TRUE(detector.suspects(n, now));
+
+  // node recovered
+  detector.heartbeat(n, now + 10ms);
+  ASSERT_TRUE(detector.is_alive(n, now + 10ms));
+}
+
+TEST(chord_failure_detector, remove) {
+  FailureDetector detector(8.0, 1, 1000ms);
+  const node n{10, "10"};
+
+  detector.failure(n);
+  ASSERT_TRUE(detector.suspects(n));
+  detector.remove(n.uuid);
+  ASSERT_TRUE(detector.is_alive(n));
+
+  detector.failure(n);
+  detector.clear();
+  ASSERT_TRUE(detector.suspected().empty());
+}
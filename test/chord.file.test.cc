@@ -10,7 +10,7 @@ using namespace chord::test;
 
 using chord::path;
 
-TEST(DISABLED_chord_file, getxattr) {
+TEST(chord_file, getxattr) {
   auto file = "xattr.get";
   auto attr_name = "user.chord.link";
 
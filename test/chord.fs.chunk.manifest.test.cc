@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "chord.crypto.h"
+#include "chord.fs.chunk.manifest.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+constexpr std::uint64_t chunk_size = 4;
+
+ChunkManifest manifest_of(const string& content) {
+  ChunkManifest manifest;
+  manifest.file_hash = crypto::sha256(content);
+  manifest.chunk_size = chunk_size;
+  manifest.file_size = content.size();
+  for(size_t offset = 0; offset < content.size(); offset += chunk_size) {
+    manifest.chunks.push_back(crypto::sha256(content.substr(offset, chunk_size)));
+  }
+  return manifest;
+}
+}
+
+TEST(chord_fs_chunk_manifest, count) {
+  ASSERT_EQ(ChunkManifest::count(0, chunk_size), 0);
+  ASSERT_EQ(ChunkManifest::count(1, chunk_size), 1);
+  ASSERT_EQ(ChunkManifest::count(4, chunk_size), 1);
+  ASSERT_EQ(ChunkManifest::count(5, chunk_size), 2);
+}
+
+TEST(chord_fs_chunk_manifest, build_sequential) {
+  const string content = "0123456789";
+  ChunkManifest::Builder builder{chunk_size};
+
+  // writes are not aligned to the chunks
+  builder.write(0, content.data(), 3);
+  builder.write(3, content.data() + 3, 6);
+  builder.write(9, content.data() + 9, 1);
+
+  ASSERT_EQ(builder.finish(crypto::sha256(content), content.size()), manifest_of(content));
+}
+
+TEST(chord_fs_chunk_manifest, build_empty) {
+  ChunkManifest::Builder builder{chunk_size};
+  const auto manifest = builder.finish(crypto::sha256(""), 0);
+  ASSERT_TRUE(manifest);
+  ASSERT_TRUE(manifest->chunks.empty());
+}
+
+TEST(chord_fs_chunk_manifest, build_delta) {
+  const string content = "0123456789";
+  const string changed = "0123xxxx89ab";
+  ChunkManifest::Builder builder{manifest_of(content)};
+
+  // the first chunk is kept
+  builder.write(4, changed.data() + 4, 4);
+  builder.write(8, changed.data() + 8, 4);
+
+  ASSERT_EQ(builder.finish(crypto::sha256(changed), changed.size()), manifest_of(changed));
+}
+
+TEST(chord_fs_chunk_manifest, build_delta_truncated) {
+  const string content = "0123456789";
+  const string changed = "012345";
+  ChunkManifest::Builder builder{manifest_of(content)};
+
+  builder.write(4, changed.data() + 4, 2);
+
+  ASSERT_EQ(builder.finish(crypto::sha256(changed), changed.size()), manifest_of(changed));
+}
+
+TEST(chord_fs_chunk_manifest, build_incomplete) {
+  const string content = "0123456789";
+  {
+    // chunk not written and no base
+    ChunkManifest::Builder builder{chunk_size};
+    builder.write(4, content.data() + 4, 6);
+    ASSERT_FALSE(builder.finish(crypto::sha256(content), content.size()));
+  }
+  {
+    // chunk left before it is complete
+    ChunkManifest::Builder builder{manifest_of(content)};
+    builder.write(0, content.data(), 2);
+    builder.write(8, content.data() + 8, 2);
+    ASSERT_FALSE(builder.finish(crypto::sha256(content), content.size()));
+  }
+}
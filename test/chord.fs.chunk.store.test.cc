@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "chord.context.h"
+#include "chord.crypto.h"
+#include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.fs.chunk.store.h"
+#include "chord.fs.chunker.h"
+#include "chord.fs.metadata.manager.h"
+#include "chord.test.tmp.dir.h"
+#include "chord.uri.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::fs;
+using namespace chord::test;
+
+namespace {
+
+string make_data(const size_t size, const unsigned seed = 4711) {
+  mt19937 engine{seed};
+  uniform_int_distribution<int> dist{0, 255};
+  string data(size, '\0');
+  for(auto& c : data) c = static_cast<char>(dist(engine));
+  return data;
+}
+
+string read(istream& stream) {
+  return {istreambuf_iterator<char>{stream}, istreambuf_iterator<char>{}};
+}
+
+struct ChunkStoreTest : public ::testing::Test {
+  TmpDir meta;
+  Context context;
+  unique_ptr<MetadataManager> metadata_mgr;
+  unique_ptr<ChunkStore> store;
+
+  void SetUp() override {
+    context.meta_directory = meta.path;
+    metadata_mgr = make_unique<MetadataManager>(context);
+    store = make_unique<ChunkStore>(context, metadata_mgr.get(), Chunker{1024, 4096, 16384});
+  }
+
+  ChunkRecipe add(const uri& uri, const string& data) {
+    istringstream stream{data};
+    return store->add(uri, stream);
+  }
+};
+
+}
+
+TEST_F(ChunkStoreTest, add_and_open) {
+  const auto uri = uri::from("chord:/file");
+  const auto data = make_data(256*1024);
+
+  const auto recipe = add(uri, data);
+  ASSERT_EQ(recipe.file_size, data.size());
+  ASSERT_EQ(recipe.file_hash, crypto::sha256(data.data(), data.size()));
+  ASSERT_GT(recipe.chunks.size(), 1);
+  ASSERT_EQ(store->recipe(uri), recipe);
+
+  for(const auto& chunk : recipe.chunks) {
+    ASSERT_TRUE(store->contains(chunk.hash));
+  }
+
+  auto stream = store->open(recipe);
+  ASSERT_EQ(read(*stream), data);
+
+  // seek across and within chunks
+  for(const size_t offset : {size_t{100*1024}, size_t{5}, size_t{5000}, size_t{data.size() - 10}}) {
+    stream->clear();
+    stream->seekg(static_cast<streamoff>(offset));
+    string buffer(10, '\0');
+    stream->read(buffer.data(), 10);
+    ASSERT_EQ(buffer, data.substr(offset, 10));
+  }
+}
+
+TEST_F(ChunkStoreTest, deduplicates_versions) {
+  const auto file1 = uri::from("chord:/file1");
+  const auto file2 = uri::from("chord:/file2");
+  const auto data = make_data(256*1024);
+  auto changed = data;
+  changed.insert(128*1024, "edit");
+
+  const auto recipe = add(file1, data);
+  add(file2, data);
+  for(const auto& chunk : recipe.chunks) {
+    ASSERT_EQ(metadata_mgr->refs(chunk.hash), 2);
+  }
+
+  // new version of file1 - the chunks around the edit are replaced
+  const auto changed_recipe = add(file1, changed);
+  ASSERT_EQ(read(*store->open(changed_recipe)), changed);
+
+  store->remove(file2);
+  size_t released = 0;
+  for(const auto& chunk : recipe.chunks) {
+    if(!store->contains(chunk.hash)) ++released;
+  }
+  ASSERT_GT(released, 0);
+  ASSERT_LT(released, recipe.chunks.size());
+
+  store->remove(file1);
+  for(const auto& chunk : changed_recipe.chunks) {
+    ASSERT_FALSE(store->contains(chunk.hash));
+    ASSERT_EQ(metadata_mgr->refs(chunk.hash), 0);
+  }
+  ASSERT_FALSE(store->recipe(file1));
+}
+
+TEST_F(ChunkStoreTest, add_recipe_requires_chunks) {
+  const auto uri = uri::from("chord:/file");
+  const auto data = make_data(64*1024);
+
+  ChunkRecipe recipe;
+  istringstream stream{data};
+  Chunker{1024, 4096, 16384}.split(stream, [&](const char* chunk, const size_t len) {
+    recipe.chunks.push_back({crypto::sha256(chunk, len), static_cast<uint32_t>(len)});
+    recipe.file_size += len;
+  });
+  recipe.file_hash = crypto::sha256(data.data(), data.size());
+
+  vector<uuid> hashes;
+  for(const auto& chunk : recipe.chunks) hashes.push_back(chunk.hash);
+
+  // store all but the first chunk
+  const auto first = recipe.chunks.front().size;
+  store->store(data.data() + first, recipe.chunks[1].size);
+  ASSERT_EQ(store->missing(hashes).front(), 0);
+  ASSERT_FALSE(store->add(uri, recipe));
+  ASSERT_FALSE(store->recipe(uri));
+
+  size_t offset = 0;
+  for(const auto& chunk : recipe.chunks) {
+    ASSERT_EQ(store->store(data.data() + offset, chunk.size), chunk.hash);
+    offset += chunk.size;
+  }
+  ASSERT_TRUE(store->missing(hashes).empty());
+  ASSERT_TRUE(store->add(uri, recipe));
+  ASSERT_EQ(read(*store->open(recipe)), data);
+}
+
+TEST_F(ChunkStoreTest, load_missing_chunk_throws) {
+  ASSERT_THROW(store->load(uuid_t{4711}), chord::exception);
+
+  const auto recipe = add(uri::from("chord:/file"), make_data(64*1024));
+  file::remove(store->chunk_path(recipe.chunks.back().hash));
+  auto stream = store->open(recipe);
+  ASSERT_THROW(read(*stream), chord::exception);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chord.exception.h"
+#include "chord.fs.chunker.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+
+string make_data(const size_t size, const unsigned seed = 4711) {
+  mt19937 engine{seed};
+  uniform_int_distribution<int> dist{0, 255};
+  string data(size, '\0');
+  for(auto& c : data) c = static_cast<char>(dist(engine));
+  return data;
+}
+
+vector<string> split(const Chunker& chunker, const string& data) {
+  vector<string> chunks;
+  istringstream stream{data};
+  chunker.split(stream, [&](const char* chunk, const size_t len) {
+    chunks.emplace_back(chunk, len);
+  });
+  return chunks;
+}
+
+}
+
+TEST(chord_fs_chunker, invalid_sizes) {
+  ASSERT_THROW(Chunker(1024, 3000, 8192), chord::exception);
+  ASSERT_THROW(Chunker(4096, 4096, 8192), chord::exception);
+  ASSERT_THROW(Chunker(1024, 4096, 4096), chord::exception);
+  ASSERT_NO_THROW(Chunker(1024, 4096, 16384));
+}
+
+TEST(chord_fs_chunker, cut_within_bounds) {
+  const Chunker chunker{1024, 4096, 16384};
+  const auto data = make_data(1024*1024);
+
+  ASSERT_EQ(chunker.cut(data.data(), 1000), 1000);
+  ASSERT_EQ(chunker.cut(data.data(), 0), 0);
+
+  for(size_t offset = 0; offset + chunker.max() < data.size();) {
+    const auto len = chunker.cut(data.data() + offset, data.size() - offset);
+    ASSERT_GT(len, 1024);
+    ASSERT_LE(len, 16384);
+    offset += len;
+  }
+}
+
+TEST(chord_fs_chunker, split_concatenates_to_stream) {
+  const Chunker chunker{1024, 4096, 16384};
+  const auto data = make_data(1024*1024 + 17);
+
+  const auto chunks = split(chunker, data);
+  ASSERT_GT(chunks.size(), 1);
+
+  string joined;
+  for(const auto& chunk : chunks) joined += chunk;
+  ASSERT_EQ(joined, data);
+
+  // deterministic
+  ASSERT_EQ(split(chunker, data), chunks);
+  ASSERT_TRUE(split(chunker, "").empty());
+}
+
+TEST(chord_fs_chunker, boundaries_resync_after_insert) {
+  const Chunker chunker{1024, 4096, 16384};
+  const auto data = make_data(512*1024);
+  auto changed = data;
+  changed.insert(100*1024, "inserted");
+
+  const auto chunks = split(chunker, data);
+  const auto changed_chunks = split(chunker, changed);
+
+  // all but the chunks around the insert are shared
+  size_t shared = 0;
+  for(const auto& chunk : changed_chunks) {
+    if(find(chunks.begin(), chunks.end(), chunk) != chunks.end()) ++shared;
+  }
+  ASSERT_GE(shared + 2, chunks.size());
+  ASSERT_LT(shared, changed_chunks.size());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+
+#include "chord.exception.h"
+#include "chord.fs.metadata.codec.h"
+#include "chord.fs.metadata.h"
+#include "chord.node.h"
+#include "chord.uuid.h"
+
+using namespace std;
+using namespace chord;
+using namespace chord::fs;
+
+namespace {
+map<string, Metadata> make_directory() {
+  const auto hash = uuid_t{"113427455640312821154458202477256070485"};
+  return {
+    {".", {".", "usr", "grp", perms::all, type::directory, 0, {}, {}, Replication(0, 3)}},
+    {"foo", {"foo", "usr", "grp", perms::owner_all, type::regular, 1ull << 40, hash, {}, Replication(1, 3)}},
+    {"bar", {"bar", "usr2", "grp", perms::owner_all | perms::group_read, type::regular, 33, hash,
+             node{uuid_t{4711}, "127.0.0.1:50050"}, Replication::ALL}}
+  };
+}
+}
+
+TEST(chord_metadata_codec, encode_decode) {
+  const auto directory = make_directory();
+  const auto encoded = MetadataCodec::encode(directory);
+
+  ASSERT_FALSE(MetadataCodec::is_legacy(encoded));
+  const auto decoded = MetadataCodec::decode(encoded);
+  ASSERT_EQ(decoded, directory);
+
+  const auto& bar = decoded.at("bar");
+  ASSERT_EQ(bar.owner, "usr2");
+  ASSERT_EQ(bar.node_ref->uuid, uuid_t{4711});
+  ASSERT_EQ(bar.node_ref->endpoint, "127.0.0.1:50050");
+  ASSERT_EQ(bar.replication, Replication::ALL);
+  ASSERT_EQ(decoded.at("foo").file_size, 1ull << 40);
+  ASSERT_EQ(decoded.at("foo").file_hash, uuid_t{"113427455640312821154458202477256070485"});
+  ASSERT_FALSE(decoded.at(".").file_hash);
+}
+
+TEST(chord_metadata_codec, encode_decode_chunks) {
+  ChunkManifest manifest;
+  manifest.file_hash = uuid_t{"113427455640312821154458202477256070485"};
+  manifest.chunk_size = 512;
+  manifest.file_size = 1025;
+  manifest.chunks = {uuid_t{1}, uuid_t{2}, uuid::max()};
+
+  const auto encoded = MetadataCodec::encode_chunks(manifest);
+  ASSERT_EQ(MetadataCodec::decode_chunks(encoded), manifest);
+
+  // chunks missing
+  ASSERT_THROW(MetadataCodec::decode_chunks(encoded.substr(0, encoded.size() - 1)), chord::exception);
+  manifest.file_size = 2048;
+  ASSERT_THROW(MetadataCodec::decode_chunks(MetadataCodec::encode_chunks(manifest)), chord::exception);
+}
+
+TEST(chord_metadata_codec, encode_decode_recipe) {
+  ChunkRecipe recipe;
+  recipe.file_hash = uuid_t{"113427455640312821154458202477256070485"};
+  recipe.file_size = 70000;
+  recipe.chunks = {{uuid_t{1}, 65536}, {uuid_t{2}, 1}, {uuid::max(), 4463}};
+
+  const auto encoded = MetadataCodec::encode_recipe(recipe);
+  ASSERT_EQ(MetadataCodec::decode_recipe(encoded), recipe);
+  ASSERT_EQ(MetadataCodec::decode_recipe(MetadataCodec::encode_recipe({})), ChunkRecipe{});
+
+  // chunks missing
+  ASSERT_THROW(MetadataCodec::decode_recipe(encoded.substr(0, encoded.size() - 1)), chord::exception);
+  recipe.file_size = 70001;
+  ASSERT_THROW(MetadataCodec::decode_recipe(MetadataCodec::encode_recipe(recipe)), chord::exception);
+}
+
+TEST(chord_metadata_codec, decode_empty) {
+  ASSERT_TRUE(MetadataCodec::decode("").empty());
+  ASSERT_TRUE(MetadataCodec::decode(MetadataCodec::encode({})).empty());
+}
+
+TEST(chord_metadata_codec, decode_legacy) {
+  const auto directory = make_directory();
+  stringstream ss;
+  boost::archive::text_oarchive oa{ss};
+  oa << directory;
+
+  ASSERT_TRUE(MetadataCodec::is_legacy(ss.str()));
+  ASSERT_EQ(MetadataCodec::decode(ss.str()), directory);
+}
+
+TEST(chord_metadata_codec, decode_truncated_throws) {
+  const auto encoded = MetadataCodec::encode(make_directory());
+  for(size_t len = 1; len < encoded.size(); ++len) {
+    ASSERT_THROW(MetadataCodec::decode(string_view{encoded}.substr(0, len)), chord::exception);
+  }
+}
+
+TEST(chord_metadata_codec, decode_unknown_version_throws) {
+  auto encoded = MetadataCodec::encode(make_directory());
+  encoded[1] = static_cast<char>(MetadataCodec::VERSION + 1);
+  ASSERT_THROW(MetadataCodec::decode(encoded), chord::exception);
+}
@@ -2,6 +2,7 @@
 
 #include <set>
 #include <map>
+#include <optional>
 
 #include "chord.i.fs.metadata.manager.h"
 #include "chord.fs.metadata.h"
@@ -23,6 +24,8 @@ class MockMetadataManager : public IMetadataManager {
 
   MOCK_METHOD2(add, bool(const chord::uri&, const std::set<Metadata>&));
 
+  MOCK_METHOD1(apply, void(const MetadataBatch&));
+
   MOCK_METHOD0(get_all, IMetadataManager::uri_meta_map_desc());
   MOCK_METHOD2(get, IMetadataManager::uri_meta_map_desc(const chord::uuid&, const chord::uuid&));
 
@@ -31,6 +34,13 @@ class MockMetadataManager : public IMetadataManager {
   MOCK_METHOD1(get, std::set<Metadata>(const chord::uri&));
 
   MOCK_METHOD1(exists, bool(const chord::uri&));
+
+  MOCK_METHOD1(chunks, std::optional<ChunkManifest>(const chord::uri&));
+  MOCK_METHOD2(chunks, void(const chord::uri&, const ChunkManifest&));
+
+  MOCK_METHOD1(recipe, std::optional<ChunkRecipe>(const chord::uri&));
+  MOCK_METHOD2(recipe, std::vector<chord::uuid>(const chord::uri&, const std::optional<ChunkRecipe>&));
+  MOCK_METHOD1(refs, std::uint64_t(const chord::uuid&));
 };
 
 } //namespace fs
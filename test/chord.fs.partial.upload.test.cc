@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "chord.context.h"
+#include "chord.crypto.h"
+#include "chord.exception.h"
+#include "chord.file.h"
+#include "chord.fs.partial.upload.h"
+#include "chord.uri.h"
+#include "util/chord.test.tmp.dir.h"
+
+using namespace std;
+using namespace std::chrono_literals;
+using namespace chord;
+using namespace chord::fs;
+using namespace chord::test;
+
+namespace {
+
+string read(const chord::path& path) {
+  ifstream file(path, ios::binary);
+  return {istreambuf_iterator<char>{file}, istreambuf_iterator<char>{}};
+}
+
+size_t partial_files(const Context& context) {
+  size_t count = 0;
+  for(const auto& entry : std::filesystem::directory_iterator(string{context.partial_directory()})) {
+    (void)entry;
+    ++count;
+  }
+  return count;
+}
+
+}
+
+class PartialUploadTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      context.meta_directory = meta.path;
+      for(int i = 0; i < 1000; ++i) data += to_string(i);
+      file_hash = crypto::sha256(data);
+    }
+
+    TmpDir meta;
+    TmpDir target_directory;
+    Context context;
+    PartialUpload::Registry registry;
+    const chord::uri uri = chord::uri::from("chord:/file");
+    string data;
+    chord::uuid file_hash;
+};
+
+TEST_F(PartialUploadTest, resumes_at_committed_offset) {
+  {
+    auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+    ASSERT_EQ(upload->offset(), 0);
+    upload->write(0, data.data(), 100);
+    upload->write(100, data.data() + 100, 1000);
+    ASSERT_FALSE(upload->complete());
+  }
+
+  auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+  ASSERT_EQ(upload->offset(), 1100);
+  ASSERT_THROW(upload->write(0, data.data(), 100), chord::exception);
+
+  upload->write(1100, data.data() + 1100, data.size() - 1100);
+  ASSERT_TRUE(upload->complete());
+
+  const auto target = target_directory.path / "file";
+  upload->finish(target);
+  ASSERT_EQ(read(target), data);
+  ASSERT_EQ(partial_files(context), 0);
+}
+
+TEST_F(PartialUploadTest, drops_data_received_after_saved_state) {
+  {
+    auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+    upload->write(0, data.data(), 100);
+  }
+  // crashed before the state of the data received has been saved
+  const auto partial = context.partial_directory() / crypto::sha256(uri).hex();
+  {
+    ofstream file(partial, ios::binary | ios::app);
+    file << "received after the state";
+  }
+
+  auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+  ASSERT_EQ(upload->offset(), 100);
+  ASSERT_EQ(file::file_size(partial), 100);
+}
+
+TEST_F(PartialUploadTest, rejects_concurrent_upload) {
+  {
+    auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+    ASSERT_TRUE(upload);
+    ASSERT_FALSE(PartialUpload::open(registry, context, uri, file_hash, data.size()));
+    // other files are not affected
+    ASSERT_TRUE(PartialUpload::open(registry, context, chord::uri::from("chord:/other"), file_hash, data.size()));
+  }
+  ASSERT_TRUE(PartialUpload::open(registry, context, uri, file_hash, data.size()));
+}
+
+TEST_F(PartialUploadTest, starts_over_for_other_version) {
+  {
+    auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+    upload->write(0, data.data(), 100);
+  }
+  const auto changed = data + "changed";
+  auto upload = PartialUpload::open(registry, context, uri, crypto::sha256(changed), changed.size());
+  ASSERT_EQ(upload->offset(), 0);
+}
+
+TEST_F(PartialUploadTest, discards_on_hash_mismatch) {
+  auto corrupt = data;
+  corrupt[42] = 'x';
+
+  auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+  ASSERT_THROW(upload->write(0, data.data(), data.size() + 1), chord::exception);
+  upload->write(0, corrupt.data(), corrupt.size());
+
+  const auto target = target_directory.path / "file";
+  ASSERT_THROW(upload->finish(target), chord::exception);
+  ASSERT_FALSE(file::exists(target));
+  ASSERT_EQ(partial_files(context), 0);
+}
+
+TEST_F(PartialUploadTest, expires_uploads_not_resumed) {
+  {
+    auto upload = PartialUpload::open(registry, context, uri, file_hash, data.size());
+    upload->write(0, data.data(), 100);
+  }
+  for(const auto& entry : std::filesystem::directory_iterator(string{context.partial_directory()})) {
+    std::filesystem::last_write_time(entry.path(), std::filesystem::file_time_type::clock::now() - 25h);
+  }
+  {
+    auto upload = PartialUpload::open(registry, context, chord::uri::from("chord:/recent"), file_hash, data.size());
+    upload->write(0, data.data(), 100);
+  }
+  ASSERT_EQ(partial_files(context), 4);
+
+  PartialUpload::expire(context);
+  ASSERT_EQ(partial_files(context), 2);
+  ASSERT_EQ(PartialUpload::open(registry, context, uri, file_hash, data.size())->offset(), 0);
+}
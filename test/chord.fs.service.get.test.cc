@@ -3,10 +3,15 @@
 
 #include "chord.peer.mock.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 
+#include <grpc++/create_channel.h>
 #include <grpc++/server.h>
 #include <grpc++/server_builder.h>
 #include <grpc++/security/server_credentials.h>
@@ -70,9 +75,45 @@ class FilesystemServiceGetTest : public ::testing::Test {
       self = make_unique<MockPeer>("0.0.0.0:50050", make_shared<TmpDir>());
     }
 
+    /**
+     * the successor of self - owning the key next to self only, i.e. self
+     * owns the files (also if the lookups are cached)
+     */
+    unique_ptr<MockPeer> make_replica() {
+      return make_unique<MockPeer>(self->context.uuid() + chord::uuid{1}, endpoint{"0.0.0.0:50051"}, make_shared<TmpDir>(), self->context.fs_async_server);
+    }
+
+    /**
+     * self owns the files, the replica is its successor
+     */
+    void expect_replica(MockPeer& replica) {
+      EXPECT_CALL(*self->service, successor(_)).WillRepeatedly(Return(make_entry(self->context.node())));
+      EXPECT_CALL(*self->service, successor(self->context.uuid() + chord::uuid{1})).WillRepeatedly(Return(make_entry(replica.context.node())));
+    }
+
+    static std::string read(const chord::path& path) {
+      std::ifstream file(path, std::ios::binary);
+      return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    void get_range();
+    void get_binary_id();
+    void get_in_ranges();
+    void get_in_ranges_failover();
+
     unique_ptr<MockPeer> self;
 };
 
+/**
+ * gets served by the callback service (fs-async-server)
+ */
+class FilesystemServiceAsyncGetTest : public FilesystemServiceGetTest {
+  protected:
+    void SetUp() override {
+      self = make_unique<MockPeer>("0.0.0.0:50050", make_shared<TmpDir>(), true);
+    }
+};
+
 TEST_F(FilesystemServiceGetTest, get) {
   GetRequest req;
   GetResponse res;
@@ -90,6 +131,163 @@ TEST_F(FilesystemServiceGetTest, get) {
   ASSERT_TRUE(chord::file::files_equal(source_file.path, target_file.path));
 }
 
+void FilesystemServiceGetTest::get_range() {
+  TmpFile source_file(self->context.data_directory / "file");
+  std::ifstream source(source_file.path);
+  const std::string data{std::istreambuf_iterator<char>{source}, std::istreambuf_iterator<char>{}};
+  const auto node = self->context.node();
+
+  std::ostringstream range;
+  ASSERT_TRUE(self->fs_client->get(uri("chord:///file"), node, range, 3, 10).ok());
+  ASSERT_EQ(range.str(), data.substr(3, 10));
+
+  // to the end of the file
+  std::ostringstream tail;
+  ASSERT_TRUE(self->fs_client->get(uri("chord:///file"), node, tail, 3, 0).ok());
+  ASSERT_EQ(tail.str(), data.substr(3));
+
+  std::ostringstream beyond;
+  const auto status = self->fs_client->get(uri("chord:///file"), node, beyond, data.size() + 1, 0);
+  ASSERT_EQ(status.error_code(), grpc::StatusCode::OUT_OF_RANGE);
+  ASSERT_TRUE(beyond.str().empty());
+}
+
+TEST_F(FilesystemServiceGetTest, get_range) {
+  get_range();
+}
+
+/**
+ * the response echoes the id of the request - binary only once the
+ * legacy uuids are switched off
+ */
+void FilesystemServiceGetTest::get_binary_id() {
+  const auto source_uri = uri("chord:///file");
+  TmpFile source_file(self->context.data_directory / "file");
+  self->context.legacy_uuids = false;
+
+  GetRequest req;
+  req.set_id_bin(crypto::sha256(source_uri).bytes());
+  req.set_uri(source_uri);
+  grpc::ClientContext client_context;
+  const auto stub = Filesystem::NewStub(grpc::CreateChannel(self->context.advertise_addr, grpc::InsecureChannelCredentials()));
+  const auto reader = stub->get(&client_context, req);
+
+  GetResponse res;
+  ASSERT_TRUE(reader->Read(&res));
+  ASSERT_TRUE(res.id().empty());
+  ASSERT_EQ(chord::uuid::from_bytes(res.id_bin()), crypto::sha256(source_uri));
+  while(reader->Read(&res));
+  ASSERT_TRUE(reader->Finish().ok());
+}
+
+TEST_F(FilesystemServiceGetTest, get_binary_id) {
+  get_binary_id();
+}
+
+void FilesystemServiceGetTest::get_in_ranges() {
+  const auto source_uri = uri("chord:///file");
+  TmpFile source_file(self->context.data_directory / "file");
+
+  EXPECT_CALL(*self->service, successor(_)).WillRepeatedly(Return(make_entry(self->context.node())));
+
+  Metadata metadata("file", "", "", perms::all, type::regular, file::file_size(source_file.path), crypto::sha256(source_file.path), {}, Replication(2));
+  EXPECT_CALL(*self->metadata_mgr, exists(source_uri)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(source_uri)).WillRepeatedly(Return(std::set<Metadata>{metadata}));
+
+  TmpDir tmp;
+  const auto target_file = tmp.path / "received_file";
+  // ranges of 8 bytes
+  const auto status = self->fs_client->get(source_uri, target_file, 8);
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_file.path, target_file));
+}
+
+TEST_F(FilesystemServiceGetTest, get_in_ranges) {
+  get_in_ranges();
+}
+
+/**
+ * the replica holds an outdated (shorter) copy - the ranges it lacks
+ * are taken from the next node
+ */
+void FilesystemServiceGetTest::get_in_ranges_failover() {
+  const auto replica = make_replica();
+  const auto source_uri = uri("chord:///file");
+  TmpFile source_file(self->context.data_directory / "file");
+  const auto data = read(source_file.path);
+  {
+    std::ofstream outdated(replica->context.data_directory / "file", std::ios::binary);
+    outdated << data.substr(0, data.size() / 2);
+  }
+
+  expect_replica(*replica);
+  Metadata metadata("file", "", "", perms::all, type::regular, data.size(), crypto::sha256(source_file.path), {}, Replication(2));
+  EXPECT_CALL(*self->metadata_mgr, exists(source_uri)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(source_uri)).WillRepeatedly(Return(std::set<Metadata>{metadata}));
+
+  TmpDir tmp;
+  const auto target_file = tmp.path / "received_file";
+  const auto status = self->fs_client->get(source_uri, target_file, 8);
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_file.path, target_file));
+}
+
+TEST_F(FilesystemServiceGetTest, get_in_ranges_fails_over_to_next_node) {
+  get_in_ranges_failover();
+}
+
+/**
+ * the replica holds another version of the file - the file is taken
+ * from the owner once the hash of the ranges does not match
+ */
+TEST_F(FilesystemServiceGetTest, get_in_ranges_falls_back_on_hash_mismatch) {
+  const auto replica = make_replica();
+  const auto source_uri = uri("chord:///file");
+  TmpFile source_file(self->context.data_directory / "file");
+  auto data = read(source_file.path);
+  {
+    std::reverse(data.begin(), data.end());
+    std::ofstream other(replica->context.data_directory / "file", std::ios::binary);
+    other << data;
+  }
+
+  expect_replica(*replica);
+  Metadata metadata("file", "", "", perms::all, type::regular, data.size(), crypto::sha256(source_file.path), {}, Replication(2));
+  EXPECT_CALL(*self->metadata_mgr, exists(source_uri)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(source_uri)).WillRepeatedly(Return(std::set<Metadata>{metadata}));
+
+  TmpDir tmp;
+  const auto target_file = tmp.path / "received_file";
+  const auto status = self->fs_client->get(source_uri, target_file, 8);
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_file.path, target_file));
+}
+
+/**
+ * a range failing on every node (the file shrank since the metadata has
+ * been read) - the file is taken from the owner
+ */
+TEST_F(FilesystemServiceGetTest, get_in_ranges_falls_back_on_failed_range) {
+  const auto source_uri = uri("chord:///file");
+  TmpFile source_file(self->context.data_directory / "file");
+
+  EXPECT_CALL(*self->service, successor(_)).WillRepeatedly(Return(make_entry(self->context.node())));
+
+  Metadata metadata("file", "", "", perms::all, type::regular, file::file_size(source_file.path) + 16, crypto::sha256(source_file.path), {}, Replication(1));
+  EXPECT_CALL(*self->metadata_mgr, exists(source_uri)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(source_uri)).WillRepeatedly(Return(std::set<Metadata>{metadata}));
+
+  TmpDir tmp;
+  const auto target_file = tmp.path / "received_file";
+  const auto status = self->fs_client->get(source_uri, target_file, 8);
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_file.path, target_file));
+}
+
 TEST_F(FilesystemServiceGetTest, get_from_node_reference) {
   const auto source_data_directory = make_shared<TmpDir>();
   const endpoint source_endpoint("0.0.0.0:50051");
@@ -222,3 +420,19 @@ TEST_F(FilesystemServiceGetTest, get_from_replication_propagates) {
   ASSERT_TRUE(chord::file::files_equal(source_file->path, self->context.data_directory / "file"));
   ASSERT_TRUE(chord::file::files_equal(source_file->path, middle_peer.context.data_directory / "file"));
 }
+
+TEST_F(FilesystemServiceAsyncGetTest, get_range) {
+  get_range();
+}
+
+TEST_F(FilesystemServiceAsyncGetTest, get_in_ranges) {
+  get_in_ranges();
+}
+
+TEST_F(FilesystemServiceAsyncGetTest, get_in_ranges_fails_over_to_next_node) {
+  get_in_ranges_failover();
+}
+
+TEST_F(FilesystemServiceAsyncGetTest, get_binary_id) {
+  get_binary_id();
+}
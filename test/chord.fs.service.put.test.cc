@@ -3,10 +3,13 @@
 
 #include "chord.peer.mock.h"
 
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <string>
 
+#include <grpc++/create_channel.h>
 #include <grpc++/server.h>
 #include <grpc++/server_builder.h>
 #include <grpc++/security/server_credentials.h>
@@ -17,10 +20,13 @@
 #include "chord.crypto.h"
 #include "chord.facade.h"
 #include "chord.file.h"
+#include "chord.fs.chunk.manifest.h"
 #include "chord.fs.client.h"
+#include "chord.fs.context.metadata.h"
 #include "chord.fs.facade.h"
 #include "chord.fs.metadata.h"
 #include "chord.fs.metadata.manager.mock.h"
+#include "chord.fs.partial.upload.h"
 #include "chord.fs.perms.h"
 #include "chord.fs.replication.h"
 #include "chord.fs.service.h"
@@ -69,10 +75,29 @@ class FilesystemServicePutTest : public ::testing::Test {
       self = make_unique<MockPeer>("0.0.0.0:50050", make_shared<TmpDir>());
     }
 
+    void put_file();
+    void put_hash_equal();
+    void put_replication_2(const bool pipelined);
+    void delta_put(const bool local_copy);
+    void delta_put_truncated();
+    void put_resumed();
+    void put_cancelled();
+    void put_not_responsible();
+
     unique_ptr<MockPeer> self;
 };
 
-TEST_F(FilesystemServicePutTest, put) {
+/**
+ * puts received by the callback service (fs-async-server)
+ */
+class FilesystemServiceAsyncPutTest : public FilesystemServicePutTest {
+  protected:
+    void SetUp() override {
+      self = make_unique<MockPeer>("0.0.0.0:50050", make_shared<TmpDir>(), true);
+    }
+};
+
+void FilesystemServicePutTest::put_file() {
   TmpDir source_directory;
 
   const auto root_uri = uri("chord:///");
@@ -108,12 +133,55 @@ TEST_F(FilesystemServicePutTest, put) {
   ASSERT_TRUE(chord::file::files_equal(source_file->path, target_file));
 }
 
-TEST_F(FilesystemServicePutTest, put_replication_2) {
+TEST_F(FilesystemServicePutTest, put) {
+  put_file();
+}
+
+/**
+ * the data of a file whose hash equals the stored one is not sent
+ */
+void FilesystemServicePutTest::put_hash_equal() {
+  TmpDir source_directory;
+  const auto target_uri = uri("chord:///file");
+  const auto source_file = source_directory.add_file("file");
+  const auto target_file = self->data_directory->path / target_uri.path();
+  {
+    std::ofstream target(target_file, std::ios::binary);
+    target << "stored";
+  }
+
+  const Metadata stored{"file", "", "", perms::all, type::regular, file::file_size(source_file->path), crypto::sha256(source_file->path), {}, Replication()};
+  EXPECT_CALL(*self->service, successor(_))
+    .WillRepeatedly(Return(make_entry(self->context.node())));
+  EXPECT_CALL(*self->metadata_mgr, exists(_))
+    .WillRepeatedly(Return(false));
+  EXPECT_CALL(*self->metadata_mgr, exists(target_uri))
+    .WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(target_uri))
+    .WillRepeatedly(Return(std::set<Metadata>{stored}));
+  EXPECT_CALL(*self->metadata_mgr, add(_, _))
+    .WillRepeatedly(Return(true));
+
+  const auto status = self->fs_client->put(target_uri, *source_file, {});
+
+  ASSERT_TRUE(status.ok());
+  // judged by the hash only - the stored file is left untouched
+  std::ifstream target(target_file, std::ios::binary);
+  ASSERT_EQ(std::string(std::istreambuf_iterator<char>{target}, {}), "stored");
+}
+
+TEST_F(FilesystemServicePutTest, put_hash_equal) {
+  put_hash_equal();
+}
+
+void FilesystemServicePutTest::put_replication_2(const bool pipelined) {
   TmpDir source_directory;
 
   const auto data_directory_2 = std::make_shared<TmpDir>();
   const endpoint source_endpoint_2("0.0.0.0:50051");
   MockPeer peer_2(source_endpoint_2, data_directory_2);
+  self->context.pipelined_replication = pipelined;
+  peer_2.context.pipelined_replication = pipelined;
 
   const auto root_uri = uri("chord:///");
   const auto target_uri = uri("chord:///file");
@@ -184,3 +252,256 @@ TEST_F(FilesystemServicePutTest, put_replication_2) {
   ASSERT_TRUE(chord::file::file_size(target_file_2) > 0);
   ASSERT_TRUE(chord::file::files_equal(source_file->path, target_file_2));
 }
+
+TEST_F(FilesystemServicePutTest, put_replication_2) {
+  put_replication_2(false);
+}
+
+/**
+ * the chunks are forwarded to the replica while being received
+ */
+TEST_F(FilesystemServicePutTest, put_replication_2_pipelined) {
+  put_replication_2(true);
+}
+
+/**
+ * put of a file of which the receiver holds the previous version - with
+ * or without a local copy (e.g. shallow copy) to patch
+ */
+void FilesystemServicePutTest::delta_put(const bool local_copy) {
+  TmpDir source_directory;
+  const auto target_uri = uri("chord:///file");
+  const auto source_path = source_directory.path / "file";
+  const auto target_file = self->data_directory->path / target_uri.path();
+
+  // the put changes the second of three chunks
+  std::string base;
+  for(int i = 0; base.size() < 3*ChunkManifest::CHUNK_SIZE; ++i) base += std::to_string(i);
+  auto data = base;
+  data[ChunkManifest::CHUNK_SIZE + 1] = data[ChunkManifest::CHUNK_SIZE + 1] == 'x' ? 'y' : 'x';
+  {
+    std::ofstream source(source_path, std::ios::binary);
+    source << data;
+  }
+  if(local_copy) {
+    std::ofstream target(target_file, std::ios::binary);
+    target << base;
+  }
+
+  ChunkManifest::Builder builder;
+  builder.write(0, base.data(), base.size());
+  const auto manifest = builder.finish(crypto::sha256(base), base.size());
+  ASSERT_TRUE(manifest);
+  const Metadata stored{"file", "", "", perms::all, type::regular, base.size(), crypto::sha256(base), {}, Replication()};
+
+  self->context.fs_delta_uploads = true;
+  EXPECT_CALL(*self->service, successor(_))
+    .WillRepeatedly(Return(make_entry(self->context.node())));
+  EXPECT_CALL(*self->metadata_mgr, exists(_))
+    .WillRepeatedly(Return(false));
+  EXPECT_CALL(*self->metadata_mgr, exists(target_uri))
+    .WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(target_uri))
+    .WillRepeatedly(Return(std::set<Metadata>{stored}));
+  EXPECT_CALL(*self->metadata_mgr, chunks(target_uri))
+    .WillRepeatedly(Return(manifest));
+  EXPECT_CALL(*self->metadata_mgr, chunks(target_uri, _))
+    .Times(::testing::AnyNumber());
+  EXPECT_CALL(*self->metadata_mgr, add(_, _))
+    .WillRepeatedly(Return(true));
+
+  const auto status = self->fs_client->put(target_uri, source_path, {});
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_path, target_file));
+}
+
+TEST_F(FilesystemServicePutTest, delta_put) {
+  delta_put(true);
+}
+
+/**
+ * the manifest is not offered as base without a local copy - the whole
+ * file is put instead
+ */
+TEST_F(FilesystemServicePutTest, delta_put_without_local_copy) {
+  delta_put(false);
+}
+
+/**
+ * the put file is the stored one truncated at a chunk boundary - no
+ * chunk differs, i.e. no data is sent
+ */
+void FilesystemServicePutTest::delta_put_truncated() {
+  TmpDir source_directory;
+  const auto target_uri = uri("chord:///file");
+  const auto source_path = source_directory.path / "file";
+  const auto target_file = self->data_directory->path / target_uri.path();
+
+  std::string base;
+  for(int i = 0; base.size() < 3*ChunkManifest::CHUNK_SIZE; ++i) base += std::to_string(i);
+  const auto data = base.substr(0, 2*ChunkManifest::CHUNK_SIZE);
+  {
+    std::ofstream source(source_path, std::ios::binary);
+    source << data;
+    std::ofstream target(target_file, std::ios::binary);
+    target << base;
+  }
+
+  ChunkManifest::Builder builder;
+  builder.write(0, base.data(), base.size());
+  const auto manifest = builder.finish(crypto::sha256(base), base.size());
+  ASSERT_TRUE(manifest);
+  const Metadata stored{"file", "", "", perms::all, type::regular, base.size(), crypto::sha256(base), {}, Replication()};
+
+  self->context.fs_delta_uploads = true;
+  EXPECT_CALL(*self->service, successor(_))
+    .WillRepeatedly(Return(make_entry(self->context.node())));
+  EXPECT_CALL(*self->metadata_mgr, exists(_))
+    .WillRepeatedly(Return(false));
+  EXPECT_CALL(*self->metadata_mgr, exists(target_uri))
+    .WillRepeatedly(Return(true));
+  EXPECT_CALL(*self->metadata_mgr, get(target_uri))
+    .WillRepeatedly(Return(std::set<Metadata>{stored}));
+  EXPECT_CALL(*self->metadata_mgr, chunks(target_uri))
+    .WillRepeatedly(Return(manifest));
+  EXPECT_CALL(*self->metadata_mgr, chunks(target_uri, _))
+    .Times(::testing::AnyNumber());
+  EXPECT_CALL(*self->metadata_mgr, add(_, _))
+    .WillRepeatedly(Return(true));
+
+  const auto status = self->fs_client->put(target_uri, source_path, {});
+
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_path, target_file));
+}
+
+TEST_F(FilesystemServicePutTest, delta_put_truncated_at_chunk_boundary) {
+  delta_put_truncated();
+}
+
+void FilesystemServicePutTest::put_resumed() {
+  TmpDir source_directory;
+  const auto target_uri = uri("chord:///file");
+  const auto source_path = source_directory.path / "file";
+
+  // larger than a single request
+  std::string data;
+  for(int i = 0; data.size() < 2*ChunkManifest::CHUNK_SIZE; ++i) data += std::to_string(i);
+  {
+    std::ofstream source(source_path, std::ios::binary);
+    source << data;
+  }
+
+  self->context.fs_resumable_puts = true;
+
+  // the first part has been received before the put was interrupted
+  {
+    PartialUpload::Registry registry;
+    auto upload = PartialUpload::open(registry, self->context, target_uri, crypto::sha256(data), data.size());
+    upload->write(0, data.data(), ChunkManifest::CHUNK_SIZE);
+  }
+
+  EXPECT_CALL(*self->service, successor(_))
+    .WillRepeatedly(Return(make_entry(self->context.node())));
+  EXPECT_CALL(*self->metadata_mgr, exists(_))
+    .WillRepeatedly(Return(false));
+  EXPECT_CALL(*self->metadata_mgr, add(_, _))
+    .WillRepeatedly(Return(true));
+
+  const auto status = self->fs_client->put(target_uri, source_path, {});
+
+  const auto target_file = self->data_directory->path / target_uri.path();
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(chord::file::files_equal(source_path, target_file));
+  ASSERT_TRUE(chord::file::is_empty(self->context.partial_directory()));
+}
+
+TEST_F(FilesystemServicePutTest, put_resumes_interrupted_upload) {
+  put_resumed();
+}
+
+/**
+ * the part received of a cancelled put is not committed
+ */
+void FilesystemServicePutTest::put_cancelled() {
+  const auto target_uri = uri("chord:///file");
+  const std::string data{"data"};
+
+  EXPECT_CALL(*self->service, successor(_))
+    .WillRepeatedly(Return(make_entry(self->context.node())));
+  EXPECT_CALL(*self->metadata_mgr, exists(_))
+    .WillRepeatedly(Return(false));
+  EXPECT_CALL(*self->metadata_mgr, add(_, _))
+    .Times(0);
+
+  grpc::ClientContext client_context;
+  ContextMetadata::add(client_context, target_uri);
+  ContextMetadata::add(client_context, std::optional<chord::uuid>{crypto::sha256(data)});
+  PutResponse res;
+  const auto stub = Filesystem::NewStub(grpc::CreateChannel(self->context.advertise_addr, grpc::InsecureChannelCredentials()));
+  const auto writer = stub->put(&client_context, &res);
+  writer->WaitForInitialMetadata();
+
+  PutRequest req;
+  req.set_data(data);
+  req.set_offset(0);
+  req.set_size(data.size());
+  ASSERT_TRUE(writer->Write(req));
+  client_context.TryCancel();
+  ASSERT_EQ(writer->Finish().error_code(), grpc::StatusCode::CANCELLED);
+
+  // waits for the handler of the put to return
+  self.reset();
+}
+
+TEST_F(FilesystemServicePutTest, put_cancelled) {
+  put_cancelled();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, put) {
+  put_file();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, put_hash_equal) {
+  put_hash_equal();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, delta_put) {
+  delta_put(true);
+}
+
+void FilesystemServicePutTest::put_not_responsible() {
+  TmpDir source_directory;
+
+  const auto target_uri = uri("chord:///file");
+  const auto source_file = source_directory.add_file("file");
+
+  // the predecessor of self owns the key
+  self->router->update({crypto::sha256(target_uri), "0.0.0.0:50051"});
+
+  const auto status = self->fs_client->put(self->context.node(), target_uri, source_file->path, {});
+
+  ASSERT_EQ(status.error_code(), grpc::StatusCode::NOT_FOUND);
+  ASSERT_FALSE(file::exists(self->data_directory->path / target_uri.path()));
+}
+
+TEST_F(FilesystemServicePutTest, put_rejected_if_not_responsible) {
+  put_not_responsible();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, put_rejected_if_not_responsible) {
+  put_not_responsible();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, delta_put_truncated_at_chunk_boundary) {
+  delta_put_truncated();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, put_resumes_interrupted_upload) {
+  put_resumed();
+}
+
+TEST_F(FilesystemServiceAsyncPutTest, put_cancelled) {
+  put_cancelled();
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "chord.crypto.h"
+#include "chord.file.h"
+#include "chord.fs.util.h"
+#include "util/chord.test.tmp.file.h"
+
+using namespace std;
+using namespace chord::test;
+
+using chord::path;
+
+namespace {
+constexpr auto file_hash_attr = "user.chord.sha256";
+
+void set_age(const path& p, const std::chrono::seconds age) {
+  const std::filesystem::path file{p.string()};
+  std::filesystem::last_write_time(file, std::filesystem::file_time_type::clock::now() - age);
+}
+}
+
+TEST(chord_fs_util, file_hash) {
+  TmpFile file;
+  set_age(file, 10s);
+
+  const auto hash = chord::crypto::sha256(file.path);
+  ASSERT_EQ(chord::fs::util::file_hash(file), hash);
+  ASSERT_TRUE(chord::file::has_attr(file.path, file_hash_attr));
+
+  //--- cached value is used while size and modification time match
+  const auto cached = *chord::file::attr(file.path, file_hash_attr);
+  const auto other = chord::uuid::random();
+  chord::file::attr(file.path, file_hash_attr, cached.substr(0, cached.rfind(':') + 1) + other.string());
+  ASSERT_EQ(chord::fs::util::file_hash(file), other);
+
+  //--- modified file is hashed again
+  {
+    ofstream out(file.path, std::ofstream::app|std::ofstream::binary);
+    out << "modified";
+  }
+  set_age(file, 10s);
+  ASSERT_EQ(chord::fs::util::file_hash(file), chord::crypto::sha256(file.path));
+}
+
+TEST(chord_fs_util, file_hash_recently_modified) {
+  TmpFile file;
+
+  // might be modified again within the resolution of the modification time
+  ASSERT_EQ(chord::fs::util::file_hash(file), chord::crypto::sha256(file.path));
+  ASSERT_FALSE(chord::file::has_attr(file.path, file_hash_attr));
+}
@@ -66,3 +66,17 @@ TEST(chord_lru_cache, get_touch) {
   } catch(const std::out_of_range& e) { }
 }
 
+TEST(chord_lru_cache, find_touch) {
+
+  LRUCache<int, string> cache(2);
+  cache.put(0, "0");
+  cache.put(1, "1");
+
+  ASSERT_FALSE(cache.find(666));
+  //refresh 0
+  ASSERT_EQ(cache.find(0), "0");
+  //replace 1
+  cache.put(2, "2");
+  ASSERT_TRUE(cache.exists(0));
+  ASSERT_FALSE(cache.exists(1));
+}
@@ -6,6 +6,7 @@
 #include <set>
 #include <string>
 #include "chord.context.h"
+#include "chord.crypto.h"
 #include "chord.exception.h"
 #include "chord.file.h"
 #include "chord.fs.metadata.h"
@@ -15,6 +16,7 @@
 #include "chord.fs.type.h"
 #include "chord.path.h"
 #include "chord.uri.h"
+#include "chord.uuid.h"
 
 using namespace std;
 using namespace chord;
@@ -101,3 +103,409 @@ TEST(chord_metadata_manager, set_delete_get) {
   } catch(const chord::exception &expected) {}
   cleanup(context);
 }
+
+TEST(chord_metadata_manager, get_range) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  std::vector<chord::uri> uris;
+  for(int i=0; i < 32; ++i) {
+    const auto uri = uri::from("chord:/folder" + std::to_string(i));
+    metadata.add(uri, {{"file", "owner", "group", perms::all, type::regular}});
+    uris.push_back(uri);
+  }
+
+  const auto expect_range = [&](const uuid& from, const uuid& to) {
+    std::set<chord::uri> expected;
+    for(const auto& [uri, _] : metadata.get_all()) {
+      if(uuid::between(from, crypto::sha256(uri), to)) expected.insert(uri);
+    }
+    std::set<chord::uri> actual;
+    for(const auto& [uri, _] : metadata.get(from, to)) actual.insert(uri);
+    ASSERT_EQ(expected, actual);
+  };
+
+  for(size_t i=0; i+1 < uris.size(); ++i) {
+    const auto lhs = crypto::sha256(uris[i]);
+    const auto rhs = crypto::sha256(uris[i+1]);
+    // both directions: (lhs, rhs) and the wrap-around (rhs, lhs)
+    expect_range(lhs, rhs);
+    expect_range(rhs, lhs);
+  }
+  // the whole ring but the boundary itself
+  expect_range(crypto::sha256(uris[0]), crypto::sha256(uris[0]));
+
+  // deleted directories are removed from the range
+  const auto hash = crypto::sha256(uris[0]);
+  metadata.del(uris[0]);
+  ASSERT_EQ(metadata.get(hash - 1, hash + 1).count(uris[0]), 0);
+
+  cleanup(context);
+}
+
+/**
+ * root directory record as written by the boost text archive
+ */
+std::string legacy_root() {
+  std::map<std::string, fs::Metadata> root{{".", {".", "", "", perms::all, type::directory}}};
+  std::stringstream ss;
+  boost::archive::text_oarchive oa{ss};
+  oa << root;
+  return ss.str();
+}
+
+TEST(chord_metadata_manager, get_range_migrates_legacy_database) {
+  Context context;
+  cleanup(context);
+
+  const auto uri = uri::from("chord:/legacy");
+  {
+    // database without uri hash index
+    std::map<std::string, fs::Metadata> legacy{{"file", {"file", "owner", "group", perms::all, type::regular}}};
+    std::stringstream ss;
+    boost::archive::text_oarchive oa{ss};
+    oa << legacy;
+
+    rocksdb::DB* db;
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    ASSERT_TRUE(rocksdb::DB::Open(options, context.meta_directory, &db).ok());
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), "/", legacy_root()).ok());
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), uri.path().canonical().string(), ss.str()).ok());
+    db->Close();
+    delete db;
+  }
+
+  fs::MetadataManager metadata{context};
+  const auto hash = crypto::sha256(uri);
+  const auto range = metadata.get(hash - 1, hash + 1);
+  ASSERT_EQ(range.size(), 1);
+  ASSERT_EQ(range.begin()->first, uri);
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, legacy_directories_are_split_into_entries) {
+  Context context;
+  cleanup(context);
+
+  const auto uri = uri::from("chord:/legacy");
+  const auto path = uri.path().canonical().string();
+  {
+    std::map<std::string, fs::Metadata> legacy{{"file", {"file", "owner", "group", perms::all, type::regular, 42}}};
+    std::stringstream ss;
+    boost::archive::text_oarchive oa{ss};
+    oa << legacy;
+
+    rocksdb::DB* db;
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    ASSERT_TRUE(rocksdb::DB::Open(options, context.meta_directory, &db).ok());
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), "/", legacy_root()).ok());
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), path, ss.str()).ok());
+    db->Close();
+    delete db;
+  }
+
+  {
+    fs::MetadataManager metadata{context};
+    const auto dir = metadata.dir(uri);
+    ASSERT_EQ(dir.size(), 1);
+    ASSERT_EQ(dir.begin()->name, "file");
+    ASSERT_EQ(dir.begin()->file_size, 42);
+  }
+
+  {
+    rocksdb::DB* db;
+    rocksdb::Options options;
+    std::vector<rocksdb::ColumnFamilyDescriptor> column_families{
+      {rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions(options)},
+      {"uri.hash", rocksdb::ColumnFamilyOptions(options)}};
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    ASSERT_TRUE(rocksdb::DB::Open(options, context.meta_directory, column_families, &handles, &db).ok());
+    std::string value;
+    ASSERT_TRUE(db->Get(rocksdb::ReadOptions(), path, &value).IsNotFound());
+    ASSERT_TRUE(db->Get(rocksdb::ReadOptions(), path + '\0' + "file", &value).ok());
+    ASSERT_EQ(MetadataCodec::decode_entry(value).file_size, 42);
+    for(auto* handle : handles) db->DestroyColumnFamilyHandle(handle);
+    db->Close();
+    delete db;
+  }
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, entries_do_not_leak_into_sibling_directories) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto folder = uri::from("chord:/folder");
+  const auto folder2 = uri::from("chord:/folder2");
+  const auto sub = uri::from("chord:/folder/sub");
+  const fs::Metadata dot{".", "", "", perms::none, type::directory};
+  const fs::Metadata dotdot{"..", "", "", perms::none, type::directory};
+
+  ASSERT_TRUE(metadata.add(folder, {dot, dotdot, {"file1", "owner", "group", perms::all, type::regular, 1}}));
+  ASSERT_TRUE(metadata.add(folder2, {{"file2", "owner", "group", perms::all, type::regular, 2}}));
+  ASSERT_TRUE(metadata.add(sub, {{"file3", "owner", "group", perms::all, type::regular, 3}}));
+  ASSERT_FALSE(metadata.add(folder2, {{"file2", "owner", "group", perms::all, type::regular, 4}}));
+
+  ASSERT_EQ(metadata.dir(folder).size(), 3);
+  ASSERT_EQ(metadata.dir(folder2).size(), 1);
+  ASSERT_EQ(metadata.dir(folder2).begin()->file_size, 4);
+  ASSERT_EQ(metadata.get_all().size(), 4);
+
+  // removing the last file removes the directory
+  const auto removed = metadata.del(folder, {{"file1", "owner", "group", perms::all, type::regular}}, true);
+  ASSERT_EQ(removed.size(), 1);
+  ASSERT_EQ(removed.begin()->file_size, 1);
+  ASSERT_FALSE(metadata.exists(folder));
+  ASSERT_THROW(metadata.dir(folder), chord::exception);
+
+  ASSERT_TRUE(metadata.exists(folder2));
+  ASSERT_TRUE(metadata.exists(sub));
+
+  metadata.del(folder2);
+  ASSERT_FALSE(metadata.exists(folder2));
+  ASSERT_EQ(metadata.dir(sub).size(), 1);
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, apply_batch) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto folder = uri::from("chord:/folder");
+  const auto other = uri::from("chord:/other");
+  const auto gone = uri::from("chord:/gone");
+  const fs::Metadata dot{".", "", "", perms::none, type::directory, 0, {}, {}, Replication(0,2)};
+  const fs::Metadata file1{"file1", "owner", "group", perms::all, type::regular, 1, {}, {}, Replication(0,2)};
+  const fs::Metadata file2{"file2", "owner", "group", perms::all, type::regular, 2, {}, {}, Replication(0,5)};
+
+  metadata.add(folder, {dot, file1});
+  metadata.add(gone, {file1});
+
+  fs::MetadataBatch batch;
+  batch.add(folder, {file2})
+       .add(other, {file1})
+       .del(folder, {file1})
+       .del(gone);
+  ASSERT_EQ(batch.size(), 4);
+  metadata.apply(batch);
+
+  // "." and ".." are updated without being read
+  const auto folder_dir = metadata.dir(folder);
+  ASSERT_EQ(folder_dir.size(), 3);
+  for(const auto& m : folder_dir) {
+    ASSERT_NE(m.name, "file1");
+    ASSERT_EQ(m.replication, Replication(0,5));
+  }
+
+  // no "." and ".." for directories without "."
+  ASSERT_THAT(metadata.dir(other), ElementsAre(file1));
+  ASSERT_FALSE(metadata.exists(gone));
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, file_entries_stage_no_directory_entries) {
+  Context context;
+  cleanup(context);
+
+  const auto uri = uri::from("chord:/folder/file1");
+  const auto path = uri.path().canonical().string();
+  {
+    fs::MetadataManager metadata{context};
+    metadata.add(uri, {{"file1", "owner", "group", perms::all, type::regular, 33}});
+  }
+
+  {
+    rocksdb::DB* db;
+    rocksdb::Options options;
+    std::vector<std::string> names;
+    ASSERT_TRUE(rocksdb::DB::ListColumnFamilies(options, context.meta_directory, &names).ok());
+    std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
+    for(const auto& name : names) column_families.emplace_back(name, rocksdb::ColumnFamilyOptions(options));
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    ASSERT_TRUE(rocksdb::DB::Open(options, context.meta_directory, column_families, &handles, &db).ok());
+    std::string value;
+    ASSERT_TRUE(db->Get(rocksdb::ReadOptions(), path + '\0' + "file1", &value).ok());
+    // no (empty) "." and ".." placeholders of the file
+    ASSERT_TRUE(db->Get(rocksdb::ReadOptions(), path + '\0' + ".", &value).IsNotFound());
+    ASSERT_TRUE(db->Get(rocksdb::ReadOptions(), path + '\0' + "..", &value).IsNotFound());
+    for(auto* handle : handles) db->DestroyColumnFamilyHandle(handle);
+    db->Close();
+    delete db;
+  }
+
+  cleanup(context);
+}
+
+/**
+ * a file named like its directory (/a/a) - the update of the directory
+ * is not mistaken for the entry of the file
+ */
+TEST(chord_metadata_manager, file_named_like_its_directory) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto directory = uri::from("chord:/a");
+  const auto file = uri::from("chord:/a/a");
+  fs::Metadata meta_file{"a", "owner", "group", perms::all, type::regular, 33, {}, {}, Replication(0,2)};
+  fs::Metadata meta_root{".", "", "", perms::none, type::directory, 0, {}, {}, Replication(0,2)};
+  fs::Metadata meta_parent{"..", "", "", perms::none, type::directory, 0, {}, {}, Replication(0,2)};
+
+  metadata.add(directory, {meta_root, meta_parent, meta_file});
+  metadata.add(file, {meta_file});
+  ASSERT_THAT(metadata.get(file), ElementsAre(meta_file));
+
+  // update replication
+  meta_file.replication = Replication(0,4);
+  metadata.add(directory, {meta_file});
+
+  meta_root.replication = Replication(0,4);
+  meta_parent.replication = Replication(0,4);
+  ASSERT_THAT(metadata.get(directory), ElementsAre(meta_root, meta_parent, meta_file));
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, tuned_options) {
+  Context context;
+  cleanup(context);
+  context.meta_block_cache_mb = 0;
+  context.meta_bloom_bits_per_key = 0;
+  context.meta_disable_wal = true;
+
+  {
+    fs::MetadataManager metadata{context};
+    const auto uri = uri::from("chord:/folder");
+    metadata.add(uri, {{"file1", "owner", "group", perms::all, type::regular, 33}});
+    ASSERT_TRUE(metadata.exists(uri));
+  }
+
+  context.meta_compression = "unknown";
+  ASSERT_THROW(fs::MetadataManager{context}, chord::exception);
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, directory_cache) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto& cache = metadata.directory_cache();
+  const auto uri = uri::from("chord:/folder");
+  const fs::Metadata file1{"file1", "owner", "group", perms::all, type::regular, 1};
+  const fs::Metadata file2{"file2", "owner", "group", perms::all, type::regular, 2};
+
+  // negative lookups are cached as well
+  ASSERT_FALSE(metadata.exists(uri));
+  ASSERT_FALSE(metadata.exists(uri));
+  ASSERT_EQ(cache.misses(), 1);
+  ASSERT_EQ(cache.hits(), 1);
+
+  // add invalidates
+  metadata.add(uri, {file1});
+  ASSERT_TRUE(metadata.exists(uri));
+  ASSERT_THAT(metadata.get(uri), ElementsAre(file1));
+  ASSERT_THAT(metadata.dir(uri), ElementsAre(file1));
+  ASSERT_EQ(cache.misses(), 2);
+  ASSERT_EQ(cache.hits(), 3);
+
+  // batches invalidate
+  metadata.apply(fs::MetadataBatch{}.add(uri, {file2}));
+  ASSERT_THAT(metadata.get(uri), ElementsAre(file1, file2));
+
+  // del invalidates
+  metadata.del(uri, {file1}, false);
+  ASSERT_THAT(metadata.get(uri), ElementsAre(file2));
+  metadata.del(uri);
+  ASSERT_FALSE(metadata.exists(uri));
+  ASSERT_EQ(cache.misses(), 5);
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, directory_cache_disabled) {
+  Context context;
+  cleanup(context);
+  context.meta_cache_size = 0;
+
+  fs::MetadataManager metadata{context};
+  const auto uri = uri::from("chord:/folder");
+  metadata.add(uri, {{"file1", "owner", "group", perms::all, type::regular, 1}});
+  ASSERT_TRUE(metadata.exists(uri));
+  ASSERT_EQ(metadata.get(uri).size(), 1);
+  ASSERT_EQ(metadata.directory_cache().size(), 0);
+  ASSERT_EQ(metadata.directory_cache().hits(), 0);
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, chunks) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto uri = uri::from("chord:/folder/file1");
+  ASSERT_FALSE(metadata.chunks(uri));
+
+  fs::ChunkManifest manifest;
+  manifest.file_hash = uuid_t{4711};
+  manifest.chunk_size = 4;
+  manifest.file_size = 6;
+  manifest.chunks = {uuid_t{1}, uuid_t{2}};
+
+  metadata.add(uri, {{"file1", "owner", "group", perms::all, type::regular, 6, manifest.file_hash}});
+  metadata.chunks(uri, manifest);
+  ASSERT_EQ(metadata.chunks(uri), manifest);
+
+  // removed along with the file
+  metadata.del(uri);
+  ASSERT_FALSE(metadata.chunks(uri));
+
+  cleanup(context);
+}
+
+TEST(chord_metadata_manager, recipe_refs) {
+  Context context;
+  cleanup(context);
+
+  fs::MetadataManager metadata{context};
+  const auto file1 = uri::from("chord:/folder/file1");
+  const auto file2 = uri::from("chord:/folder/file2");
+  ASSERT_FALSE(metadata.recipe(file1));
+
+  fs::ChunkRecipe recipe;
+  recipe.file_hash = uuid_t{4711};
+  recipe.file_size = 6;
+  recipe.chunks = {{uuid_t{1}, 4}, {uuid_t{2}, 2}};
+
+  ASSERT_TRUE(metadata.recipe(file1, recipe).empty());
+  ASSERT_TRUE(metadata.recipe(file2, recipe).empty());
+  ASSERT_EQ(metadata.recipe(file1), recipe);
+  ASSERT_EQ(metadata.refs(uuid_t{1}), 2);
+  ASSERT_EQ(metadata.refs(uuid_t{2}), 2);
+
+  // new version of file1 shares the first chunk
+  fs::ChunkRecipe changed = recipe;
+  changed.file_hash = uuid_t{4712};
+  changed.chunks[1].hash = uuid_t{3};
+  ASSERT_TRUE(metadata.recipe(file1, changed).empty());
+  ASSERT_EQ(metadata.refs(uuid_t{1}), 2);
+  ASSERT_EQ(metadata.refs(uuid_t{2}), 1);
+  ASSERT_EQ(metadata.refs(uuid_t{3}), 1);
+
+  ASSERT_THAT(metadata.recipe(file2, {}), ElementsAre(uuid_t{2}));
+  ASSERT_FALSE(metadata.recipe(file2));
+  ASSERT_THAT(metadata.recipe(file1, {}), ElementsAre(uuid_t{1}, uuid_t{3}));
+  ASSERT_EQ(metadata.refs(uuid_t{1}), 0);
+
+  cleanup(context);
+}
@@ -13,6 +13,7 @@
 #include "chord.service.mock.h"
 #include "chord.facade.h"
 #include "chord.fs.metadata.manager.mock.h"
+#include "chord.fs.callback.service.h"
 #include "chord.fs.service.h"
 #include "chord.fs.client.h"
 #include "chord.fs.facade.h"
@@ -31,11 +32,15 @@ namespace chord {
 
 class MockPeer final {
 public:
-  explicit MockPeer(const endpoint& endpoint, const std::shared_ptr<TmpDir> data_directory)
+  explicit MockPeer(const endpoint& endpoint, const std::shared_ptr<TmpDir> data_directory, const bool fs_async_server = false)
+    : MockPeer(chord::uuid::random(), endpoint, data_directory, fs_async_server) {}
+
+  MockPeer(const chord::uuid& uuid, const endpoint& endpoint, const std::shared_ptr<TmpDir> data_directory, const bool fs_async_server = false)
     : data_directory(data_directory) {
-      context = make_context(chord::uuid::random(), data_directory);
+      context = make_context(uuid, data_directory);
       context.bind_addr = endpoint;
       context.advertise_addr = endpoint;
+      context.fs_async_server = fs_async_server;
       router = new chord::Router(context);
       channel_pool = std::make_unique<chord::ChannelPool>(context);
       client = new MockClient();
@@ -46,10 +51,17 @@ public:
       fs_client = new fs::Client(context, chord_facade.get(), metadata_mgr, channel_pool.get());
       fs_service = new fs::Service(context, chord_facade.get(), metadata_mgr, fs_client);
       fs_facade = std::make_unique<chord::fs::Facade>(context, fs_client, fs_service, metadata_mgr);
+      if(fs_async_server) {
+        fs_callback_service = std::make_unique<chord::fs::CallbackService>(context, fs_service);
+      }
 
       ServerBuilder builder;
       builder.AddListeningPort(endpoint, InsecureServerCredentials());
-      builder.RegisterService(fs_service);
+      if(fs_callback_service) {
+        builder.RegisterService(fs_callback_service.get());
+      } else {
+        builder.RegisterService(fs_service);
+      }
       server = builder.BuildAndStart();
     }
 
@@ -71,6 +83,7 @@ public:
   chord::fs::Service* fs_service;
   chord::fs::Client* fs_client;
   std::unique_ptr<chord::fs::Facade> fs_facade;
+  std::unique_ptr<chord::fs::CallbackService> fs_callback_service;
   std::unique_ptr<Server> server;
 
   // directories
@@ -8,11 +8,7 @@ class RouterSpy : public Router {
 
     virtual ~RouterSpy() = default;
 
-    RouterEntry entry(const size_t idx) const {
-      auto it = successors.begin();
-      std::advance(it, idx);
-      return *it;
-    }
+    using Router::entry;
 
 };
 }  // namespace chord
@@ -22,6 +22,8 @@ using namespace std;
 using namespace chord;
 using namespace chord::test;
 
+using ::testing::ElementsAre;
+
 TEST(RouterTest, initialize) {
   Context context = make_context(0);
   RouterSpy router{context};
@@ -353,3 +355,81 @@ TEST(RouterTest, reset_block_middle) {
   std::cout << "\n\nrouter:\n" << router;
 }
 
+TEST(RouterTest, update_ignores_shadowed_nodes) {
+  Context context = make_context(0);
+  RouterSpy router{context};
+
+  // [0..4] -> 32, [5..5] -> 33, [6..6] -> 128
+  router.update({32, "32"});
+  router.update({33, "33"});
+  router.update({128, "128"});
+  // 40 is not the closest successor of any finger start
+  ASSERT_FALSE(router.update({40, "40"}));
+
+  ASSERT_EQ(router.get().size(), 3);
+  ASSERT_EQ(router.entry(5).node().uuid, 33);
+  ASSERT_EQ(router.closest_preceding_nodes(200).size(), 4);
+
+  router.remove({33, "33"});
+  ASSERT_EQ(router.entry(4).node().uuid, 32);
+  ASSERT_EQ(router.entry(5).node().uuid, 128);
+
+  router.remove({32, "32"});
+  ASSERT_EQ(router.successor()->uuid, 128);
+  for (size_t i = 0; i < 7; i++) {
+    ASSERT_EQ(router.entry(i).node().uuid, 128);
+  }
+  ASSERT_FALSE(router.entry(7).valid());
+}
+
+TEST(RouterTest, intervals) {
+  Context context = make_context(0);
+  RouterSpy router{context};
+
+  // empty router: a single interval covering the full ring
+  ASSERT_THAT(router.intervals(), ElementsAre(0));
+
+  // [0..4] -> 32, [5..5] -> 33, [6..6] -> 128, [7..255] -> <empty>
+  router.update({32, "32"});
+  router.update({33, "33"});
+  router.update({128, "128"});
+  ASSERT_THAT(router.intervals(), ElementsAre(0, 5, 6, 7));
+
+  router.remove({33, "33"});
+  ASSERT_THAT(router.intervals(), ElementsAre(0, 5, 7));
+
+  // the last finger is covered, no trailing interval
+  router.update({uuid::max(), "max"});
+  ASSERT_EQ(router.intervals().back(), 7);
+}
+
+TEST(RouterTest, successors) {
+  Context context = make_context(0);
+  context.successor_list_size = 3;
+  RouterSpy router{context};
+  ASSERT_TRUE(router.successors().empty());
+
+  // 32 and 33 are closer than the next finger (128)
+  router.update({16, "16"});
+  router.update({128, "128"});
+  router.update_successors({16, "16"}, {{32, "32"}, {33, "33"}, {40, "40"}});
+  ASSERT_THAT(router.successors(), ElementsAre(node{16, "16"}, node{32, "32"}, node{33, "33"}));
+
+  // the list of the successor wraps around the ring
+  router.update_successors({16, "16"}, {{0, "0"}, {32, "32"}});
+  ASSERT_THAT(router.successors(), ElementsAre(node{16, "16"}, node{128, "128"}));
+}
+
+TEST(RouterTest, successors_fail_over) {
+  Context context = make_context(0);
+  RouterSpy router{context};
+
+  router.update({16, "16"});
+  router.update({128, "128"});
+  router.update_successors({16, "16"}, {{32, "32"}, {33, "33"}});
+
+  // the next node of the successor list replaces the failed successor
+  router.remove({16, "16"});
+  ASSERT_EQ(router.successor(), (node{32, "32"}));
+  ASSERT_THAT(router.successors(), ElementsAre(node{32, "32"}, node{33, "33"}, node{128, "128"}));
+}
@@ -23,6 +23,7 @@
 #include "chord.uuid.h"
 #include "chord_common.pb.h"
 #include "chord.signal.h"
+#include "chord.stub.mock.h"
 #include "chord.log.h"
 #include "chord.router.spy.h"
 #include "util/chord.test.helper.h"
@@ -115,15 +116,32 @@ TEST(ServiceTest, successor_single_node) {
 	MockClient client;
   Service service(context, &router, &client);
 
-  EXPECT_CALL(client, ping(context.node()))
-    .WillOnce(Return(Status::OK));
-
   const auto router_entry = service.successor({10});
 
   ASSERT_EQ(router_entry.uuid(), "0");
   ASSERT_EQ(router_entry.endpoint(), "0.0.0.0:50050");
 }
 
+TEST(ServiceTest, successor_binary_uuids) {
+  Context context = make_context(0);
+  context.legacy_uuids = false;
+  Router router(context);
+	MockClient client;
+  Service service(context, &router, &client);
+
+  ServerContext serverContext;
+  auto req = make_request<SuccessorRequest>(context);
+  chord::common::set_id(req, uuid_t{10}, context.legacy_uuids);
+  SuccessorResponse res;
+
+  ASSERT_TRUE(req.id().empty());
+  ASSERT_TRUE(service.successor(&serverContext, &req, &res).ok());
+
+  ASSERT_TRUE(res.successor().uuid().empty());
+  ASSERT_EQ(res.successor().uuid_bin(), uuid_t{0}.bytes());
+  ASSERT_EQ(chord::common::uuid_of(res.successor()), uuid_t{0});
+}
+
 /**
  * ring with 2 nodes
  *   - 0 @ 0.0.0.0:50050
@@ -139,9 +157,6 @@ TEST(ServiceTest, successor_two_nodes) {
   const node node = {5, successor};
   router.update(node);
 
-  EXPECT_CALL(client, ping(node))
-    .WillOnce(Return(Status::OK));
-
   Service service(context, &router, &client);
 
   const auto entry = service.successor({2});
@@ -155,7 +170,7 @@ TEST(ServiceTest, successor_two_nodes) {
  *   - 0 @ 0.0.0.0:50050
  *   - 5 @ 0.0.0.0:50055
  *   -10 @ 0.0.0.0:50060
- * node 0 tries to find successor of id 2 -> 5 (down) -> 10
+ * node 0 tries to find successor of id 2 -> 5 (suspected) -> 10
  */
 TEST(ServiceTest, successor_three_nodes_first_successor_down) {
   Context context = make_context(0);
@@ -170,11 +185,12 @@ TEST(ServiceTest, successor_three_nodes_first_successor_down) {
   const node successor_2_node = {10, successor_2};
   router.update(successor_2_node);
 
-  EXPECT_CALL(client, ping(successor_1_node))
-    .WillOnce(Return(Status::CANCELLED));
-  // fallback to next known successor
-  EXPECT_CALL(client, ping(successor_2_node))
-    .WillOnce(Return(Status::OK));
+  // successor 1 failed to answer the previous requests
+  for(auto i = 0u; i < context.failure_max_count; ++i) {
+    router.failure_detector().failure(successor_1_node);
+  }
+  // fallback to next known successor - without pinging it
+  EXPECT_CALL(client, ping(::testing::_)).Times(0);
 
   Service service(context, &router, &client);
 
@@ -182,6 +198,8 @@ TEST(ServiceTest, successor_three_nodes_first_successor_down) {
 
   ASSERT_EQ(entry.uuid(), "10");
   ASSERT_EQ(entry.endpoint(), "0.0.0.0:50060");
+  // eviction is left to the maintenance
+  ASSERT_EQ(router.successor(), successor_1_node);
 }
 
 /**
@@ -201,9 +219,6 @@ TEST(ServiceTest, successor_two_nodes_mod) {
 
   chord::Service service(context, &router, &client);
 
-  EXPECT_CALL(client, ping(successor_node))
-    .WillOnce(Return(Status::OK));
-
   const auto entry = service.successor({10});
 
   ASSERT_EQ(entry.uuid(), "0");
@@ -223,102 +238,6 @@ using ::testing::SaveArgPointee;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
 
-class MockStub : public chord::Chord::StubInterface {
- public:
-  MockStub() = default;
-  MockStub(const MockStub &stub) = default;
-
-  MOCK_METHOD3(successor, grpc::Status(
-      grpc::ClientContext*context,
-      const chord::SuccessorRequest&,
-      chord::SuccessorResponse*));
-
-  MOCK_METHOD3(join, grpc::Status(
-      grpc::ClientContext*,
-      const chord::JoinRequest&,
-      chord::JoinResponse*));
-
-  MOCK_METHOD3(leave, grpc::Status(
-      grpc::ClientContext*, 
-      const ::chord::LeaveRequest&,
-      chord::LeaveResponse*));
-
-  MOCK_METHOD3(stabilize, grpc::Status(
-      grpc::ClientContext*,
-      const chord::StabilizeRequest&,
-      chord::StabilizeResponse*));
-
-  MOCK_METHOD3(notify, grpc::Status(
-      grpc::ClientContext*,
-      const chord::NotifyRequest&,
-      chord::NotifyResponse*));
-
-  MOCK_METHOD3(ping, grpc::Status(
-      grpc::ClientContext*,
-      const chord::PingRequest&,
-      chord::PingResponse*));
-
-  MOCK_METHOD3(PrepareAsyncsuccessorRaw, grpc::ClientAsyncResponseReaderInterface<chord::SuccessorResponse>*(
-      grpc::ClientContext*,
-      const chord::SuccessorRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncsuccessorRaw, grpc::ClientAsyncResponseReaderInterface<chord::SuccessorResponse>*(
-      grpc::ClientContext*,
-      const chord::SuccessorRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(PrepareAsyncjoinRaw, grpc::ClientAsyncResponseReaderInterface<chord::JoinResponse>*(
-      grpc::ClientContext*,
-      const chord::JoinRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncleaveRaw, grpc::ClientAsyncResponseReaderInterface<chord::LeaveResponse>*(
-      grpc::ClientContext*,
-      const chord::LeaveRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(PrepareAsyncleaveRaw, grpc::ClientAsyncResponseReaderInterface<chord::LeaveResponse>*(
-      grpc::ClientContext*,
-      const chord::LeaveRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncjoinRaw, grpc::ClientAsyncResponseReaderInterface<chord::JoinResponse>*(
-      grpc::ClientContext*,
-      const chord::JoinRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(PrepareAsyncstabilizeRaw, grpc::ClientAsyncResponseReaderInterface<chord::StabilizeResponse>*(
-      grpc::ClientContext*,
-      const chord::StabilizeRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncstabilizeRaw, grpc::ClientAsyncResponseReaderInterface<chord::StabilizeResponse>*(
-      grpc::ClientContext*,
-      const chord::StabilizeRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(PrepareAsyncnotifyRaw, grpc::ClientAsyncResponseReaderInterface<chord::NotifyResponse>*(
-      grpc::ClientContext*,
-      const chord::NotifyRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncnotifyRaw, grpc::ClientAsyncResponseReaderInterface<chord::NotifyResponse>*(
-      grpc::ClientContext*,
-      const chord::NotifyRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(PrepareAsyncpingRaw, grpc::ClientAsyncResponseReaderInterface<chord::PingResponse>*(
-      grpc::ClientContext*,
-      const chord::PingRequest&,
-      grpc::CompletionQueue*));
-
-  MOCK_METHOD3(AsyncpingRaw, grpc::ClientAsyncResponseReaderInterface<chord::PingResponse>*(
-      grpc::ClientContext*,
-      const chord::PingRequest&,
-      grpc::CompletionQueue*));
-};
-
 /**
  * ring with 2 nodes
  *   - 0 @ 0.0.0.0:50050
@@ -376,7 +295,43 @@ TEST(ServiceTest, successor_two_nodes_modulo) {
   ASSERT_EQ(res.has_successor(), true);
   ASSERT_EQ(res.successor().uuid(), "5");
   ASSERT_EQ(res.successor().endpoint(), "0.0.0.0:50055");
+  //--- the request has been forwarded once
+  ASSERT_EQ(res.hops(), 1);
+}
+
+TEST(ServiceTest, successor_forwards_with_deadline) {
+  Context context = make_context(5);
+  context.rpc_timeouts_ms["successor"] = 500;
+  Router router(context);
+  ChannelPool channel_pool(context);
 
+  router.update({0, "0.0.0.0:50050"});
+
+  std::chrono::system_clock::time_point deadline;
+  auto stub_factory = [&]([[maybe_unused]] const node& node) {
+    auto stub = std::make_unique<NiceMock<MockStub>>();
+    ON_CALL(*stub, successor(_, _, _))
+        .WillByDefault(Invoke([&](grpc::ClientContext* clientContext, const SuccessorRequest&, SuccessorResponse*) {
+          deadline = clientContext->deadline();
+          return Status::OK;
+        }));
+    return stub;
+  };
+
+  Client client(context, &router, &channel_pool, stub_factory);
+  Service service(context, &router, &client);
+
+  ServerContext serverContext;
+  SuccessorRequest req = make_request<SuccessorRequest>(context);
+  SuccessorResponse res;
+  req.set_id("2");
+
+  const auto now = std::chrono::system_clock::now();
+  ASSERT_TRUE(service.successor(&serverContext, &req, &res).ok());
+
+  //--- forwarded request is bounded by the successor timeout
+  ASSERT_GT(deadline, now);
+  ASSERT_LE(deadline, now + std::chrono::milliseconds(500) + std::chrono::seconds(1));
 }
 
 
@@ -424,6 +379,10 @@ TEST(ServiceTest, stabilize) {
   ASSERT_TRUE(res.has_predecessor());
   ASSERT_EQ(res.predecessor().uuid(), "1");
   ASSERT_EQ(res.predecessor().endpoint(), "1.1.1.1:8888");
+
+  //--- successor list piggybacked
+  ASSERT_EQ(res.successors_size(), 1);
+  ASSERT_EQ(res.successors(0).uuid(), "1");
 }
 
 TEST(ServiceTest, leave__without_header) {
@@ -625,9 +584,6 @@ TEST(ServiceTest, fix_fingers) {
 
   Service service{context, &router, &client};
 
-  EXPECT_CALL(client, ping(_))
-    .WillOnce(Return(Status::OK));
-
   service.fix_fingers(2);
   ASSERT_EQ(router.entry(1).node(), succ); // no holes in successors
   ASSERT_EQ(router.entry(2).node(), succ);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <functional>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/impl/codegen/status.h>
+
+#include "chord.grpc.pb.h"
+
+namespace chord {
+
+class MockAsyncStub : public chord::Chord::StubInterface::async_interface {
+ public:
+  MOCK_METHOD4(successor, void(grpc::ClientContext*, const chord::SuccessorRequest*, chord::SuccessorResponse*, std::function<void(grpc::Status)>));
+  MOCK_METHOD4(join, void(grpc::ClientContext*, const chord::JoinRequest*, chord::JoinResponse*, std::function<void(grpc::Status)>));
+  MOCK_METHOD4(stabilize, void(grpc::ClientContext*, const chord::StabilizeRequest*, chord::StabilizeResponse*, std::function<void(grpc::Status)>));
+  MOCK_METHOD4(notify, void(grpc::ClientContext*, const chord::NotifyRequest*, chord::NotifyResponse*, std::function<void(grpc::Status)>));
+  MOCK_METHOD4(leave, void(grpc::ClientContext*, const chord::LeaveRequest*, chord::LeaveResponse*, std::function<void(grpc::Status)>));
+  MOCK_METHOD4(ping, void(grpc::ClientContext*, const chord::PingRequest*, chord::PingResponse*, std::function<void(grpc::Status)>));
+};
+
+class MockStub : public chord::Chord::StubInterface {
+ public:
+  MockStub() = default;
+  MockStub(const MockStub &stub) = default;
+
+  MOCK_METHOD0(async, async_interface*());
+
+  MOCK_METHOD3(successor, grpc::Status(
+      grpc::ClientContext*context,
+      const chord::SuccessorRequest&,
+      chord::SuccessorResponse*));
+
+  MOCK_METHOD3(join, grpc::Status(
+      grpc::ClientContext*,
+      const chord::JoinRequest&,
+      chord::JoinResponse*));
+
+  MOCK_METHOD3(leave, grpc::Status(
+      grpc::ClientContext*, 
+      const ::chord::LeaveRequest&,
+      chord::LeaveResponse*));
+
+  MOCK_METHOD3(stabilize, grpc::Status(
+      grpc::ClientContext*,
+      const chord::StabilizeRequest&,
+      chord::StabilizeResponse*));
+
+  MOCK_METHOD3(notify, grpc::Status(
+      grpc::ClientContext*,
+      const chord::NotifyRequest&,
+      chord::NotifyResponse*));
+
+  MOCK_METHOD3(ping, grpc::Status(
+      grpc::ClientContext*,
+      const chord::PingRequest&,
+      chord::PingResponse*));
+
+  MOCK_METHOD3(PrepareAsyncsuccessorRaw, grpc::ClientAsyncResponseReaderInterface<chord::SuccessorResponse>*(
+      grpc::ClientContext*,
+      const chord::SuccessorRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncsuccessorRaw, grpc::ClientAsyncResponseReaderInterface<chord::SuccessorResponse>*(
+      grpc::ClientContext*,
+      const chord::SuccessorRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(PrepareAsyncjoinRaw, grpc::ClientAsyncResponseReaderInterface<chord::JoinResponse>*(
+      grpc::ClientContext*,
+      const chord::JoinRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncleaveRaw, grpc::ClientAsyncResponseReaderInterface<chord::LeaveResponse>*(
+      grpc::ClientContext*,
+      const chord::LeaveRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(PrepareAsyncleaveRaw, grpc::ClientAsyncResponseReaderInterface<chord::LeaveResponse>*(
+      grpc::ClientContext*,
+      const chord::LeaveRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncjoinRaw, grpc::ClientAsyncResponseReaderInterface<chord::JoinResponse>*(
+      grpc::ClientContext*,
+      const chord::JoinRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(PrepareAsyncstabilizeRaw, grpc::ClientAsyncResponseReaderInterface<chord::StabilizeResponse>*(
+      grpc::ClientContext*,
+      const chord::StabilizeRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncstabilizeRaw, grpc::ClientAsyncResponseReaderInterface<chord::StabilizeResponse>*(
+      grpc::ClientContext*,
+      const chord::StabilizeRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(PrepareAsyncnotifyRaw, grpc::ClientAsyncResponseReaderInterface<chord::NotifyResponse>*(
+      grpc::ClientContext*,
+      const chord::NotifyRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncnotifyRaw, grpc::ClientAsyncResponseReaderInterface<chord::NotifyResponse>*(
+      grpc::ClientContext*,
+      const chord::NotifyRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(PrepareAsyncpingRaw, grpc::ClientAsyncResponseReaderInterface<chord::PingResponse>*(
+      grpc::ClientContext*,
+      const chord::PingRequest&,
+      grpc::CompletionQueue*));
+
+  MOCK_METHOD3(AsyncpingRaw, grpc::ClientAsyncResponseReaderInterface<chord::PingResponse>*(
+      grpc::ClientContext*,
+      const chord::PingRequest&,
+      grpc::CompletionQueue*));
+};
+} // namespace chord
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <thread>
+
+#include "chord.node.h"
+#include "chord.successor.cache.h"
+#include "chord.uuid.h"
+
+using namespace std;
+using namespace chord;
+
+TEST(chord_successor_cache, disabled) {
+  SuccessorCache cache(0);
+  ASSERT_FALSE(cache.enabled());
+  ASSERT_FALSE(cache.put(5, {10, "10"}, 1, cache.generation()));
+  ASSERT_FALSE(cache.get(5));
+}
+
+TEST(chord_successor_cache, interval) {
+  SuccessorCache cache(16);
+  ASSERT_TRUE(cache.put(5, {10, "10"}, 2, cache.generation()));
+
+  // [5, 10] -> 10
+  ASSERT_FALSE(cache.get(4));
+  ASSERT_EQ(cache.get(5)->uuid, 10);
+  ASSERT_EQ(cache.get(10)->uuid, 10);
+  ASSERT_FALSE(cache.get(11));
+
+  // widen to [2, 10]
+  cache.put(2, {10, "10"}, 2, cache.generation());
+  ASSERT_EQ(cache.get(3)->uuid, 10);
+  ASSERT_EQ(cache.size(), 1);
+
+  ASSERT_EQ(cache.hits(), 3);
+  ASSERT_EQ(cache.misses(), 2);
+  ASSERT_EQ(cache.hops_saved(), 3 * 3);
+  ASSERT_DOUBLE_EQ(cache.hit_ratio(), 3.0 / 5.0);
+}
+
+TEST(chord_successor_cache, interval_wraps_around) {
+  SuccessorCache cache(16);
+  // [max-5, 10] -> 10
+  cache.put(uuid::max() - 5, {10, "10"}, 0, cache.generation());
+  ASSERT_EQ(cache.get(uuid::max())->uuid, 10);
+  ASSERT_EQ(cache.get(0)->uuid, 10);
+  ASSERT_EQ(cache.get(7)->uuid, 10);
+  ASSERT_FALSE(cache.get(uuid::max() - 6));
+  ASSERT_FALSE(cache.get(11));
+}
+
+TEST(chord_successor_cache, lookup_drops_shadowed_owners) {
+  SuccessorCache cache(16);
+  cache.put(5, {10, "10"}, 0, cache.generation());
+  cache.put(15, {20, "20"}, 0, cache.generation());
+
+  // 10 left the ring: there is no node in [5, 20)
+  cache.put(5, {20, "20"}, 0, cache.generation());
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(cache.get(8)->uuid, 20);
+}
+
+TEST(chord_successor_cache, invalidate) {
+  SuccessorCache cache(16);
+  cache.put(5, {10, "10"}, 0, cache.generation());
+  cache.put(15, {20, "20"}, 0, cache.generation());
+
+  ASSERT_FALSE(cache.invalidate(12));
+  ASSERT_TRUE(cache.invalidate(7));
+  ASSERT_FALSE(cache.get(7));
+  ASSERT_EQ(cache.get(17)->uuid, 20);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(chord_successor_cache, put_ignores_invalidated_lookups) {
+  SuccessorCache cache(16);
+  // lookup in flight while the ring changes
+  const auto generation = cache.generation();
+  cache.clear();
+  ASSERT_FALSE(cache.put(5, {10, "10"}, 0, generation));
+  ASSERT_FALSE(cache.get(5));
+}
+
+TEST(chord_successor_cache, capacity) {
+  SuccessorCache cache(2);
+  cache.put(5, {10, "10"}, 0, cache.generation());
+  cache.put(15, {20, "20"}, 0, cache.generation());
+  cache.put(25, {30, "30"}, 0, cache.generation());
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.get(27)->uuid, 30);
+}
+
+TEST(chord_successor_cache, intervals_expire) {
+  SuccessorCache cache(16, std::chrono::milliseconds(20));
+  cache.put(5, {10, "10"}, 0, cache.generation());
+  ASSERT_EQ(cache.get(7)->uuid, 10);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  ASSERT_FALSE(cache.get(7));
+  ASSERT_EQ(cache.size(), 0);
+}
@@ -2,6 +2,8 @@
 #include <gmock/gmock.h>
 
 #include <bitset>
+#include <sstream>
+#include <stdexcept>
 
 #include "chord.crypto.h"
 
@@ -152,3 +154,73 @@ TEST(chord_uuid, operator_input_stream) {
   input_stream >> id;
   ASSERT_EQ(id, 12345);
 }
+
+TEST(chord_uuid, bytes) {
+  const auto zero = uuid_t{0}.bytes();
+  ASSERT_EQ(zero.size(), uuid::UUID_BYTES);
+  ASSERT_EQ(zero, string(uuid::UUID_BYTES, '\0'));
+
+  const auto id = uuid_t{"113427455640312821154458202477256070485"};
+  ASSERT_EQ(id.bytes().size(), uuid::UUID_BYTES);
+  ASSERT_EQ(uuid::from_bytes(id.bytes()), id);
+
+  // lexicographical order equals numerical order
+  ASSERT_LT(uuid_t{255}.bytes(), uuid_t{256}.bytes());
+  ASSERT_LT(uuid_t{256}.bytes(), id.bytes());
+}
+
+TEST(chord_uuid, codec_matches_boost) {
+  for (int i = 0; i < 100; i++) {
+    const auto id = uuid::random();
+    const auto value = id.value();
+    ASSERT_EQ(id.string(), value.str());
+
+    std::stringstream ss;
+    ss << std::hex << value;
+    ASSERT_EQ(id.hex(), ss.str());
+
+    ASSERT_EQ(uuid_t{id.string()}, id);
+    ASSERT_EQ(uuid_t{"0x" + id.hex()}, id);
+    ASSERT_EQ(uuid_t{value}, id);
+  }
+  ASSERT_EQ(uuid_t{0}.string(), "0");
+  ASSERT_EQ(uuid_t{0}.hex(), "0");
+  ASSERT_EQ(uuid::max().string(), "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+  ASSERT_THROW(uuid_t{"12a"}, std::runtime_error);
+}
+
+TEST(chord_uuid, ring_arithmetic_wraps) {
+  ASSERT_EQ(uuid::max() + 1, 0);
+  ASSERT_EQ(uuid_t{0} - 1, uuid::max());
+  ASSERT_EQ(uuid_t{-1}, uuid::max());
+
+  for (int i = 0; i < 100; i++) {
+    const auto a = uuid::random();
+    const auto b = uuid::random();
+    ASSERT_EQ((a + b).value(), a.value() + b.value());
+    ASSERT_EQ((a - b).value(), a.value() - b.value());
+    ASSERT_EQ((a * b).value(), a.value() * b.value());
+    ASSERT_EQ(a < b, a.value() < b.value());
+  }
+}
+
+TEST(chord_uuid, pow2) {
+  static_assert(uuid::pow2(0) == 1);
+  static_assert(uuid::pow2(64) == uuid::pow2(63) * 2);
+  for (unsigned i = 0; i < uuid::UUID_BITS_MAX; i++) {
+    ASSERT_EQ(uuid::pow2(i).value(), boost::multiprecision::pow(uuid::value_t{2}, i));
+  }
+}
+
+TEST(chord_uuid, between) {
+  static_assert(uuid::between(1, 5, 10));
+  static_assert(!uuid::between(1, 1, 10));
+  static_assert(!uuid::between(1, 10, 10));
+  // wrap around
+  static_assert(uuid::between(10, 0, 1));
+  static_assert(uuid::between(10, uuid::max(), 1));
+  static_assert(!uuid::between(10, 5, 1));
+  // full ring except the boundary
+  static_assert(uuid::between(5, 6, 5));
+  static_assert(!uuid::between(5, 5, 5));
+}